@@ -55,6 +55,19 @@
 #endif
 
 
+/**
+ * Merge the contours of \a aPolys, which holds one shape per hole or pad of the board.
+ * Large sets are merged by several threads.
+ */
+static void mergeContours( SHAPE_POLY_SET& aPolys )
+{
+    SHAPE_POLY_SET::UNION_BATCH batch;
+
+    batch.Add( aPolys );
+    batch.Execute( aPolys, SHAPE_POLY_SET::PM_FAST );
+}
+
+
 void BOARD_ADAPTER::destroyLayers()
 {
     if( !m_layers_poly.empty() )
@@ -834,22 +847,22 @@ void BOARD_ADAPTER::createLayers( REPORTER* aStatusReporter )
         {
             // found
             SHAPE_POLY_SET *polyLayer = m_layerHoleOdPolys[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            mergeContours( *polyLayer );
 
             wxASSERT( m_layerHoleIdPolys.find( layer ) != m_layerHoleIdPolys.end() );
 
             polyLayer = m_layerHoleIdPolys[layer];
-            polyLayer->Simplify( SHAPE_POLY_SET::PM_FAST );
+            mergeContours( *polyLayer );
         }
     }
 
     // End Build Copper layers
 
     // This will make a union of all added contours
-    m_throughHoleOdPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_nonPlatedThroughHoleOdPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_throughHoleViaOdPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
-    m_throughHoleAnnularRingPolys.Simplify( SHAPE_POLY_SET::PM_FAST );
+    mergeContours( m_throughHoleOdPolys );
+    mergeContours( m_nonPlatedThroughHoleOdPolys );
+    mergeContours( m_throughHoleViaOdPolys );
+    mergeContours( m_throughHoleAnnularRingPolys );
 
     // Build Tech layers
     // Based on:
@@ -149,6 +149,16 @@ static const wxChar SkipBoundingBoxFpLoad[] = wxT( "SkipBoundingBoxFpLoad" );
  */
 static const wxChar SmallDrillMarkSize[] = wxT( "SmallDrillMarkSize" );
 
+/**
+ * Draw the non-cached layers of software rendered canvases in tiles on several threads.
+ */
+static const wxChar TiledRendering[] = wxT( "TiledRendering" );
+
+/**
+ * Collect per layer and per item type draw statistics and show them over the board canvas.
+ */
+static const wxChar ShowDrawProfile[] = wxT( "ShowDrawProfile" );
+
 
 } // namespace KEYS
 
@@ -251,6 +261,8 @@ ADVANCED_CFG::ADVANCED_CFG()
     m_SkipBoundingBoxOnFpLoad   = false;
 
     m_SmallDrillMarkSize	= 0.35;
+    m_TiledRendering = false;
+    m_ShowDrawProfile = false;
 
     loadFromConfigFile();
 }
@@ -338,6 +350,12 @@ void ADVANCED_CFG::loadSettings( wxConfigBase& aCfg )
     configParams.push_back( new PARAM_CFG_DOUBLE( true, AC_KEYS::SmallDrillMarkSize,
                                                   &m_SmallDrillMarkSize, 0.35, 0.0, 3.0 ) );
 
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::TiledRendering,
+                                                &m_TiledRendering, false ) );
+
+    configParams.push_back( new PARAM_CFG_BOOL( true, AC_KEYS::ShowDrawProfile,
+                                                &m_ShowDrawProfile, false ) );
+
     wxConfigLoadSetups( &aCfg, configParams );
 
     for( PARAM_CFG* param : configParams )
@@ -213,17 +213,24 @@ void EDA_DRAW_PANEL_GAL::DoRePaint()
 
         if( m_view->IsDirty() )
         {
+            // A partial redraw clears and draws the grid in the damaged regions only
+            bool partialRedraw = m_view->HasPartialDamage();
+
             if( m_backend != GAL_TYPE_OPENGL &&     // Already called in opengl
-                m_view->IsTargetDirty( KIGFX::TARGET_NONCACHED ) )
+                m_view->IsTargetDirty( KIGFX::TARGET_NONCACHED ) && !partialRedraw )
                 m_gal->ClearScreen();
 
             m_view->ClearTargets();
 
             // Grid has to be redrawn only when the NONCACHED target is redrawn
-            if( m_view->IsTargetDirty( KIGFX::TARGET_NONCACHED ) )
+            if( m_view->IsTargetDirty( KIGFX::TARGET_NONCACHED ) && !partialRedraw )
                 m_gal->DrawGrid();
 
             m_view->Redraw();
+
+            // Redraw() leaves the overlay dirty when it has new draw statistics to show
+            if( m_view->IsDirty() )
+                Refresh();
         }
 
         m_gal->DrawCursor( m_viewControls->GetCursorPosition() );
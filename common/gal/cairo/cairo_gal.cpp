@@ -1206,6 +1206,121 @@ unsigned int CAIRO_GAL_BASE::getNewGroupNumber()
 }
 
 
+GAL* CAIRO_GAL_BASE::BeginTile( const BOX2I& aScreenRect )
+{
+    if( !currentContext )
+        return nullptr;
+
+    cairo_surface_t* target = cairo_get_target( currentContext );
+
+    // Tiles alias the pixels of the target, so it has to be a plain image
+    if( cairo_surface_get_type( target ) != CAIRO_SURFACE_TYPE_IMAGE
+            || cairo_image_surface_get_format( target ) != GAL_FORMAT )
+    {
+        return nullptr;
+    }
+
+    BOX2I bounds( VECTOR2I( 0, 0 ), VECTOR2I( cairo_image_surface_get_width( target ),
+                                              cairo_image_surface_get_height( target ) ) );
+    BOX2I rect = bounds.Intersect( aScreenRect );
+
+    if( rect.GetWidth() <= 0 || rect.GetHeight() <= 0 )
+        return nullptr;
+
+    // Anything drawn so far has to reach the pixels before the tiles draw over them
+    storePath();
+    cairo_surface_flush( target );
+
+    int              stride = cairo_image_surface_get_stride( target );
+    unsigned char*   data = cairo_image_surface_get_data( target ) + rect.GetY() * stride
+                            + rect.GetX() * 4;
+    cairo_surface_t* tileSurface = cairo_image_surface_create_for_data( data, GAL_FORMAT,
+                                                                        rect.GetWidth(),
+                                                                        rect.GetHeight(),
+                                                                        stride );
+
+    // The tile draws in the coordinates of the whole target
+    cairo_surface_set_device_offset( tileSurface, -rect.GetX(), -rect.GetY() );
+
+    CAIRO_IMAGE_GAL* tile = new CAIRO_IMAGE_GAL( options, tileSurface );
+    cairo_surface_destroy( tileSurface );
+
+    // Same view as this GAL.  Unlike beginDrawing(), this leaves the region contents alone.
+    tile->screenSize = screenSize;
+    tile->zoomFactor = zoomFactor;
+    tile->lookAtPoint = lookAtPoint;
+    tile->rotation = rotation;
+    tile->worldUnitLength = worldUnitLength;
+    tile->screenDPI = screenDPI;
+    tile->globalFlipX = globalFlipX;
+    tile->globalFlipY = globalFlipY;
+    tile->depthRange = depthRange;
+    tile->ComputeWorldScreenMatrix();
+
+    tile->cairoWorldScreenMatrix = cairoWorldScreenMatrix;
+    tile->updateWorldScreenMatrix();
+
+    cairo_set_antialias( tile->context, cairo_get_antialias( currentContext ) );
+    cairo_set_operator( tile->context, cairo_get_operator( currentContext ) );
+
+    return tile;
+}
+
+
+void CAIRO_GAL_BASE::EndTile( GAL* aTile )
+{
+    CAIRO_IMAGE_GAL* tile = static_cast<CAIRO_IMAGE_GAL*>( aTile );
+    cairo_surface_t* tileSurface = tile->surface;
+    double           offsetX, offsetY;
+
+    cairo_surface_flush( tileSurface );
+    cairo_surface_get_device_offset( tileSurface, &offsetX, &offsetY );
+
+    int width = cairo_image_surface_get_width( tileSurface );
+    int height = cairo_image_surface_get_height( tileSurface );
+
+    delete tile;
+
+    // The tile drew straight into our pixels
+    cairo_surface_mark_dirty_rectangle( cairo_get_target( currentContext ), -offsetX, -offsetY,
+                                        width, height );
+}
+
+
+void CAIRO_GAL_BASE::SetClipRect( const BOX2I& aScreenRect )
+{
+    // Whatever is pending was meant to be drawn with the previous clip
+    storePath();
+
+    // Paths are built in screen coordinates (the context matrix is the identity)
+    cairo_reset_clip( currentContext );
+    cairo_new_path( currentContext );
+    cairo_rectangle( currentContext, aScreenRect.GetX(), aScreenRect.GetY(),
+                     aScreenRect.GetWidth(), aScreenRect.GetHeight() );
+    cairo_clip( currentContext );
+}
+
+
+void CAIRO_GAL_BASE::ResetClipRect()
+{
+    storePath();
+    cairo_reset_clip( currentContext );
+}
+
+
+CAIRO_IMAGE_GAL::CAIRO_IMAGE_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions,
+                                  cairo_surface_t* aSurface ) :
+    CAIRO_GAL_BASE( aDisplayOptions )
+{
+    surface = cairo_surface_reference( aSurface );
+    context = cairo_create( surface );
+    currentContext = context;
+
+    screenSize = VECTOR2I( cairo_image_surface_get_width( surface ),
+                           cairo_image_surface_get_height( surface ) );
+}
+
+
 CAIRO_GAL::CAIRO_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions,
         wxWindow* aParent, wxEvtHandler* aMouseListener,
         wxEvtHandler* aPaintListener, const wxString& aName ) :
@@ -1424,6 +1539,13 @@ void CAIRO_GAL::ClearTarget( RENDER_TARGET aTarget )
 }
 
 
+bool CAIRO_GAL::IsTargetBufferShared( RENDER_TARGET aTarget, RENDER_TARGET aOther ) const
+{
+    // Only the overlay has a buffer of its own, see SetTarget()
+    return aTarget == aOther || ( aTarget != TARGET_OVERLAY && aOther != TARGET_OVERLAY );
+}
+
+
 void CAIRO_GAL::initSurface()
 {
     if( isInitialized )
@@ -1632,6 +1632,16 @@ void OPENGL_GAL::ClearCache()
 }
 
 
+size_t OPENGL_GAL::GetVertexCount() const
+{
+    if( !isInitialized )
+        return 0;
+
+    return cachedManager->GetVertexCount() + nonCachedManager->GetVertexCount()
+           + overlayManager->GetVertexCount();
+}
+
+
 void OPENGL_GAL::SetTarget( RENDER_TARGET aTarget )
 {
     switch( aTarget )
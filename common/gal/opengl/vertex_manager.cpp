@@ -38,7 +38,8 @@
 using namespace KIGFX;
 
 VERTEX_MANAGER::VERTEX_MANAGER( bool aCached ) :
-    m_noTransform( true ), m_transform( 1.0f ), m_reserved( NULL ), m_reservedSpace( 0 )
+    m_noTransform( true ), m_transform( 1.0f ), m_reserved( NULL ), m_reservedSpace( 0 ),
+    m_vertexCount( 0 )
 {
     m_container.reset( VERTEX_CONTAINER::MakeContainer( aCached ) );
     m_gpu.reset( GPU_MANAGER::MakeManager( m_container.get() ) );
@@ -242,6 +243,7 @@ void VERTEX_MANAGER::DrawItem( const VERTEX_ITEM& aItem ) const
     int offset = aItem.GetOffset();
 
     m_gpu->DrawIndices( offset, size );
+    m_vertexCount += size;
 }
 
 
@@ -253,6 +255,8 @@ void VERTEX_MANAGER::EndDrawing() const
 
 void VERTEX_MANAGER::putVertex( VERTEX& aTarget, GLfloat aX, GLfloat aY, GLfloat aZ ) const
 {
+    m_vertexCount++;
+
     // Modify the vertex according to the currently used transformations
     if( m_noTransform )
     {
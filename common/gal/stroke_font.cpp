@@ -32,6 +32,11 @@
 #include <wx/string.h>
 #include <gr_text.h>
 
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 
 using namespace KIGFX;
 
@@ -266,18 +271,135 @@ void STROKE_FONT::Draw( const UTF8& aText, const VECTOR2D& aPosition, double aRo
 }
 
 
+struct STROKE_FONT::LINE_LAYOUT
+{
+    VECTOR2D                                   m_size;    ///< see computeTextLineSize()
+    std::vector<std::pair<VECTOR2D, VECTOR2D>> m_bars;    ///< overbars and underlines
+    std::vector<std::vector<VECTOR2D>>         m_strokes; ///< glyph polylines
+};
+
+
+/**
+ * Text is redrawn with the same strings and attributes over and over (reference designators,
+ * values, pin names...) so laying out each line of text once and replaying its strokes saves
+ * most of the per-glyph work.  Lines may be drawn from several threads at the same time.
+ */
+class STROKE_FONT::LAYOUT_CACHE
+{
+public:
+    ///< Number of laid out lines kept
+    static constexpr size_t MAX_ENTRIES = 4096;
+
+    struct KEY
+    {
+        std::string m_text;
+        VECTOR2D    m_glyphSize;
+        double      m_lineWidth;
+        bool        m_italic;
+        bool        m_mirrored;
+        bool        m_underlined;
+
+        bool operator==( const KEY& aOther ) const
+        {
+            return m_glyphSize == aOther.m_glyphSize && m_lineWidth == aOther.m_lineWidth
+                   && m_italic == aOther.m_italic && m_mirrored == aOther.m_mirrored
+                   && m_underlined == aOther.m_underlined && m_text == aOther.m_text;
+        }
+    };
+
+    struct KEY_HASH
+    {
+        size_t operator()( const KEY& aKey ) const
+        {
+            size_t seed = std::hash<std::string>()( aKey.m_text );
+
+            auto combine =
+                    [&seed]( size_t aHash )
+                    {
+                        seed ^= aHash + 0x9e3779b9 + ( seed << 6 ) + ( seed >> 2 );
+                    };
+
+            combine( std::hash<double>()( aKey.m_glyphSize.x ) );
+            combine( std::hash<double>()( aKey.m_glyphSize.y ) );
+            combine( std::hash<double>()( aKey.m_lineWidth ) );
+            combine( aKey.m_italic | aKey.m_mirrored << 1 | aKey.m_underlined << 2 );
+
+            return seed;
+        }
+    };
+
+    /**
+     * @return the cached layout, or nullptr if there is none.
+     */
+    std::shared_ptr<const LINE_LAYOUT> Get( const KEY& aKey )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        auto it = m_index.find( aKey );
+
+        if( it == m_index.end() )
+            return nullptr;
+
+        // Move to the front of the recently used list
+        m_entries.splice( m_entries.begin(), m_entries, it->second );
+
+        return it->second->second;
+    }
+
+    void Put( const KEY& aKey, const std::shared_ptr<const LINE_LAYOUT>& aLayout )
+    {
+        std::lock_guard<std::mutex> lock( m_mutex );
+
+        // Another thread may have laid out the same line in the meantime
+        if( m_index.count( aKey ) )
+            return;
+
+        m_entries.emplace_front( aKey, aLayout );
+        m_index[aKey] = m_entries.begin();
+
+        if( m_entries.size() > MAX_ENTRIES )
+        {
+            m_index.erase( m_entries.back().first );
+            m_entries.pop_back();
+        }
+    }
+
+private:
+    typedef std::list<std::pair<KEY, std::shared_ptr<const LINE_LAYOUT>>> ENTRIES;
+
+    std::mutex                                              m_mutex;
+    ENTRIES                                                 m_entries; ///< most recent first
+    std::unordered_map<KEY, ENTRIES::iterator, KEY_HASH>    m_index;
+};
+
+
+STROKE_FONT::LAYOUT_CACHE& STROKE_FONT::layoutCache()
+{
+    static LAYOUT_CACHE cache;
+
+    return cache;
+}
+
+
 void STROKE_FONT::drawSingleLineText( const UTF8& aText )
 {
-    double      xOffset;
-    double      yOffset;
-    VECTOR2D    baseGlyphSize( m_gal->GetGlyphSize() );
-    double      overbar_italic_comp = computeOverbarVerticalPosition() * ITALIC_TILT;
+    LAYOUT_CACHE::KEY key{ aText, m_gal->GetGlyphSize(), m_gal->GetLineWidth(),
+                           m_gal->IsFontItalic(), m_gal->IsTextMirrored(),
+                           m_gal->IsFontUnderlined() };
 
-    if( m_gal->IsTextMirrored() )
-        overbar_italic_comp = -overbar_italic_comp;
+    std::shared_ptr<const LINE_LAYOUT> layout = layoutCache().Get( key );
+
+    if( !layout )
+    {
+        auto newLayout = std::make_shared<LINE_LAYOUT>();
+
+        layoutSingleLineText( aText, *newLayout );
+        layoutCache().Put( key, newLayout );
+        layout = newLayout;
+    }
 
     // Compute the text size
-    VECTOR2D textSize = computeTextLineSize( aText );
+    const VECTOR2D& textSize = layout->m_size;
     double half_thickness = m_gal->GetLineWidth()/2;
 
     // Context needs to be saved before any transformations
@@ -311,6 +433,31 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
         break;
     }
 
+    for( const std::pair<VECTOR2D, VECTOR2D>& bar : layout->m_bars )
+        m_gal->DrawLine( bar.first, bar.second );
+
+    for( const std::vector<VECTOR2D>& stroke : layout->m_strokes )
+        m_gal->DrawPolyline( stroke.data(), (int) stroke.size() );
+
+    m_gal->Restore();
+}
+
+
+void STROKE_FONT::layoutSingleLineText( const UTF8& aText, LINE_LAYOUT& aLayout ) const
+{
+    double      xOffset;
+    double      yOffset;
+    VECTOR2D    baseGlyphSize( m_gal->GetGlyphSize() );
+    double      overbar_italic_comp = computeOverbarVerticalPosition() * ITALIC_TILT;
+
+    if( m_gal->IsTextMirrored() )
+        overbar_italic_comp = -overbar_italic_comp;
+
+    // Compute the text size
+    VECTOR2D textSize = computeTextLineSize( aText );
+
+    aLayout.m_size = textSize;
+
     if( m_gal->IsTextMirrored() )
     {
         // In case of mirrored text invert the X scale of points and their X direction
@@ -332,9 +479,6 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
     bool     in_super_or_subscript = false;
     VECTOR2D glyphSize = baseGlyphSize;
 
-    // Allocate only once (for performance)
-    std::vector<VECTOR2D> ptListScaled;
-
     yOffset = 0;
 
     for( UTF8::uni_iter chIt = aText.ubegin(), end = aText.uend(); chIt < end; ++chIt )
@@ -449,7 +593,7 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
             VECTOR2D startOverbar( overbar_start_x, overbar_start_y );
             VECTOR2D endOverbar( overbar_end_x, overbar_end_y );
 
-            m_gal->DrawLine( startOverbar, endOverbar );
+            aLayout.m_bars.emplace_back( startOverbar, endOverbar );
         }
         else
         {
@@ -462,13 +606,15 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
             VECTOR2D startUnderline( xOffset, - vOffset );
             VECTOR2D endUnderline( xOffset + glyphSize.x * bbox.GetEnd().x, - vOffset );
 
-            m_gal->DrawLine( startUnderline, endUnderline );
+            aLayout.m_bars.emplace_back( startUnderline, endUnderline );
         }
 
         for( const std::vector<VECTOR2D>* ptList : *glyph )
         {
-            int ptCount = 0;
-            ptListScaled.clear();
+            aLayout.m_strokes.emplace_back();
+
+            std::vector<VECTOR2D>& ptListScaled = aLayout.m_strokes.back();
+            ptListScaled.reserve( ptList->size() );
 
             for( const VECTOR2D& pt : *ptList )
             {
@@ -485,16 +631,11 @@ void STROKE_FONT::drawSingleLineText( const UTF8& aText )
                 }
 
                 ptListScaled.push_back( scaledPt );
-                ptCount++;
             }
-
-            m_gal->DrawPolyline( &ptListScaled[0], ptCount );
         }
 
         xOffset += glyphSize.x * bbox.GetEnd().x;
     }
-
-    m_gal->Restore();
 }
 
 
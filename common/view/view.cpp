@@ -26,6 +26,7 @@
  */
 
 
+#include <advanced_config.h>
 #include <eda_item.h>
 #include <layers_id_colors_and_visibility.h>
 
@@ -34,14 +35,18 @@
 #include <view/view_item.h>
 #include <view/view_rtree.h>
 #include <view/view_overlay.h>
+#include <view/view_profile.h>
 
 #include <gal/definitions.h>
 #include <gal/graphics_abstraction_layer.h>
+#include <math/util.h>      // for KiROUND
 #include <painter.h>
-
-#ifdef __WXDEBUG__
 #include <profile.h>
-#endif /* __WXDEBUG__  */
+
+#include <atomic>
+#include <future>
+#include <limits>
+#include <thread>
 
 namespace KIGFX {
 
@@ -199,6 +204,9 @@ private:
     /// Stores layer numbers used by the item.
     std::vector<int> m_layers;
 
+    /// Bounding box the item is indexed by in the layer R-trees, for targeted removal.
+    BOX2I m_bbox;
+
     /**
      * Save layers used by the item.
      *
@@ -267,9 +275,11 @@ VIEW::VIEW( bool aIsDynamic ) :
     m_painter( NULL ),
     m_gal( NULL ),
     m_dynamic( aIsDynamic ),
+    m_fullDamage( true ),
     m_useDrawPriority( false ),
     m_nextDrawPriority( 0 ),
-    m_reverseDrawOrder( false )
+    m_reverseDrawOrder( false ),
+    m_tiledRendering( ADVANCED_CFG::GetCfg().m_TiledRendering )
 {
     // Set m_boundary to define the max area size. The default area size
     // is defined here as the max value of a int.
@@ -318,6 +328,15 @@ VIEW::~VIEW()
 }
 
 
+void VIEW::SetProfiling( bool aEnabled )
+{
+    if( !aEnabled )
+        m_profile.reset();
+    else if( !m_profile )
+        m_profile = std::make_unique<VIEW_PROFILE>();
+}
+
+
 void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 {
     int layers[VIEW_MAX_LAYERS], layers_count;
@@ -333,14 +352,15 @@ void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 
     aItem->ViewGetLayers( layers, layers_count );
     aItem->viewPrivData()->saveLayers( layers, layers_count );
+    aItem->viewPrivData()->m_bbox = aItem->ViewBBox();
 
     m_allItems->push_back( aItem );
 
     for( int i = 0; i < layers_count; ++i )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
-        l.items->Insert( aItem );
-        MarkTargetDirty( l.target );
+        l.items->Insert( aItem, aItem->viewPrivData()->m_bbox );
+        markTargetDamaged( l.target, aItem->viewPrivData()->m_bbox );
     }
 
     SetVisible( aItem, true );
@@ -348,6 +368,49 @@ void VIEW::Add( VIEW_ITEM* aItem, int aDrawPriority )
 }
 
 
+void VIEW::Add( const std::vector<VIEW_ITEM*>& aItems )
+{
+    std::vector<std::vector<std::pair<VIEW_ITEM*, BOX2I>>> layerItems( m_layers.size() );
+    int layers[VIEW_MAX_LAYERS], layers_count;
+
+    for( VIEW_ITEM* item : aItems )
+    {
+        if( !item->m_viewPrivData )
+            item->m_viewPrivData = new VIEW_ITEM_DATA;
+
+        VIEW_ITEM_DATA* viewData = item->viewPrivData();
+
+        viewData->m_view = this;
+        viewData->m_drawPriority = m_nextDrawPriority++;
+
+        item->ViewGetLayers( layers, layers_count );
+        viewData->saveLayers( layers, layers_count );
+        viewData->m_bbox = item->ViewBBox();
+
+        m_allItems->push_back( item );
+
+        for( int i = 0; i < layers_count; ++i )
+            layerItems[layers[i]].emplace_back( item, viewData->m_bbox );
+    }
+
+    for( size_t i = 0; i < layerItems.size(); ++i )
+    {
+        if( layerItems[i].empty() )
+            continue;
+
+        VIEW_LAYER& l = m_layers[i];
+        l.items->Insert( layerItems[i] );
+        MarkTargetDirty( l.target );
+    }
+
+    for( VIEW_ITEM* item : aItems )
+    {
+        SetVisible( item, true );
+        Update( item, KIGFX::INITIAL_ADD );
+    }
+}
+
+
 void VIEW::Remove( VIEW_ITEM* aItem )
 {
     if( !aItem )
@@ -355,7 +418,8 @@ void VIEW::Remove( VIEW_ITEM* aItem )
 
     auto viewData = aItem->viewPrivData();
 
-    if( !viewData )
+    // Not added, or already gone with a Clear()
+    if( !viewData || !viewData->m_view )
         return;
 
     wxCHECK( viewData->m_view == this, /*void*/ );
@@ -373,8 +437,8 @@ void VIEW::Remove( VIEW_ITEM* aItem )
     for( int i = 0; i < layers_count; ++i )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
-        l.items->Remove( aItem );
-        MarkTargetDirty( l.target );
+        l.items->Remove( aItem, viewData->m_bbox );
+        markTargetDamaged( l.target, viewData->m_bbox );
 
         // Clear the GAL cache
         int prevGroup = viewData->getGroup( layers[i] );
@@ -930,10 +994,12 @@ void VIEW::UpdateAllLayersOrder()
 
 struct VIEW::drawItem
 {
-    drawItem( VIEW* aView, int aLayer, bool aUseDrawPriority, bool aReverseDrawOrder ) :
+    drawItem( VIEW* aView, int aLayer, bool aUseDrawPriority, bool aReverseDrawOrder,
+              PAINTER* aPainter = nullptr ) :
         view( aView ), layer( aLayer ),
         useDrawPriority( aUseDrawPriority ),
-        reverseDrawOrder( aReverseDrawOrder )
+        reverseDrawOrder( aReverseDrawOrder ),
+        painter( aPainter )
     {
     }
 
@@ -950,7 +1016,7 @@ struct VIEW::drawItem
         if( useDrawPriority )
             drawItems.push_back( aItem );
         else
-            view->draw( aItem, layer );
+            draw( aItem );
 
         return true;
     }
@@ -969,32 +1035,282 @@ struct VIEW::drawItem
                        });
 
         for( auto item : drawItems )
-            view->draw( item, layer );
+            draw( item );
+    }
+
+    void draw( VIEW_ITEM* aItem )
+    {
+        // Tiles are drawn by their own painter, which can draw all the items of the layer
+        if( painter )
+        {
+            painter->Draw( aItem, layer );
+        }
+        else if( VIEW_PROFILE* profile = view->m_profile.get() )
+        {
+            // An item of a cached layer without a group is only scheduled for an update,
+            // which updateItemGeometry() counts as tessellation; nothing is drawn this frame
+            VIEW_ITEM_DATA* viewData = aItem->viewPrivData();
+            bool            cacheMiss = view->IsCached( layer ) && viewData
+                                            && viewData->getGroup( layer ) < 0;
+
+            PROF_COUNTER timer;
+            size_t       vertices = view->m_gal->GetVertexCount();
+
+            view->draw( aItem, layer );
+
+            if( cacheMiss )
+                return;
+
+            VIEW_PROFILE::COUNTERS& type = profile->ItemType( aItem );
+
+            type.m_drawTime += timer.msecs();
+            type.m_vertices += view->m_gal->GetVertexCount() - vertices;
+            type.m_items++;
+            profile->Layer( layer ).m_items++;
+        }
+        else
+        {
+            view->draw( aItem, layer );
+        }
     }
 
     VIEW* view;
     int layer, layers[VIEW_MAX_LAYERS];
     bool useDrawPriority, reverseDrawOrder;
+    PAINTER* painter;
     std::vector<VIEW_ITEM*> drawItems;
 };
 
 
 void VIEW::redrawRect( const BOX2I& aRect )
 {
+    // Tiles are drawn concurrently, which the profile counters do not support
+    if( m_tiledRendering && !m_profile && redrawRectTiled( aRect ) )
+        return;
+
     for( VIEW_LAYER* l : m_orderedLayers )
     {
         if( l->visible && IsTargetDirty( l->target ) && areRequiredLayersEnabled( l->id ) )
+            redrawLayer( l, aRect );
+    }
+}
+
+
+void VIEW::redrawLayer( VIEW_LAYER* aLayer, const BOX2I& aRect )
+{
+    PROF_COUNTER timer( "redrawLayer", false );
+    size_t       vertices = 0;
+    drawItem     drawFunc( this, aLayer->id, m_useDrawPriority, m_reverseDrawOrder );
+
+    if( m_profile )
+    {
+        timer.Start();
+        vertices = m_gal->GetVertexCount();
+    }
+
+    m_gal->SetTarget( aLayer->target );
+    m_gal->SetLayerDepth( aLayer->renderingOrder );
+    aLayer->items->Query( aRect, drawFunc );
+
+    if( m_useDrawPriority )
+        drawFunc.deferredDraw();
+
+    if( m_profile )
+    {
+        VIEW_PROFILE::COUNTERS& layer = m_profile->Layer( aLayer->id );
+
+        layer.m_drawTime += timer.msecs();
+        layer.m_vertices += m_gal->GetVertexCount() - vertices;
+    }
+}
+
+
+bool VIEW::canPaintLayer( VIEW_LAYER* aLayer, const BOX2I& aRect ) const
+{
+    bool canPaint = true;
+
+    auto visitor =
+            [&]( VIEW_ITEM* aItem ) -> bool
+            {
+                canPaint = m_painter->CanDraw( aItem );
+                return canPaint;
+            };
+
+    aLayer->items->Query( aRect, visitor );
+
+    return canPaint;
+}
+
+
+bool VIEW::redrawRectTiled( const BOX2I& aRect )
+{
+    if( m_printMode > 0 )
+        return false;
+
+    // Layers of the main target in drawing order; the overlay target has its own buffer
+    std::vector<VIEW_LAYER*> mainLayers;
+    std::vector<VIEW_LAYER*> overlayLayers;
+
+    for( VIEW_LAYER* l : m_orderedLayers )
+    {
+        if( !l->visible || !IsTargetDirty( l->target ) || !areRequiredLayersEnabled( l->id ) )
+            continue;
+
+        // Cached layers are replayed from GAL groups on the view GAL
+        if( l->target == TARGET_CACHED )
+            return false;
+
+        if( l->target == TARGET_OVERLAY )
+            overlayLayers.push_back( l );
+        else
+            mainLayers.push_back( l );
+    }
+
+    size_t threadCount = std::thread::hardware_concurrency();
+
+    if( threadCount < 2 || mainLayers.empty() )
+        return false;
+
+    std::vector<std::unique_ptr<PAINTER>> painters;
+
+    for( size_t ii = 0; ii < threadCount; ++ii )
+    {
+        PAINTER* clone = m_painter->Clone( m_gal );
+
+        if( !clone )
+            return false;
+
+        painters.emplace_back( clone );
+    }
+
+    // Check that the GAL can draw in tiles before drawing anything
+    m_gal->SetTarget( TARGET_NONCACHED );
+
+    GAL* probe = m_gal->BeginTile( BOX2I( VECTOR2I( 0, 0 ), m_gal->GetScreenPixelSize() ) );
+
+    if( !probe )
+        return false;
+
+    m_gal->EndTile( probe );
+
+    // Runs of layers the painter can draw by itself are drawn in tiles; layers holding items
+    // that need VIEW_ITEM::ViewDraw() (which draws on the view GAL) are drawn in between.
+    size_t first = 0;
+
+    while( first < mainLayers.size() )
+    {
+        size_t last = first;
+
+        while( last < mainLayers.size() && canPaintLayer( mainLayers[last], aRect ) )
+            last++;
+
+        if( last > first )
         {
-            drawItem drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder );
+            std::vector<VIEW_LAYER*> run( mainLayers.begin() + first, mainLayers.begin() + last );
+            redrawTiles( run, aRect, painters );
+            first = last;
+        }
+        else
+        {
+            redrawLayer( mainLayers[first], aRect );
+            first++;
+        }
+    }
+
+    for( VIEW_LAYER* l : overlayLayers )
+        redrawLayer( l, aRect );
+
+    return true;
+}
+
+
+void VIEW::redrawTiles( const std::vector<VIEW_LAYER*>& aLayers, const BOX2I& aRect,
+                        std::vector<std::unique_ptr<PAINTER>>& aPainters )
+{
+    // Horizontal bands, several per thread so that busy parts of the board are shared out
+    const VECTOR2I screenSize = m_gal->GetScreenPixelSize();
+    const int      bandCount = std::max( 1, std::min<int>( screenSize.y,
+                                                           aPainters.size() * 4 ) );
+    const double   margin = ToWorld( 2.0 );   // antialiasing and rounding of line ends
+
+    std::vector<GAL*>  tiles;
+    std::vector<BOX2I> tileRects;
+
+    m_gal->SetTarget( TARGET_NONCACHED );
+
+    for( int ii = 0; ii < bandCount; ++ii )
+    {
+        int top = (int) ( (int64_t) screenSize.y * ii / bandCount );
+        int bottom = (int) ( (int64_t) screenSize.y * ( ii + 1 ) / bandCount );
+
+        GAL* tile = m_gal->BeginTile( BOX2I( VECTOR2I( 0, top ),
+                                             VECTOR2I( screenSize.x, bottom - top ) ) );
+
+        if( !tile )
+            continue;
+
+        BOX2D world( ToWorld( VECTOR2D( 0, top ) ), VECTOR2D( 0, 0 ) );
+        world.Merge( ToWorld( VECTOR2D( screenSize.x, top ) ) );
+        world.Merge( ToWorld( VECTOR2D( 0, bottom ) ) );
+        world.Merge( ToWorld( VECTOR2D( screenSize.x, bottom ) ) );
+        world.Inflate( margin, margin );
 
-            m_gal->SetTarget( l->target );
-            m_gal->SetLayerDepth( l->renderingOrder );
-            l->items->Query( aRect, drawFunc );
+        BOX2I tileRect = aRect;
 
-            if( m_useDrawPriority )
-                drawFunc.deferredDraw();
+        if( world.GetWidth() < std::numeric_limits<int>::max()
+                && world.GetHeight() < std::numeric_limits<int>::max() )
+        {
+            tileRect = BOX2I( world.GetPosition(), world.GetSize() ).Intersect( aRect );
         }
+
+        tiles.push_back( tile );
+        tileRects.push_back( tileRect );
+    }
+
+    if( tiles.empty() )
+    {
+        for( VIEW_LAYER* l : aLayers )
+            redrawLayer( l, aRect );
+
+        return;
     }
+
+    std::atomic<size_t> nextTile( 0 );
+    std::vector<std::future<size_t>> returns( aPainters.size() );
+
+    auto draw_lambda =
+            [&]( PAINTER* aPainter ) -> size_t
+            {
+                for( size_t i = nextTile++; i < tiles.size(); i = nextTile++ )
+                {
+                    aPainter->SetGAL( tiles[i] );
+
+                    for( VIEW_LAYER* l : aLayers )
+                    {
+                        drawItem drawFunc( this, l->id, m_useDrawPriority, m_reverseDrawOrder,
+                                           aPainter );
+
+                        tiles[i]->SetLayerDepth( l->renderingOrder );
+                        l->items->Query( tileRects[i], drawFunc );
+
+                        if( m_useDrawPriority )
+                            drawFunc.deferredDraw();
+                    }
+
+                    tiles[i]->Flush();
+                }
+
+                return 1;
+            };
+
+    for( size_t ii = 0; ii < aPainters.size(); ++ii )
+        returns[ii] = std::async( std::launch::async, draw_lambda, aPainters[ii].get() );
+
+    for( size_t ii = 0; ii < aPainters.size(); ++ii )
+        returns[ii].wait();
+
+    for( GAL* tile : tiles )
+        m_gal->EndTile( tile );
 }
 
 
@@ -1010,6 +1326,14 @@ void VIEW::draw( VIEW_ITEM* aItem, int aLayer, bool aImmediate )
         // Draw using cached information or create one
         int group = viewData->getGroup( aLayer );
 
+        if( m_profile )
+        {
+            if( group >= 0 )
+                m_profile->Layer( aLayer ).m_cacheHits++;
+            else
+                m_profile->Layer( aLayer ).m_cacheMisses++;
+        }
+
         if( group >= 0 )
             m_gal->DrawGroup( group );
         else
@@ -1084,6 +1408,20 @@ void VIEW::Clear()
 {
     BOX2I r;
     r.SetMaximum();
+
+    // The items no longer belong to this view, and the GAL cache holding their groups goes
+    for( VIEW_ITEM* item : *m_allItems )
+    {
+        VIEW_ITEM_DATA* viewData = item->viewPrivData();
+
+        if( viewData && viewData->m_view == this )
+        {
+            viewData->deleteGroups();
+            viewData->clearUpdateFlags();
+            viewData->m_view = nullptr;
+        }
+    }
+
     m_allItems->clear();
 
     for( VIEW_LAYER& layer : m_layers )
@@ -1095,9 +1433,156 @@ void VIEW::Clear()
 }
 
 
+void VIEW::markTargetDamaged( int aTarget, const BOX2I& aRect )
+{
+    if( aTarget != TARGET_NONCACHED )
+    {
+        MarkTargetDirty( aTarget );
+        return;
+    }
+
+    if( !IsTargetDirty( TARGET_NONCACHED ) )
+    {
+        m_dirtyTargets[TARGET_NONCACHED] = true;
+        m_fullDamage = false;
+        m_damage.clear();
+    }
+
+    if( m_fullDamage )
+        return;
+
+    // Merge with an overlapping region, so moving an item does not add a region per step
+    for( BOX2I& rect : m_damage )
+    {
+        if( rect.Intersects( aRect ) )
+        {
+            rect.Merge( aRect );
+            return;
+        }
+    }
+
+    if( (int) m_damage.size() >= MAX_DAMAGE_RECTS )
+    {
+        m_fullDamage = true;
+        m_damage.clear();
+        return;
+    }
+
+    m_damage.push_back( aRect );
+}
+
+
+bool VIEW::HasPartialDamage() const
+{
+    if( !IsTargetDirty( TARGET_NONCACHED ) || m_fullDamage || IsTargetDirty( TARGET_CACHED ) )
+        return false;
+
+    // Clipping is only implemented (and needed) by the software renderer
+    if( !m_gal || !m_gal->IsCairoEngine() || m_printMode > 0 )
+        return false;
+
+    // redrawDamage() clears the regions in the buffer of the non-cached target, which Cairo
+    // shares with the cached target, and repaints them from every layer drawn into that
+    // buffer.  None of the targets sharing it may need a full redraw on top of that.
+    for( int target = 0; target < TARGETS_NUMBER; ++target )
+    {
+        if( target != TARGET_NONCACHED && IsTargetDirty( target )
+                && m_gal->IsTargetBufferShared( TARGET_NONCACHED, (RENDER_TARGET) target ) )
+        {
+            return false;
+        }
+    }
+
+    const BOX2D viewport = GetViewport();
+
+    // The regions are redrawn using integer world coordinates
+    if( viewport.GetWidth() > std::numeric_limits<int>::max()
+            || viewport.GetHeight() > std::numeric_limits<int>::max() )
+    {
+        return false;
+    }
+
+    const double screenArea = viewport.GetWidth() * viewport.GetHeight();
+    double damagedArea = 0.0;
+
+    for( const BOX2I& rect : m_damage )
+    {
+        BOX2D visible( rect.GetPosition(), rect.GetSize() );
+
+        if( !visible.Intersects( viewport ) )
+            continue;
+
+        visible = visible.Intersect( viewport );
+        damagedArea += visible.GetWidth() * visible.GetHeight();
+    }
+
+    // Past this point, clearing and drawing the regions separately costs about as much
+    // as redrawing the whole screen
+    return damagedArea < screenArea / 2;
+}
+
+
+void VIEW::redrawDamage()
+{
+    const VECTOR2I screenSize = m_gal->GetScreenPixelSize();
+    const BOX2I    screen( VECTOR2I( 0, 0 ), screenSize );
+    const BOX2D    viewport = GetViewport();
+
+    m_gal->SetTarget( TARGET_NONCACHED );
+
+    for( const BOX2I& rect : m_damage )
+    {
+        BOX2D visible( rect.GetPosition(), rect.GetSize() );
+
+        if( !visible.Intersects( viewport ) )
+            continue;
+
+        visible = visible.Intersect( viewport );
+
+        // Pad the region to cover antialiasing and rounding to pixels
+        BOX2D screenBox( ToScreen( visible.GetOrigin() ), VECTOR2D( 0, 0 ) );
+        screenBox.Merge( ToScreen( visible.GetEnd() ) );
+        screenBox.Normalize();
+
+        BOX2I screenRect( VECTOR2I( KiROUND( screenBox.GetX() ) - 2,
+                                    KiROUND( screenBox.GetY() ) - 2 ),
+                          VECTOR2I( KiROUND( screenBox.GetWidth() ) + 4,
+                                    KiROUND( screenBox.GetHeight() ) + 4 ) );
+
+        screenRect = screenRect.Intersect( screen );
+
+        if( screenRect.GetWidth() <= 0 || screenRect.GetHeight() <= 0 )
+            continue;
+
+        BOX2D worldBox( ToWorld( VECTOR2D( screenRect.GetOrigin() ) ), VECTOR2D( 0, 0 ) );
+        worldBox.Merge( ToWorld( VECTOR2D( screenRect.GetEnd() ) ) );
+        worldBox.Normalize();
+
+        BOX2I worldRect( worldBox.GetPosition(), worldBox.GetSize() );
+
+        m_gal->SetClipRect( screenRect );
+        m_gal->ClearScreen();
+        m_gal->DrawGrid();
+
+        // The cached layers drawn into the same buffer were cleared as well
+        for( VIEW_LAYER* l : m_orderedLayers )
+        {
+            if( l->visible && areRequiredLayersEnabled( l->id )
+                    && m_gal->IsTargetBufferShared( l->target, TARGET_NONCACHED ) )
+            {
+                redrawLayer( l, worldRect );
+            }
+        }
+
+        m_gal->ResetClipRect();
+    }
+}
+
+
 void VIEW::ClearTargets()
 {
-    if( IsTargetDirty( TARGET_CACHED ) || IsTargetDirty( TARGET_NONCACHED ) )
+    if( IsTargetDirty( TARGET_CACHED )
+            || ( IsTargetDirty( TARGET_NONCACHED ) && !HasPartialDamage() ) )
     {
         // TARGET_CACHED and TARGET_NONCACHED have to be redrawn together, as they contain
         // layers that rely on each other (eg. netnames are noncached, but tracks - are cached)
@@ -1116,9 +1601,12 @@ void VIEW::ClearTargets()
 
 void VIEW::Redraw()
 {
-#ifdef __WXDEBUG__
     PROF_COUNTER totalRealTime;
-#endif /* __WXDEBUG__ */
+
+    // Frames redrawing only the overlay neither replace the statistics of the last full frame
+    // nor add to those of the next one
+    const bool profileFrame = m_profile && ( IsTargetDirty( TARGET_CACHED )
+                                             || IsTargetDirty( TARGET_NONCACHED ) );
 
     VECTOR2D screenSize = m_gal->GetScreenPixelSize();
     BOX2D    rect( ToWorld( VECTOR2D( 0, 0 ) ),
@@ -1133,14 +1621,37 @@ void VIEW::Redraw()
             rect.GetHeight() > std::numeric_limits<int>::max() )
         recti.SetMaximum();
 
+    if( HasPartialDamage() )
+    {
+        redrawDamage();
+
+        // Only the other targets are left to redraw in full
+        markTargetClean( TARGET_NONCACHED );
+    }
+
     redrawRect( recti );
     // All targets were redrawn, so nothing is dirty
     markTargetClean( TARGET_CACHED );
     markTargetClean( TARGET_NONCACHED );
     markTargetClean( TARGET_OVERLAY );
 
-#ifdef __WXDEBUG__
     totalRealTime.Stop();
+
+    if( profileFrame )
+    {
+        m_profile->EndFrame( totalRealTime.msecs() );
+
+        // Let overlay items showing the statistics catch up on the next paint.  Without an
+        // overlay target, that paint would be a full frame again.
+        if( m_gal->HasTarget( TARGET_OVERLAY ) )
+            MarkTargetDirty( TARGET_OVERLAY );
+    }
+    else if( m_profile )
+    {
+        m_profile->DiscardFrame();
+    }
+
+#ifdef __WXDEBUG__
     wxLogTrace( "GAL_PROFILE", "VIEW::Redraw(): %.1f ms", totalRealTime.msecs() );
 #endif /* __WXDEBUG__ */
 }
@@ -1184,6 +1695,9 @@ void VIEW::clearGroupCache()
 
 void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
 {
+    // The item must be erased where it was drawn and redrawn where it will be drawn now
+    BOX2I damage = aItem->viewPrivData()->m_bbox;
+
     if( aUpdateFlags & INITIAL_ADD )
     {
         // Don't update layers or bbox, since it was done in VIEW::Add()
@@ -1204,6 +1718,13 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
         }
     }
 
+    // A geometry or layer update has just refreshed the cached bbox.  Any other update (e.g. a
+    // repaint) may still draw the item over a different area than the cached bbox.
+    if( aUpdateFlags & ( GEOMETRY | LAYERS ) )
+        damage.Merge( aItem->viewPrivData()->m_bbox );
+    else
+        damage.Merge( aItem->ViewBBox() );
+
     int layers[VIEW_MAX_LAYERS], layers_count;
     aItem->ViewGetLayers( layers, layers_count );
 
@@ -1221,7 +1742,7 @@ void VIEW::invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags )
         }
 
         // Mark those layers as dirty, so the VIEW will be refreshed
-        MarkTargetDirty( m_layers[layerId].target );
+        markTargetDamaged( m_layers[layerId].target, damage );
     }
 
     aItem->viewPrivData()->clearUpdateFlags();
@@ -1282,6 +1803,15 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
     if( group >= 0 )
         m_gal->DeleteGroup( group );
 
+    PROF_COUNTER timer( "updateItemGeometry", false );
+    size_t       vertices = 0;
+
+    if( m_profile )
+    {
+        timer.Start();
+        vertices = m_gal->GetVertexCount();
+    }
+
     group = m_gal->BeginGroup();
     viewData->setGroup( aLayer, group );
 
@@ -1289,6 +1819,20 @@ void VIEW::updateItemGeometry( VIEW_ITEM* aItem, int aLayer )
         aItem->ViewDraw( aLayer, this ); // Alternative drawing method
 
     m_gal->EndGroup();
+
+    if( m_profile )
+    {
+        double ms = timer.msecs();
+        size_t count = m_gal->GetVertexCount() - vertices;
+
+        for( VIEW_PROFILE::COUNTERS* counters : { &m_profile->Layer( aLayer ),
+                                                  &m_profile->ItemType( aItem ) } )
+        {
+            counters->m_tessellationTime += ms;
+            counters->m_tessellatedItems++;
+            counters->m_vertices += count;
+        }
+    }
 }
 
 
@@ -1296,14 +1840,20 @@ void VIEW::updateBbox( VIEW_ITEM* aItem )
 {
     int layers[VIEW_MAX_LAYERS], layers_count;
 
+    auto viewData = aItem->viewPrivData();
+    BOX2I oldBBox = viewData->m_bbox;
+
+    viewData->m_bbox = aItem->ViewBBox();
+
     aItem->ViewGetLayers( layers, layers_count );
 
     for( int i = 0; i < layers_count; ++i )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
-        l.items->Remove( aItem );
-        l.items->Insert( aItem );
-        MarkTargetDirty( l.target );
+        l.items->Remove( aItem, oldBBox );
+        l.items->Insert( aItem, viewData->m_bbox );
+        markTargetDamaged( l.target, oldBBox );
+        markTargetDamaged( l.target, viewData->m_bbox );
     }
 }
 
@@ -1322,8 +1872,8 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
     for( int i = 0; i < layers_count; ++i )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
-        l.items->Remove( aItem );
-        MarkTargetDirty( l.target );
+        l.items->Remove( aItem, viewData->m_bbox );
+        markTargetDamaged( l.target, viewData->m_bbox );
 
         if( IsCached( l.id ) )
         {
@@ -1341,12 +1891,13 @@ void VIEW::updateLayers( VIEW_ITEM* aItem )
     // Add the item to new layer set
     aItem->ViewGetLayers( layers, layers_count );
     viewData->saveLayers( layers, layers_count );
+    viewData->m_bbox = aItem->ViewBBox();
 
     for( int i = 0; i < layers_count; i++ )
     {
         VIEW_LAYER& l = m_layers[layers[i]];
-        l.items->Insert( aItem );
-        MarkTargetDirty( l.target );
+        l.items->Insert( aItem, viewData->m_bbox );
+        markTargetDamaged( l.target, viewData->m_bbox );
     }
 }
 
@@ -1386,24 +1937,54 @@ void VIEW::RecacheAllItems()
 }
 
 
+void VIEW::prepareItems( const std::vector<VIEW_ITEM*>& aItems )
+{
+    // Draw() builds whatever it needs on the drawing thread, unless the items are drawn by
+    // several tile workers at once, which must not build the same lazy geometry.
+    if( !m_tiledRendering )
+        return;
+
+    for( VIEW_ITEM* item : aItems )
+        m_painter->Prepare( item );
+}
+
+
 void VIEW::UpdateItems()
 {
     if( m_gal->IsVisible() )
     {
-        GAL_UPDATE_CONTEXT ctx( m_gal );
+        std::vector<VIEW_ITEM*> dirtyItems;
+        std::vector<VIEW_ITEM*> redrawnItems;
 
         for( VIEW_ITEM* item : *m_allItems )
         {
             auto viewData = item->viewPrivData();
 
-            if( !viewData )
+            if( !viewData || viewData->m_requiredUpdate == NONE )
                 continue;
 
-            if( viewData->m_requiredUpdate != NONE )
-            {
-                invalidateItem( item, viewData->m_requiredUpdate );
-                viewData->m_requiredUpdate = NONE;
-            }
+            dirtyItems.push_back( item );
+
+            if( viewData->m_requiredUpdate & ( INITIAL_ADD | GEOMETRY | LAYERS | REPAINT ) )
+                redrawnItems.push_back( item );
+        }
+
+        // Lazy geometry must exist before the tile workers share the items
+        PROF_COUNTER prepareTimer;
+
+        prepareItems( redrawnItems );
+
+        if( m_profile )
+            m_profile->AddPrepareTime( prepareTimer.msecs() );
+
+        GAL_UPDATE_CONTEXT ctx( m_gal );
+
+        for( VIEW_ITEM* item : dirtyItems )
+        {
+            auto viewData = item->viewPrivData();
+
+            invalidateItem( item, viewData->m_requiredUpdate );
+            viewData->m_requiredUpdate = NONE;
         }
     }
 }
@@ -1499,6 +2080,14 @@ bool VIEW::IsVisible( const VIEW_ITEM* aItem ) const
 }
 
 
+bool VIEW::IsOnOtherView( const VIEW_ITEM* aItem ) const
+{
+    const auto viewData = aItem->viewPrivData();
+
+    return viewData && viewData->m_view && viewData->m_view != this;
+}
+
+
 void VIEW::Update( const VIEW_ITEM* aItem ) const
 {
     Update( aItem, ALL );
@@ -0,0 +1,188 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <view/view_profile.h>
+#include <view/view.h>
+#include <eda_item.h>
+#include <layers_id_colors_and_visibility.h>
+#include <preview_items/preview_utils.h>
+
+#include <algorithm>
+
+#include <wx/arrstr.h>
+
+
+using namespace KIGFX;
+
+
+VIEW_PROFILE::COUNTERS& VIEW_PROFILE::ItemType( const VIEW_ITEM* aItem )
+{
+    // Items that are not EDA_ITEMs (overlays, groups, ...) are counted together
+    const EDA_ITEM* item = dynamic_cast<const EDA_ITEM*>( aItem );
+    int             type = item ? (int) item->Type() : -1;
+
+    if( !m_typeNames.count( type ) )
+        m_typeNames[type] = item ? item->GetClass() : wxString( wxT( "other" ) );
+
+    return m_current.m_itemTypes[type];
+}
+
+
+void VIEW_PROFILE::EndFrame( double aFrameTime )
+{
+    m_frameTime = aFrameTime;
+    m_prepareTime = m_current.m_prepareTime;
+    m_layers.swap( m_current.m_layers );
+    m_itemTypes.swap( m_current.m_itemTypes );
+    m_frameCount++;
+
+    m_current = FRAME();
+}
+
+
+void VIEW_PROFILE::Clear()
+{
+    m_current = FRAME();
+    m_frameTime = 0.0;
+    m_prepareTime = 0.0;
+    m_frameCount = 0;
+    m_layers.clear();
+    m_itemTypes.clear();
+}
+
+
+static wxString formatCounters( const wxString& aName, const VIEW_PROFILE::COUNTERS& aCounters )
+{
+    wxString line = wxString::Format( wxT( "%s: %.2f ms, %d items" ), aName,
+                                      aCounters.m_drawTime, aCounters.m_items );
+
+    if( aCounters.m_tessellatedItems )
+    {
+        line += wxString::Format( wxT( ", tessellated %d in %.2f ms" ),
+                                  aCounters.m_tessellatedItems, aCounters.m_tessellationTime );
+    }
+
+    if( aCounters.m_cacheHits || aCounters.m_cacheMisses )
+    {
+        line += wxString::Format( wxT( ", cache %d hits %d misses" ), aCounters.m_cacheHits,
+                                  aCounters.m_cacheMisses );
+    }
+
+    if( aCounters.m_vertices )
+        line += wxString::Format( wxT( ", %lu vertices" ), (unsigned long) aCounters.m_vertices );
+
+    return line;
+}
+
+
+/**
+ * Append one line per entry of a counter map, most expensive first.
+ */
+static void formatSorted( wxString& aReport, const std::map<int, VIEW_PROFILE::COUNTERS>& aMap,
+                          const std::function<wxString( int )>& aName, int aMaxLines )
+{
+    std::vector<std::pair<int, const VIEW_PROFILE::COUNTERS*>> sorted;
+
+    for( const std::pair<const int, VIEW_PROFILE::COUNTERS>& entry : aMap )
+        sorted.emplace_back( entry.first, &entry.second );
+
+    std::sort( sorted.begin(), sorted.end(),
+               []( const std::pair<int, const VIEW_PROFILE::COUNTERS*>& a,
+                   const std::pair<int, const VIEW_PROFILE::COUNTERS*>& b )
+               {
+                   return a.second->m_drawTime + a.second->m_tessellationTime
+                          > b.second->m_drawTime + b.second->m_tessellationTime;
+               } );
+
+    if( aMaxLines > 0 && (int) sorted.size() > aMaxLines )
+        sorted.resize( aMaxLines );
+
+    for( const std::pair<int, const VIEW_PROFILE::COUNTERS*>& entry : sorted )
+        aReport += wxT( "  " ) + formatCounters( aName( entry.first ), *entry.second ) + '\n';
+}
+
+
+wxString VIEW_PROFILE::Format( const std::function<wxString( int )>& aLayerName,
+                               int aMaxLines ) const
+{
+    wxString report = wxString::Format( wxT( "Frame %d: %.2f ms, prepare %.2f ms\n" ),
+                                        m_frameCount, m_frameTime, m_prepareTime );
+
+    report += wxT( "Layers:\n" );
+    formatSorted( report, m_layers,
+                  [&]( int aLayer ) -> wxString
+                  {
+                      if( aLayerName )
+                          return aLayerName( aLayer );
+
+                      return wxString::Format( wxT( "layer %d" ), aLayer );
+                  },
+                  aMaxLines );
+
+    report += wxT( "Item types:\n" );
+    formatSorted( report, m_itemTypes,
+                  [&]( int aType ) -> wxString
+                  {
+                      return m_typeNames.at( aType );
+                  },
+                  aMaxLines );
+
+    return report;
+}
+
+
+const BOX2I VIEW_PROFILE_OVERLAY::ViewBBox() const
+{
+    BOX2I bbox;
+    bbox.SetMaximum();
+    return bbox;
+}
+
+
+void VIEW_PROFILE_OVERLAY::ViewDraw( int aLayer, VIEW* aView ) const
+{
+    if( !m_profile || !m_profile->GetFrameCount() )
+        return;
+
+    const int             maxLines = 8;
+    std::vector<wxString> lines;
+    wxString              report = m_profile->Format( m_layerName, maxLines );
+
+    report.Trim();
+
+    for( const wxString& line : wxSplit( report, '\n', '\0' ) )
+        lines.push_back( line );
+
+    // The report hangs from the top left corner of the screen
+    VECTOR2D corner = aView->ToWorld( VECTOR2D( 0.0, 0.0 ) );
+
+    PREVIEW::DrawTextNextToCursor( aView, corner, VECTOR2D( -1.0, -1.0 ), lines,
+                                   aLayer == LAYER_SELECT_OVERLAY );
+}
+
+
+void VIEW_PROFILE_OVERLAY::ViewGetLayers( int aLayers[], int& aCount ) const
+{
+    aLayers[0] = LAYER_SELECT_OVERLAY;  // drop shadows
+    aLayers[1] = LAYER_GP_OVERLAY;
+    aCount = 2;
+}
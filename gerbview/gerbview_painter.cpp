@@ -267,7 +267,8 @@ void GERBVIEW_PAINTER::draw( /*const*/ GERBER_DRAW_ITEM* aItem, int aLayer )
         if( !isFilled )
             m_gal->SetLineWidth( m_gerbviewSettings.m_outlineWidth );
 
-        std::vector<VECTOR2I> pts = aItem->m_Polygon.COutline( 0 ).CPoints();
+        const SHAPE_LINE_CHAIN& outline = aItem->m_Polygon.COutline( 0 );
+        std::vector<VECTOR2I>   pts( outline.CPoints().begin(), outline.CPoints().end() );
 
         for( auto& pt : pts )
             pt = aItem->GetABPosition( pt );
@@ -435,7 +436,7 @@ void GERBVIEW_PAINTER::drawPolygon(
 
     SHAPE_POLY_SET poly;
     poly.NewOutline();
-    const std::vector<VECTOR2I> pts = aPolygon.COutline( 0 ).CPoints();
+    const SHAPE_LINE_CHAIN::POINT_VECTOR& pts = aPolygon.COutline( 0 ).CPoints();
     VECTOR2I       offset = aShift ? VECTOR2I( aParent->m_Start ) : VECTOR2I( 0, 0 );
 
     for( auto& pt : pts )
@@ -155,6 +155,17 @@ public:
      */
     double m_SmallDrillMarkSize;
 
+    /**
+     * Draw the non-cached layers of software (Cairo) canvases in parallel tiles.
+     */
+    bool m_TiledRendering;
+
+    /**
+     * Profile the drawing of the board canvas and show the statistics of the last frame over
+     * it (see KIGFX::VIEW_PROFILE).
+     */
+    bool m_ShowDrawProfile;
+
 private:
     ADVANCED_CFG();
 
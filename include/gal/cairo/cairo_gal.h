@@ -216,6 +216,18 @@ public:
     ///< @copydoc GAL::DrawGrid()
     void DrawGrid() override;
 
+    /// @copydoc GAL::BeginTile()
+    GAL* BeginTile( const BOX2I& aScreenRect ) override;
+
+    /// @copydoc GAL::EndTile()
+    void EndTile( GAL* aTile ) override;
+
+    /// @copydoc GAL::SetClipRect()
+    void SetClipRect( const BOX2I& aScreenRect ) override;
+
+    /// @copydoc GAL::ResetClipRect()
+    void ResetClipRect() override;
+
 
 protected:
     // Geometric transforms according to the currentWorld2Screen transform matrix:
@@ -349,6 +361,23 @@ protected:
 };
 
 
+/**
+ * A Cairo GAL drawing into an image surface provided by the caller, without any window.
+ *
+ * Used for the tiles of tiled rendering (the surface then aliases a region of the parent
+ * GAL's buffer) and for offscreen rendering.
+ */
+class CAIRO_IMAGE_GAL : public CAIRO_GAL_BASE
+{
+public:
+    /**
+     * @param aSurface is the image surface to draw on.  The GAL keeps its own reference.
+     */
+    CAIRO_IMAGE_GAL( GAL_DISPLAY_OPTIONS& aDisplayOptions, cairo_surface_t* aSurface );
+
+};
+
+
 class CAIRO_GAL : public CAIRO_GAL_BASE, public wxWindow
 {
 public:
@@ -389,6 +418,8 @@ public:
 
     void ClearTarget( RENDER_TARGET aTarget ) override;
 
+    bool IsTargetBufferShared( RENDER_TARGET aTarget, RENDER_TARGET aOther ) const override;
+
     /**
      * Post an event to m_paint_listener.
      *
@@ -557,6 +557,13 @@ public:
      */
     virtual void ClearCache() {};
 
+    /**
+     * Return the number of vertices submitted for drawing since the GAL was created, either
+     * as new geometry or by drawing a cached group.  Used to profile drawing; always 0 for
+     * GALs that do not tessellate.
+     */
+    virtual size_t GetVertexCount() const { return 0; }
+
     // --------------------------------------------------------
     // Handling the world <-> screen transformation
     // --------------------------------------------------------
@@ -790,6 +797,50 @@ public:
         return true;
     };
 
+    /**
+     * Return true if two targets are rendered to the same buffer, so that clearing a region
+     * of one also clears it in the other.
+     *
+     * By default all the targets are assumed to share a single buffer.
+     */
+    virtual bool IsTargetBufferShared( RENDER_TARGET aTarget, RENDER_TARGET aOther ) const
+    {
+        return true;
+    }
+
+    /**
+     * Create a GAL drawing a region of the current target with the same view settings as
+     * this one.
+     *
+     * Tiles of one target may be drawn concurrently from different threads.  Nothing must be
+     * drawn with this GAL until all its tiles have been passed to EndTile().
+     *
+     * @param aScreenRect is the region of the target, in screen pixels.
+     * @return the tile or nullptr if the GAL does not support tiled rendering.
+     */
+    virtual GAL* BeginTile( const BOX2I& aScreenRect ) { return nullptr; }
+
+    /**
+     * Merge the region drawn by a tile created with BeginTile() into its target and destroy
+     * the tile.
+     */
+    virtual void EndTile( GAL* aTile ) {}
+
+    /**
+     * Restrict drawing on the current target to a rectangle, until ResetClipRect() is called.
+     *
+     * Only the software renderer implements clipping; VIEW checks IsCairoEngine() before
+     * relying on it.
+     *
+     * @param aScreenRect is the drawable region, in screen pixels.
+     */
+    virtual void SetClipRect( const BOX2I& aScreenRect ) {}
+
+    /**
+     * Remove the clipping set by SetClipRect() from the current target.
+     */
+    virtual void ResetClipRect() {}
+
     /**
      * Set negative draw mode in the renderer.
      *
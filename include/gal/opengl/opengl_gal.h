@@ -221,6 +221,9 @@ public:
     /// @copydoc GAL::ClearCache()
     void ClearCache() override;
 
+    /// @copydoc GAL::GetVertexCount()
+    size_t GetVertexCount() const override;
+
     // --------------------------------------------------------
     // Handling the world <-> screen transformation
     // --------------------------------------------------------
@@ -348,6 +348,15 @@ public:
      */
     void EnableDepthTest( bool aEnabled );
 
+    /**
+     * Return the number of vertices stored or drawn from a cached item since the manager was
+     * created.
+     */
+    size_t GetVertexCount() const
+    {
+        return m_vertexCount;
+    }
+
 protected:
     /**
      * Apply all transformation to the given coordinates and store them at the specified target.
@@ -382,6 +391,9 @@ protected:
 
     /// Currently available reserved space
     unsigned int            m_reservedSpace;
+
+    /// Vertices stored or drawn so far, for profiling
+    mutable size_t          m_vertexCount;
 };
 
 } // namespace KIGFX
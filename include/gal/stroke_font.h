@@ -146,10 +146,34 @@ private:
      * Draw a single line of text. Multiline texts should be split before using the
      * function.
      *
+     * The strokes of the line are taken from the layout cache (see layoutCache()) when the
+     * same string was drawn recently with the same attributes.
+     *
      * @param aText is the text to be drawn.
      */
     void drawSingleLineText( const UTF8& aText );
 
+    ///< The strokes of a single line of text
+    struct LINE_LAYOUT;
+
+    ///< Least recently used cache of LINE_LAYOUTs
+    class LAYOUT_CACHE;
+
+    /**
+     * Lay out a single line of text with the current GAL text attributes.  The strokes are
+     * in the line's own coordinates: the justification is applied when drawing.
+     *
+     * @param aText is the text to be laid out.
+     * @param aLayout receives the text size and the strokes.
+     */
+    void layoutSingleLineText( const UTF8& aText, LINE_LAYOUT& aLayout ) const;
+
+    /**
+     * @return the layout cache shared by all the stroke fonts (and so by all GALs, including
+     *         the one used by the plotters).
+     */
+    static LAYOUT_CACHE& layoutCache();
+
     /**
      * Returns number of lines for a given text.
      *
@@ -95,6 +95,35 @@ public:
      */
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) = 0;
 
+    /**
+     * Build and cache any item geometry that Draw() would otherwise compute, without touching
+     * the GAL.
+     *
+     * VIEW calls this on the GUI thread for items about to be redrawn when it draws in tiles
+     * (see GAL::BeginTile()), so that the tile workers only read caches built beforehand.
+     *
+     * @param aItem is an item that is about to be drawn.
+     */
+    virtual void Prepare( const VIEW_ITEM* aItem ) {}
+
+    /**
+     * Create a painter with the same settings, drawing on \a aGal.
+     *
+     * VIEW uses clones to draw several regions of the screen concurrently (see
+     * GAL::BeginTile()), one clone per thread.  Painters that do not support being used
+     * concurrently return nullptr.
+     *
+     * @param aGal is the GAL the new painter draws on (may be changed later with SetGAL()).
+     * @return the new painter, owned by the caller.
+     */
+    virtual PAINTER* Clone( GAL* aGal ) const { return nullptr; }
+
+    /**
+     * Return true if Draw() can draw \a aItem by itself, i.e. without falling back to
+     * VIEW_ITEM::ViewDraw().  Only items passing this test are drawn by clones.
+     */
+    virtual bool CanDraw( const VIEW_ITEM* aItem ) const { return false; }
+
 protected:
     /// Instance of graphic abstraction layer that gives an interface to call
     /// commands used to draw (eg. DrawLine, DrawCircle, etc.)
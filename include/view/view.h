@@ -46,6 +46,7 @@ class GAL;
 class VIEW_ITEM;
 class VIEW_GROUP;
 class VIEW_RTREE;
+class VIEW_PROFILE;
 
 /**
  * Hold a (potentially large) number of VIEW_ITEMs and renders them on a graphics device
@@ -97,6 +98,16 @@ public:
      */
     virtual void Add( VIEW_ITEM* aItem, int aDrawPriority = -1 );
 
+    /**
+     * Add many #VIEW_ITEMs to the view at once, with sequential draw priorities.
+     *
+     * Layers that are still empty get their R-trees bulk loaded, which is much faster than
+     * adding the items one by one (e.g. when a board is opened).
+     *
+     * @param aItems: items to be added. No ownership is given
+     */
+    virtual void Add( const std::vector<VIEW_ITEM*>& aItems );
+
     /**
      * Remove a #VIEW_ITEM from the view.
      *
@@ -141,6 +152,14 @@ public:
      */
     bool IsVisible( const VIEW_ITEM* aItem ) const;
 
+    /**
+     * Return true if the item has been added to another view and not removed from it since.
+     *
+     * An item can only be on one view at a time: adding it to this view would take it away
+     * from the other one.
+     */
+    bool IsOnOtherView( const VIEW_ITEM* aItem ) const;
+
     /**
      * For dynamic VIEWs, inform the associated VIEW that the graphical representation of
      * this item has changed. For static views calling has no effect.
@@ -575,6 +594,9 @@ public:
     {
         wxCHECK( aTarget < TARGETS_NUMBER, /* void */ );
         m_dirtyTargets[aTarget] = true;
+
+        if( aTarget == TARGET_NONCACHED )
+            m_fullDamage = true;
     }
 
     /// Return true if the layer is cached.
@@ -599,8 +621,23 @@ public:
     {
         for( int i = 0; i < TARGETS_NUMBER; ++i )
             m_dirtyTargets[i] = true;
+
+        m_fullDamage = true;
     }
 
+    /**
+     * Return true if the non-cached target only needs to be redrawn in the regions of the
+     * items updated since the last redraw.
+     *
+     * This is the case when the items were changed through Update(), Add() or Remove(), the
+     * GAL can clip (Cairo), no other target rendered to the same buffer needs a redraw and
+     * the damaged regions cover less than half of the screen.
+     * Redraw() then clears the damaged regions only and repaints them from every layer
+     * rendered to that buffer, grid included, and ClearTargets() leaves the non-cached target
+     * alone: callers must not clear the screen or draw the grid themselves.
+     */
+    bool HasPartialDamage() const;
+
     /**
      * Add an item to a list of items that are going to be refreshed upon the next frame rendering.
      *
@@ -663,6 +700,41 @@ public:
         m_reverseDrawOrder = aFlag;
     }
 
+    /**
+     * @return true if non-cached layers are drawn in parallel tiles when the GAL supports it.
+     */
+    bool IsTiledRendering() const
+    {
+        return m_tiledRendering;
+    }
+
+    /**
+     * Enable drawing the non-cached layers in screen tiles on several threads.
+     *
+     * Only takes effect with GALs implementing GAL::BeginTile() and painters implementing
+     * PAINTER::Clone(); the view falls back to drawing on a single thread otherwise.
+     */
+    void SetTiledRendering( bool aEnabled )
+    {
+        m_tiledRendering = aEnabled;
+    }
+
+    /**
+     * Enable collecting per layer and per item type draw statistics (see VIEW_PROFILE).
+     *
+     * Profiling adds a little time to every item drawn and draws the non-cached layers on
+     * a single thread, as the counters are not shared between threads.
+     */
+    void SetProfiling( bool aEnabled );
+
+    /**
+     * @return the draw statistics, or nullptr if profiling is disabled.
+     */
+    VIEW_PROFILE* GetProfile() const
+    {
+        return m_profile.get();
+    }
+
     std::shared_ptr<VIEW_OVERLAY> MakeOverlay();
 
     void InitPreview();
@@ -723,8 +795,20 @@ protected:
     {
         wxCHECK( aTarget < TARGETS_NUMBER, /* void */ );
         m_dirtyTargets[aTarget] = false;
+
+        if( aTarget == TARGET_NONCACHED )
+            m_damage.clear();
     }
 
+    /**
+     * Mark a target dirty because of changes within a world rectangle.  Only the non-cached
+     * target keeps track of the damaged regions, see HasPartialDamage().
+     */
+    void markTargetDamaged( int aTarget, const BOX2I& aRect );
+
+    ///< Clear and redraw the damaged regions of the non-cached target
+    void redrawDamage();
+
     /**
      * Draw an item, but on a specified layers.
      *
@@ -771,9 +855,30 @@ protected:
      */
     void invalidateItem( VIEW_ITEM* aItem, int aUpdateFlags );
 
+    ///< Draw the items of a layer within a rectangle on the view GAL
+    void redrawLayer( VIEW_LAYER* aLayer, const BOX2I& aRect );
+
+    /**
+     * Draw the dirty layers like redrawRect(), splitting the main target in tiles drawn
+     * concurrently.
+     *
+     * @return false if tiled drawing is not possible (nothing is drawn then).
+     */
+    bool redrawRectTiled( const BOX2I& aRect );
+
+    ///< Draw consecutive layers of the main target in parallel tiles
+    void redrawTiles( const std::vector<VIEW_LAYER*>& aLayers, const BOX2I& aRect,
+                      std::vector<std::unique_ptr<PAINTER>>& aPainters );
+
+    ///< Return true if the painter can draw every item of a layer within a rectangle
+    bool canPaintLayer( VIEW_LAYER* aLayer, const BOX2I& aRect ) const;
+
     ///< Update colors that are used for an item to be drawn
     void updateItemColor( VIEW_ITEM* aItem, int aLayer );
 
+    ///< Let the painter build the lazy geometry of items before tile workers draw them
+    void prepareItems( const std::vector<VIEW_ITEM*>& aItems );
+
     ///< Update all information needed to draw an item
     void updateItemGeometry( VIEW_ITEM* aItem, int aLayer );
 
@@ -853,6 +958,15 @@ protected:
     ///< Flag to mark targets as dirty so they have to be redrawn on the next refresh event.
     bool m_dirtyTargets[TARGETS_NUMBER];
 
+    ///< World regions of the non-cached target changed since the last redraw.
+    std::vector<BOX2I> m_damage;
+
+    ///< True if the whole non-cached target has to be redrawn regardless of m_damage.
+    bool m_fullDamage;
+
+    ///< Maximum number of damaged regions tracked before falling back to a full redraw.
+    static constexpr int MAX_DAMAGE_RECTS = 32;
+
     ///< Rendering order modifier for layers that are marked as top layers.
     static const int TOP_LAYER_MODIFIER;
 
@@ -865,6 +979,12 @@ protected:
     ///< Flag to reverse the draw order when using draw priority.
     bool m_reverseDrawOrder;
 
+    ///< Flag to draw non-cached layers in parallel tiles.
+    bool m_tiledRendering;
+
+    ///< Draw statistics, only allocated while profiling.
+    std::unique_ptr<VIEW_PROFILE> m_profile;
+
     ///< A control for printing: m_printMode <= 0 means no printing mode (normal draw mode
     ///< m_printMode > 0 is a printing mode (currently means "we are in printing mode").
     int m_printMode;
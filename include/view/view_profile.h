@@ -0,0 +1,154 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __VIEW_PROFILE_H
+#define __VIEW_PROFILE_H
+
+#include <view/view_item.h>
+
+#include <functional>
+#include <map>
+#include <vector>
+
+#include <wx/string.h>
+
+namespace KIGFX
+{
+
+/**
+ * Draw statistics of a VIEW, collected per layer and per item type.
+ *
+ * The VIEW adds to the counters while it tessellates and draws items (see
+ * VIEW::SetProfiling()).  Everything counted since the previous frame is attributed to the
+ * next frame that redraws the board targets.  What frames redrawing only the overlay count is
+ * discarded, so that displaying the statistics neither replaces nor inflates them.
+ */
+class VIEW_PROFILE
+{
+public:
+    struct COUNTERS
+    {
+        double m_drawTime = 0.0;            ///< time spent drawing, in ms
+        double m_tessellationTime = 0.0;    ///< time spent building cached groups, in ms
+        int    m_items = 0;                 ///< number of items drawn
+        int    m_tessellatedItems = 0;      ///< number of items whose group was rebuilt
+        int    m_cacheHits = 0;             ///< items drawn from an existing cached group
+        int    m_cacheMisses = 0;           ///< items of a cached layer without a group
+        size_t m_vertices = 0;              ///< vertices drawn or tessellated (see
+                                            ///< GAL::GetVertexCount())
+    };
+
+    VIEW_PROFILE() :
+            m_frameTime( 0.0 ),
+            m_prepareTime( 0.0 ),
+            m_frameCount( 0 )
+    {
+    }
+
+    ///< Counters of the frame in progress for a layer
+    COUNTERS& Layer( int aLayer ) { return m_current.m_layers[aLayer]; }
+
+    ///< Counters of the frame in progress for the type of an item
+    COUNTERS& ItemType( const VIEW_ITEM* aItem );
+
+    void AddPrepareTime( double aTime ) { m_current.m_prepareTime += aTime; }
+
+    /**
+     * Close the frame in progress and make its counters the ones reported.
+     *
+     * @param aFrameTime is the time taken by VIEW::Redraw(), in ms.
+     */
+    void EndFrame( double aFrameTime );
+
+    ///< Drop the counters of the frame in progress, keeping those of the last frame
+    void DiscardFrame() { m_current = FRAME(); }
+
+    ///< Drop all the counters, including those of the last frame
+    void Clear();
+
+    int GetFrameCount() const { return m_frameCount; }
+
+    double GetFrameTime() const { return m_frameTime; }
+
+    const std::map<int, COUNTERS>& GetLayers() const { return m_layers; }
+
+    const std::map<int, COUNTERS>& GetItemTypes() const { return m_itemTypes; }
+
+    /**
+     * Format the counters of the last frame as text, one line per layer and per item type,
+     * most expensive first.
+     *
+     * @param aLayerName returns the name of a layer; layers are numbered if not given.
+     * @param aMaxLines limits the number of layer and of item type lines (0 for all).
+     */
+    wxString Format( const std::function<wxString( int )>& aLayerName = nullptr,
+                     int aMaxLines = 0 ) const;
+
+private:
+    struct FRAME
+    {
+        double                  m_prepareTime = 0.0;
+        std::map<int, COUNTERS> m_layers;
+        std::map<int, COUNTERS> m_itemTypes;
+    };
+
+    FRAME                    m_current;
+
+    ///< Counters of the last complete frame
+    double                   m_frameTime;
+    double                   m_prepareTime;
+    int                      m_frameCount;
+    std::map<int, COUNTERS>  m_layers;
+    std::map<int, COUNTERS>  m_itemTypes;
+
+    ///< Class names of the item types seen so far
+    std::map<int, wxString>  m_typeNames;
+};
+
+
+/**
+ * Draws the statistics of a VIEW_PROFILE in the top left corner of the view.
+ */
+class VIEW_PROFILE_OVERLAY : public VIEW_ITEM
+{
+public:
+    VIEW_PROFILE_OVERLAY( const VIEW_PROFILE* aProfile,
+                          std::function<wxString( int )> aLayerName = nullptr ) :
+            m_profile( aProfile ),
+            m_layerName( aLayerName )
+    {
+    }
+
+    const BOX2I ViewBBox() const override;
+
+    void ViewDraw( int aLayer, VIEW* aView ) const override;
+
+    void ViewGetLayers( int aLayers[], int& aCount ) const override;
+
+private:
+    const VIEW_PROFILE*            m_profile;
+    std::function<wxString( int )> m_layerName;
+};
+
+} // namespace KIGFX
+
+#endif // __VIEW_PROFILE_H
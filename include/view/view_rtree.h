@@ -29,6 +29,9 @@
 
 #include <math/box2.h>
 
+#include <utility>
+#include <vector>
+
 #include <geometry/rtree.h>
 
 namespace KIGFX
@@ -48,29 +51,76 @@ public:
      */
     void Insert( VIEW_ITEM* aItem )
     {
-        const BOX2I&    bbox    = aItem->ViewBBox();
-        const int       mmin[2] = { bbox.GetX(), bbox.GetY() };
-        const int       mmax[2] = { bbox.GetRight(), bbox.GetBottom() };
+        Insert( aItem, aItem->ViewBBox() );
+    }
+
+    /**
+     * Insert an item into the tree using a known bounding box.
+     *
+     * The same box must be passed to Remove() later for a fast removal.
+     */
+    void Insert( VIEW_ITEM* aItem, const BOX2I& aBBox )
+    {
+        const int       mmin[2] = { aBBox.GetX(), aBBox.GetY() };
+        const int       mmax[2] = { aBBox.GetRight(), aBBox.GetBottom() };
 
         VIEW_RTREE_BASE::Insert( mmin, mmax, aItem );
     }
 
+    /**
+     * Insert many items at once.  An empty tree is bulk loaded, which is considerably faster
+     * than inserting the items one by one.
+     *
+     * @param aItems are the items with the bounding boxes they are indexed by.
+     */
+    void Insert( const std::vector<std::pair<VIEW_ITEM*, BOX2I>>& aItems )
+    {
+        std::vector<std::pair<Rect, VIEW_ITEM*>> entries;
+
+        entries.reserve( aItems.size() );
+
+        for( const std::pair<VIEW_ITEM*, BOX2I>& item : aItems )
+        {
+            const BOX2I& bbox = item.second;
+            Rect         rect = { { bbox.GetX(), bbox.GetY() },
+                                  { bbox.GetRight(), bbox.GetBottom() } };
+
+            entries.emplace_back( rect, item.first );
+        }
+
+        VIEW_RTREE_BASE::BulkLoad( entries );
+    }
+
     /**
      * Remove an item from the tree.
      *
      * Removal is done by comparing pointers, attempting to remove a copy of the item will fail.
+     * Without a bounding box this has to search the whole tree.
      */
     void Remove( VIEW_ITEM* aItem )
     {
-        // const BOX2I&    bbox    = aItem->ViewBBox();
-
-        // FIXME: use cached bbox or ptr_map to speed up pointer <-> node lookups.
         const int       mmin[2] = { INT_MIN, INT_MIN };
         const int       mmax[2] = { INT_MAX, INT_MAX };
 
         VIEW_RTREE_BASE::Remove( mmin, mmax, aItem );
     }
 
+    /**
+     * Remove an item that was inserted with bounding box \a aBBox.
+     *
+     * Only the branches covering the box are searched.  Falls back to a full search if the
+     * item is not found there.
+     */
+    void Remove( VIEW_ITEM* aItem, const BOX2I& aBBox )
+    {
+        const int       mmin[2] = { aBBox.GetX(), aBBox.GetY() };
+        const int       mmax[2] = { aBBox.GetRight(), aBBox.GetBottom() };
+
+        // RTree::Remove() returns true if the item was not found
+        if( VIEW_RTREE_BASE::Remove( mmin, mmax, aItem ) )
+            Remove( aItem );
+    }
+
     /**
      * Execute a function object \a aVisitor for each item whose bounding box intersects
      * with \a aBounds.
@@ -0,0 +1,351 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __PACKED_RTREE_H
+#define __PACKED_RTREE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <numeric>
+#include <vector>
+
+/**
+ * A static, packed 2D R-tree for indexes that are built once and then queried many times.
+ *
+ * Items are collected with Insert() and the tree is packed by Build(): the leaves are sorted
+ * along a Hilbert curve and every NODE_SIZE consecutive entries of a level are grouped into
+ * one node of the level above.  All the boxes of all the levels are stored in four contiguous
+ * coordinate arrays and the node structure is implicit in the array positions, so a query
+ * touches no pointers and the overlap test of a node's children is a branch-free loop the
+ * compiler can vectorize.
+ *
+ * Insert() and Search() follow the RTree interface so the class can replace an RTree whose
+ * contents do not change between queries.  The tree cannot be modified once built other
+ * than by RemoveAll().
+ */
+template <class DATATYPE, class ELEMTYPE = int, int NODE_SIZE = 16>
+class PACKED_RTREE
+{
+public:
+    PACKED_RTREE() :
+            m_built( false )
+    {
+    }
+
+    /**
+     * Add an item to the tree.  Must be called before Build().
+     */
+    void Insert( const ELEMTYPE aMin[2], const ELEMTYPE aMax[2], const DATATYPE& aData )
+    {
+        assert( !m_built );
+
+        m_minX.push_back( aMin[0] );
+        m_minY.push_back( aMin[1] );
+        m_maxX.push_back( aMax[0] );
+        m_maxY.push_back( aMax[1] );
+        m_data.push_back( aData );
+    }
+
+    /**
+     * Pack the inserted items.  Search() may only be called after this.
+     */
+    void Build()
+    {
+        assert( !m_built );
+
+        m_built = true;
+        m_levelBounds.clear();
+
+        const size_t count = m_data.size();
+
+        if( count == 0 )
+            return;
+
+        sortLeaves();
+
+        m_levelBounds.push_back( count );
+
+        // Always create at least one level above the leaves so that the search can start from
+        // a single root node.
+        size_t levelStart = 0;
+        size_t levelEnd = count;
+
+        do
+        {
+            for( size_t first = levelStart; first < levelEnd; first += NODE_SIZE )
+            {
+                const size_t last = std::min( first + NODE_SIZE, levelEnd );
+
+                ELEMTYPE minX = m_minX[first];
+                ELEMTYPE minY = m_minY[first];
+                ELEMTYPE maxX = m_maxX[first];
+                ELEMTYPE maxY = m_maxY[first];
+
+                for( size_t i = first + 1; i < last; i++ )
+                {
+                    minX = std::min( minX, m_minX[i] );
+                    minY = std::min( minY, m_minY[i] );
+                    maxX = std::max( maxX, m_maxX[i] );
+                    maxY = std::max( maxY, m_maxY[i] );
+                }
+
+                m_minX.push_back( minX );
+                m_minY.push_back( minY );
+                m_maxX.push_back( maxX );
+                m_maxY.push_back( maxY );
+            }
+
+            levelStart = levelEnd;
+            levelEnd = m_minX.size();
+            m_levelBounds.push_back( levelEnd );
+        } while( levelEnd - levelStart > 1 );
+    }
+
+    /**
+     * Remove all items.  The tree can be filled and built again afterwards.
+     */
+    void RemoveAll()
+    {
+        m_minX.clear();
+        m_minY.clear();
+        m_maxX.clear();
+        m_maxY.clear();
+        m_data.clear();
+        m_levelBounds.clear();
+        m_built = false;
+    }
+
+    size_t size() const
+    {
+        return m_data.size();
+    }
+
+    bool empty() const
+    {
+        return m_data.empty();
+    }
+
+    using const_iterator = typename std::vector<DATATYPE>::const_iterator;
+
+    ///< Iterate over all the items; once built, they are in the order of the leaves
+    const_iterator begin() const
+    {
+        return m_data.begin();
+    }
+
+    const_iterator end() const
+    {
+        return m_data.end();
+    }
+
+    /**
+     * Visit every item whose box overlaps the search rectangle.
+     *
+     * The visitor is called with the item's data and returns true to continue the search.
+     *
+     * @return the number of items visited with the visitor returning true.
+     */
+    template <class VISITOR>
+    int Search( const ELEMTYPE aMin[2], const ELEMTYPE aMax[2], VISITOR& aVisitor ) const
+    {
+        assert( m_built );
+
+        if( m_levelBounds.empty() )
+            return 0;
+
+        const ELEMTYPE qMinX = aMin[0];
+        const ELEMTYPE qMinY = aMin[1];
+        const ELEMTYPE qMaxX = aMax[0];
+        const ELEMTYPE qMaxY = aMax[1];
+
+        struct PENDING
+        {
+            size_t node;
+            int    level;
+        };
+
+        std::vector<PENDING> stack;
+        int                  found = 0;
+
+        stack.push_back( { m_minX.size() - 1, (int) m_levelBounds.size() - 1 } );
+
+        while( !stack.empty() )
+        {
+            const PENDING cur = stack.back();
+            stack.pop_back();
+
+            const size_t levelStart = m_levelBounds[cur.level - 1];
+            const size_t childLevelStart = cur.level >= 2 ? m_levelBounds[cur.level - 2] : 0;
+            const size_t first = childLevelStart + ( cur.node - levelStart ) * NODE_SIZE;
+            const size_t last = std::min( first + NODE_SIZE, levelStart );
+            const int    n = (int) ( last - first );
+
+            const ELEMTYPE* minX = &m_minX[first];
+            const ELEMTYPE* minY = &m_minY[first];
+            const ELEMTYPE* maxX = &m_maxX[first];
+            const ELEMTYPE* maxY = &m_maxY[first];
+
+            // Test all the children at once; keep this loop free of branches so it vectorizes.
+            uint8_t hit[NODE_SIZE];
+
+            for( int i = 0; i < n; i++ )
+            {
+                hit[i] = ( minX[i] <= qMaxX ) & ( maxX[i] >= qMinX ) & ( minY[i] <= qMaxY )
+                         & ( maxY[i] >= qMinY );
+            }
+
+            if( cur.level == 1 )
+            {
+                for( int i = 0; i < n; i++ )
+                {
+                    if( !hit[i] )
+                        continue;
+
+                    if( !aVisitor( m_data[first + i] ) )
+                        return found;
+
+                    found++;
+                }
+            }
+            else
+            {
+                // Push in reverse so children are visited in storage order
+                for( int i = n - 1; i >= 0; i-- )
+                {
+                    if( hit[i] )
+                        stack.push_back( { first + i, cur.level - 1 } );
+                }
+            }
+        }
+
+        return found;
+    }
+
+private:
+    /**
+     * Map a point of a 65536 x 65536 grid to its position along a Hilbert curve.
+     */
+    static uint32_t hilbertIndex( uint32_t aX, uint32_t aY )
+    {
+        uint32_t d = 0;
+
+        for( uint32_t s = 1 << 15; s > 0; s >>= 1 )
+        {
+            uint32_t rx = ( aX & s ) > 0;
+            uint32_t ry = ( aY & s ) > 0;
+
+            d += s * s * ( ( 3 * rx ) ^ ry );
+
+            if( ry == 0 )
+            {
+                if( rx == 1 )
+                {
+                    aX = s - 1 - aX;
+                    aY = s - 1 - aY;
+                }
+
+                std::swap( aX, aY );
+            }
+        }
+
+        return d;
+    }
+
+    /**
+     * Reorder the leaf entries along a Hilbert curve through their centres, so that entries
+     * grouped into one node are close to each other.
+     */
+    void sortLeaves()
+    {
+        const size_t count = m_data.size();
+
+        double minX = m_minX[0], minY = m_minY[0];
+        double maxX = m_maxX[0], maxY = m_maxY[0];
+
+        for( size_t i = 1; i < count; i++ )
+        {
+            minX = std::min<double>( minX, m_minX[i] );
+            minY = std::min<double>( minY, m_minY[i] );
+            maxX = std::max<double>( maxX, m_maxX[i] );
+            maxY = std::max<double>( maxY, m_maxY[i] );
+        }
+
+        const double scaleX = maxX > minX ? 65535.0 / ( maxX - minX ) : 0.0;
+        const double scaleY = maxY > minY ? 65535.0 / ( maxY - minY ) : 0.0;
+
+        std::vector<uint32_t> keys( count );
+
+        for( size_t i = 0; i < count; i++ )
+        {
+            double cx = ( (double) m_minX[i] + m_maxX[i] ) / 2.0;
+            double cy = ( (double) m_minY[i] + m_maxY[i] ) / 2.0;
+
+            keys[i] = hilbertIndex( (uint32_t) ( ( cx - minX ) * scaleX ),
+                                    (uint32_t) ( ( cy - minY ) * scaleY ) );
+        }
+
+        std::vector<size_t> order( count );
+        std::iota( order.begin(), order.end(), 0 );
+
+        std::sort( order.begin(), order.end(),
+                   [&]( size_t a, size_t b )
+                   {
+                       return keys[a] < keys[b];
+                   } );
+
+        applyOrder( m_minX, order );
+        applyOrder( m_minY, order );
+        applyOrder( m_maxX, order );
+        applyOrder( m_maxY, order );
+        applyOrder( m_data, order );
+    }
+
+    template <typename T>
+    static void applyOrder( std::vector<T>& aVec, const std::vector<size_t>& aOrder )
+    {
+        std::vector<T> sorted;
+        sorted.reserve( aVec.size() );
+
+        for( size_t idx : aOrder )
+            sorted.push_back( aVec[idx] );
+
+        aVec.swap( sorted );
+    }
+
+    ///< Boxes of the leaves followed by the nodes of each level up to the root
+    std::vector<ELEMTYPE> m_minX;
+    std::vector<ELEMTYPE> m_minY;
+    std::vector<ELEMTYPE> m_maxX;
+    std::vector<ELEMTYPE> m_maxY;
+
+    ///< Leaf data, in the same order as the leaf boxes
+    std::vector<DATATYPE> m_data;
+
+    ///< End (exclusive) of each level in the box arrays, leaves first
+    std::vector<size_t>   m_levelBounds;
+
+    bool                  m_built;
+};
+
+#endif // __PACKED_RTREE_H
@@ -0,0 +1,59 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __POINT_BATCH_H
+#define __POINT_BATCH_H
+
+#include <cstddef>
+
+#include <math/vector2d.h>
+
+/**
+ * Transforms applied to a contiguous array of points at once.
+ *
+ * The per-transform work (sine and cosine of the angle, the choice of the mirrored axes) is
+ * done once for the whole array and the per-point loops are kept free of branches so that
+ * the compiler can vectorize them.  The results are the same as transforming each point
+ * with the corresponding VECTOR2I operation.
+ */
+
+/**
+ * Translate \a aCount points by \a aVector.
+ */
+void MovePoints( VECTOR2I* aPoints, size_t aCount, const VECTOR2I& aVector );
+
+/**
+ * Mirror \a aCount points about the vertical (\a aX) and/or horizontal (\a aY) line through
+ * \a aRef.
+ */
+void MirrorPoints( VECTOR2I* aPoints, size_t aCount, bool aX, bool aY, const VECTOR2I& aRef );
+
+/**
+ * Rotate \a aCount points by \a aAngle radians around \a aCenter.
+ *
+ * Rotations by a multiple of 90 degrees are exact; other angles are rounded to the nearest
+ * integer coordinates as VECTOR2I::Rotate() does.
+ */
+void RotatePoints( VECTOR2I* aPoints, size_t aCount, double aAngle, const VECTOR2I& aCenter );
+
+#endif // __POINT_BATCH_H
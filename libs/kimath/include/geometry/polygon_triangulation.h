@@ -49,6 +49,9 @@
 #include <algorithm>
 #include <deque>
 #include <cmath>
+#include <memory>
+#include <type_traits>
+#include <vector>
 
 #include <clipper.hpp>
 #include <geometry/shape_line_chain.h>
@@ -59,14 +62,22 @@
 class PolygonTriangulation
 {
 public:
-    PolygonTriangulation( SHAPE_POLY_SET::TRIANGULATED_POLYGON& aResult ) :
-        m_result( aResult )
-    {};
+    class VertexArena;
+
+    /**
+     * @param aResult receives the triangles.
+     * @param aArena is the storage for the working vertices.  Threads triangulating many
+     *               polygons in turn pass the same arena to each triangulation so that its
+     *               memory is reused; if null the triangulation uses an arena of its own.
+     */
+    PolygonTriangulation( SHAPE_POLY_SET::TRIANGULATED_POLYGON& aResult,
+                          VertexArena* aArena = nullptr );
 
     bool TesselatePolygon( const SHAPE_LINE_CHAIN& aPoly )
     {
         m_bbox = aPoly.BBox();
         m_result.Clear();
+        m_vertices.Clear();
 
         if( !m_bbox.GetWidth() || !m_bbox.GetHeight() )
             return false;
@@ -81,7 +92,7 @@ public:
         firstVertex->updateList();
 
         auto retval = earcutList( firstVertex );
-        m_vertices.clear();
+        m_vertices.Clear();
         return retval;
     }
 
@@ -118,10 +129,8 @@ private:
          */
         Vertex* split( Vertex* b )
         {
-            parent->m_vertices.emplace_back( i, x, y, parent );
-            Vertex* a2 = &parent->m_vertices.back();
-            parent->m_vertices.emplace_back( b->i, b->x, b->y, parent );
-            Vertex* b2 = &parent->m_vertices.back();
+            Vertex* a2 = parent->m_vertices.Create( i, x, y, parent );
+            Vertex* b2 = parent->m_vertices.Create( b->i, b->x, b->y, parent );
             Vertex* an = next;
             Vertex* bp = b->prev;
 
@@ -254,6 +263,54 @@ private:
         Vertex* nextZ = nullptr;
     };
 
+public:
+    /**
+     * Block storage for the vertices of the linked lists.
+     *
+     * Vertices are never freed one by one: Clear() drops them all at once and keeps the blocks
+     * for the next polygon, so a thread triangulating many polygons allocates only while its
+     * largest polygon grows the arena.  Vertex addresses are stable, as the lists require.
+     */
+    class VertexArena
+    {
+    public:
+        VertexArena() :
+                m_count( 0 )
+        {
+        }
+
+        Vertex* Create( size_t aIndex, double aX, double aY, PolygonTriangulation* aParent )
+        {
+            const size_t block = m_count / BLOCK_SIZE;
+
+            if( block == m_blocks.size() )
+                m_blocks.emplace_back( new STORAGE[BLOCK_SIZE] );
+
+            void* slot = &m_blocks[block][m_count % BLOCK_SIZE];
+            m_count++;
+
+            return new( slot ) Vertex( aIndex, aX, aY, aParent );
+        }
+
+        void Clear()
+        {
+            m_count = 0;
+        }
+
+    private:
+        static_assert( std::is_trivially_destructible<Vertex>::value,
+                       "vertices are dropped without being destroyed" );
+
+        static constexpr size_t BLOCK_SIZE = 1024;
+
+        typedef std::aligned_storage<sizeof( Vertex ), alignof( Vertex )>::type STORAGE;
+
+        std::vector<std::unique_ptr<STORAGE[]>> m_blocks;
+        size_t                                  m_count;
+    };
+
+private:
+
     /**
      * Calculate the Morton code of the Vertex
      * http://www.graphics.stanford.edu/~seander/bithacks.html#InterleaveBMN
@@ -653,9 +710,8 @@ private:
     Vertex* insertVertex( const VECTOR2I& pt, Vertex* last )
     {
         m_result.AddVertex( pt );
-        m_vertices.emplace_back( m_result.GetVertexCount() - 1, pt.x, pt.y, this );
 
-        Vertex* p = &m_vertices.back();
+        Vertex* p = m_vertices.Create( m_result.GetVertexCount() - 1, pt.x, pt.y, this );
         if( !last )
         {
             p->prev = p;
@@ -673,8 +729,18 @@ private:
 
 private:
     BOX2I                                 m_bbox;
-    std::deque<Vertex>                    m_vertices;
+    std::unique_ptr<VertexArena>          m_ownArena;
+    VertexArena&                          m_vertices;
     SHAPE_POLY_SET::TRIANGULATED_POLYGON& m_result;
 };
 
+
+inline PolygonTriangulation::PolygonTriangulation( SHAPE_POLY_SET::TRIANGULATED_POLYGON& aResult,
+                                                   VertexArena* aArena ) :
+        m_ownArena( aArena ? nullptr : new VertexArena ),
+        m_vertices( aArena ? *aArena : *m_ownArena ),
+        m_result( aResult )
+{
+}
+
 #endif //__POLYGON_TRIANGULATION_H
@@ -0,0 +1,128 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef __SEG_BATCH_H
+#define __SEG_BATCH_H
+
+#include <geometry/seg.h>
+#include <math/box2.h>
+
+/**
+ * A fixed-size block of segments used to test one shape against many segments at a time.
+ *
+ * The segment end points are kept as separate coordinate arrays of doubles, so that a lower
+ * bound of the distance from the query to every segment of the block is computed at once:
+ * with SSE2 (two segments per instruction) when the target has it, and with the same math in
+ * plain scalar code otherwise.  Callers use the lower bounds to skip the exact (and much more
+ * expensive) SEG distance computation for segments that cannot be closer than the best
+ * candidate found so far, or cannot be within the clearance.
+ *
+ * The bounds are conservative: "bound >= threshold" proves that the exact squared distance
+ * returned by SEG (which rounds the nearest point to the integer grid) is at least threshold,
+ * for any ecoord threshold converted to double.
+ */
+class SEG_BATCH
+{
+public:
+    static constexpr int BLOCK_SIZE = 16;
+
+    SEG_BATCH() :
+            m_ax(),
+            m_ay(),
+            m_bx(),
+            m_by(),
+            m_lowerBounds(),
+            m_count( 0 )
+    {
+    }
+
+    void Clear()
+    {
+        m_count = 0;
+    }
+
+    int Size() const
+    {
+        return m_count;
+    }
+
+    bool Full() const
+    {
+        return m_count == BLOCK_SIZE;
+    }
+
+    /**
+     * Append a segment to the block.  The block must not be full.
+     */
+    void Add( const SEG& aSeg )
+    {
+        m_segs[m_count] = aSeg;
+        m_ax[m_count] = aSeg.A.x;
+        m_ay[m_count] = aSeg.A.y;
+        m_bx[m_count] = aSeg.B.x;
+        m_by[m_count] = aSeg.B.y;
+        m_count++;
+    }
+
+    const SEG& Get( int aIdx ) const
+    {
+        return m_segs[aIdx];
+    }
+
+    /**
+     * Compute, for every segment in the block, a lower bound of its squared distance to
+     * \a aSeg.
+     *
+     * @return Size() lower bounds, valid until the block is modified.
+     */
+    const double* DistanceLowerBounds( const SEG& aSeg );
+
+    const double* DistanceLowerBounds( const VECTOR2I& aP )
+    {
+        return DistanceLowerBounds( SEG( aP, aP ) );
+    }
+
+    /**
+     * Compute, for every segment in the block, a lower bound of the squared distance between
+     * the segment and any point inside \a aBox (the squared distance between their bounding
+     * boxes).  Much weaker than DistanceLowerBounds(), but valid for a query of any shape.
+     *
+     * @param aBox is the bounding box of the query shape (must be normalized).
+     * @return Size() lower bounds, valid until the block is modified.
+     */
+    const double* BoxDistanceLowerBounds( const BOX2I& aBox );
+
+private:
+    SEG m_segs[BLOCK_SIZE];
+
+    // Unused lanes hold zeros, so that the kernels always run over the whole block
+    alignas( 16 ) double m_ax[BLOCK_SIZE];
+    alignas( 16 ) double m_ay[BLOCK_SIZE];
+    alignas( 16 ) double m_bx[BLOCK_SIZE];
+    alignas( 16 ) double m_by[BLOCK_SIZE];
+    alignas( 16 ) double m_lowerBounds[BLOCK_SIZE];
+
+    int m_count;
+};
+
+#endif // __SEG_BATCH_H
@@ -104,6 +104,26 @@ public:
     bool Collide( const VECTOR2I& aP, int aClearance = 0, int* aActual = nullptr,
                   VECTOR2I* aLocation = nullptr ) const override;
 
+    /**
+     * @return the point of the arc (ignoring its width) nearest to \a aP.
+     */
+    VECTOR2I NearestPoint( const VECTOR2I& aP ) const;
+
+    /**
+     * Compute the exact squared distance between the arc and a segment, ignoring the width
+     * of the arc.
+     *
+     * @param aNearest receives the point of the arc nearest to the segment.
+     */
+    ecoord SquaredDistance( const SEG& aSeg, VECTOR2I* aNearest = nullptr ) const;
+
+    /**
+     * Compute the exact squared distance between two arcs, ignoring their widths.
+     *
+     * @param aNearest receives the point of this arc nearest to \a aArc.
+     */
+    ecoord SquaredDistance( const SHAPE_ARC& aArc, VECTOR2I* aNearest = nullptr ) const;
+
     void SetWidth( int aWidth )
     {
         m_width = aWidth;
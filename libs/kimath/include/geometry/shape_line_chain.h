@@ -27,7 +27,12 @@
 #define __SHAPE_LINE_CHAIN
 
 
+#include <utility>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
 #include <clipper.hpp>
+#include <geometry/point_batch.h>
 #include <geometry/seg.h>
 #include <geometry/shape.h>
 #include <geometry/shape_arc.h>
@@ -45,9 +50,17 @@
  */
 class SHAPE_LINE_CHAIN : public SHAPE_LINE_CHAIN_BASE
 {
+public:
+    /**
+     * Storage for the vertices and their shape indices.  Chains of up to 8 points (segments,
+     * rectangles, most router lines) keep them inline and do not allocate at all.
+     */
+    typedef boost::container::small_vector<VECTOR2I, 8> POINT_VECTOR;
+    typedef boost::container::small_vector<ssize_t, 8>  SHAPE_VECTOR;
+
 private:
-    typedef std::vector<VECTOR2I>::iterator point_iter;
-    typedef std::vector<VECTOR2I>::const_iterator point_citer;
+    typedef POINT_VECTOR::iterator point_iter;
+    typedef POINT_VECTOR::const_iterator point_citer;
 
 public:
     /**
@@ -116,6 +129,22 @@ public:
               m_bbox( aShape.m_bbox )
     {}
 
+    /**
+     * Move Constructor
+     *
+     * Takes over the storage of \a aShape, so that chains returned by value or stored in
+     * containers are not copied point by point.
+     */
+    SHAPE_LINE_CHAIN( SHAPE_LINE_CHAIN&& aShape ) noexcept
+            : SHAPE_LINE_CHAIN_BASE( SH_LINE_CHAIN ),
+              m_points( std::move( aShape.m_points ) ),
+              m_shapes( std::move( aShape.m_shapes ) ),
+              m_arcs( std::move( aShape.m_arcs ) ),
+              m_closed( aShape.m_closed ),
+              m_width( aShape.m_width ),
+              m_bbox( aShape.m_bbox )
+    {}
+
     SHAPE_LINE_CHAIN( const std::vector<int>& aV);
 
     SHAPE_LINE_CHAIN( const std::vector<wxPoint>& aV, bool aClosed = false )
@@ -126,14 +155,14 @@ public:
         for( auto pt : aV )
             m_points.emplace_back( pt.x, pt.y );
 
-        m_shapes = std::vector<ssize_t>( aV.size(), ssize_t( SHAPE_IS_PT ) );
+        m_shapes.assign( aV.size(), ssize_t( SHAPE_IS_PT ) );
     }
 
     SHAPE_LINE_CHAIN( const std::vector<VECTOR2I>& aV, bool aClosed = false )
             : SHAPE_LINE_CHAIN_BASE( SH_LINE_CHAIN ), m_closed( aClosed ), m_width( 0 )
     {
-        m_points = aV;
-        m_shapes = std::vector<ssize_t>( aV.size(), ssize_t( SHAPE_IS_PT ) );
+        m_points.assign( aV.begin(), aV.end() );
+        m_shapes.assign( aV.size(), ssize_t( SHAPE_IS_PT ) );
     }
 
     SHAPE_LINE_CHAIN( const SHAPE_ARC& aArc, bool aClosed = false )
@@ -143,7 +172,7 @@ public:
     {
         m_points = aArc.ConvertToPolyline().CPoints();
         m_arcs.emplace_back( aArc );
-        m_shapes = std::vector<ssize_t>( m_points.size(), 0 );
+        m_shapes.assign( m_points.size(), 0 );
     }
 
     SHAPE_LINE_CHAIN( const ClipperLib::Path& aPath ) :
@@ -152,7 +181,7 @@ public:
         m_width( 0 )
     {
         m_points.reserve( aPath.size() );
-        m_shapes = std::vector<ssize_t>( aPath.size(), ssize_t( SHAPE_IS_PT ) );
+        m_shapes.assign( aPath.size(), ssize_t( SHAPE_IS_PT ) );
 
         for( const auto& point : aPath )
             m_points.emplace_back( point.X, point.Y );
@@ -162,6 +191,7 @@ public:
     {}
 
     SHAPE_LINE_CHAIN& operator=(const SHAPE_LINE_CHAIN&) = default;
+    SHAPE_LINE_CHAIN& operator=( SHAPE_LINE_CHAIN&& ) = default;
 
     SHAPE* Clone() const override;
 
@@ -177,6 +207,16 @@ public:
         m_closed = false;
     }
 
+    /**
+     * Allocate room for \a aPointCount points, so that appending them one by one does not
+     * reallocate the storage.
+     */
+    void Reserve( size_t aPointCount )
+    {
+        m_points.reserve( aPointCount );
+        m_shapes.reserve( aPointCount );
+    }
+
     /**
      * Function SetClosed()
      *
@@ -339,7 +379,7 @@ public:
         return m_points[aIndex];
     }
 
-    const std::vector<VECTOR2I>& CPoints() const
+    const POINT_VECTOR& CPoints() const
     {
         return m_points;
     }
@@ -363,7 +403,7 @@ public:
     /**
      * @return the vector of values indicating shape type and location
      */
-    const std::vector<ssize_t>& CShapes() const
+    const SHAPE_VECTOR& CShapes() const
     {
         return m_shapes;
     }
@@ -631,6 +671,18 @@ public:
      */
     SHAPE_LINE_CHAIN& Simplify( bool aRemoveColinear = true );
 
+    /**
+     * Return a copy of the line chain with the vertices removed that can be dropped without
+     * moving the chain by more than \a aMaxError (Ramer-Douglas-Peucker).
+     *
+     * Used to build lower resolution versions of large outlines, e.g. for display at low zoom.
+     * Arcs are kept as plain segments.  The result may self-intersect within \a aMaxError.
+     *
+     * @param aMaxError is the maximum distance between the original and the simplified chain.
+     * @return the simplified chain.
+     */
+    SHAPE_LINE_CHAIN Decimated( int aMaxError ) const;
+
     /**
      * Converts an arc to only a point chain by removing the arc and references
      *
@@ -693,8 +745,7 @@ public:
 
     void Move( const VECTOR2I& aVector ) override
     {
-        for( auto& pt : m_points )
-            pt += aVector;
+        MovePoints( m_points.data(), m_points.size(), aVector );
 
         for( auto& arc : m_arcs )
             arc.Move( aVector );
@@ -765,14 +816,14 @@ private:
     constexpr static ssize_t SHAPE_IS_PT = -1;
 
     /// array of vertices
-    std::vector<VECTOR2I> m_points;
+    POINT_VECTOR m_points;
 
     /**
      * Array of indices that refer to the index of the shape if the point is part of a larger
      * shape, e.g. arc or spline.
      * If the value is -1, the point is just a point.
      */
-    std::vector<ssize_t> m_shapes;
+    SHAPE_VECTOR m_shapes;
 
     std::vector<SHAPE_ARC> m_arcs;
 
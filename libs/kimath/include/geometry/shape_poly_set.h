@@ -291,7 +291,7 @@ public:
 
         const T& Get()
         {
-            return m_poly->Polygon( m_currentPolygon )[m_currentContour].CPoint( m_currentVertex );
+            return m_poly->CPolygon( m_currentPolygon )[m_currentContour].CPoint( m_currentVertex );
         }
 
         const T& operator*()
@@ -407,7 +407,9 @@ public:
 
         T Get()
         {
-            return m_poly->Polygon( m_currentPolygon )[m_currentContour].Segment( m_currentSegment );
+            const SHAPE_LINE_CHAIN& contour = m_poly->CPolygon( m_currentPolygon )[m_currentContour];
+
+            return contour.CSegment( m_currentSegment );
         }
 
         T operator*()
@@ -497,7 +499,15 @@ public:
 
     SHAPE_POLY_SET& operator=( const SHAPE_POLY_SET& );
 
-    void CacheTriangulation( bool aPartition = true );
+    /**
+     * Triangulate the polygons of the set, unless the triangulation is up to date.
+     *
+     * Large sets are triangulated by several threads, one polygon (or grid cell) at a time.
+     *
+     * @param aPartition splits the polygons into a regular grid of cells before triangulating.
+     * @param aMaxThreads limits the number of threads (0 for one per core).
+     */
+    void CacheTriangulation( bool aPartition = true, size_t aMaxThreads = 0 );
     bool IsTriangulationUpToDate() const;
 
     MD5_HASH GetHash() const;
@@ -640,6 +650,7 @@ public:
     ///< Return the reference to aIndex-th outline in the set
     SHAPE_LINE_CHAIN& Outline( int aIndex )
     {
+        invalidateEdgeIndex();
         return m_polys[aIndex][0];
     }
 
@@ -667,12 +678,14 @@ public:
     ///< Return the reference to aHole-th hole in the aIndex-th outline
     SHAPE_LINE_CHAIN& Hole( int aOutline, int aHole )
     {
+        invalidateEdgeIndex();
         return m_polys[aOutline][aHole + 1];
     }
 
     ///< Return the aIndex-th subpolygon in the set
     POLYGON& Polygon( int aIndex )
     {
+        invalidateEdgeIndex();
         return m_polys[aIndex];
     }
 
@@ -933,6 +946,43 @@ public:
     void BooleanIntersection( const SHAPE_POLY_SET& a, const SHAPE_POLY_SET& b,
                               POLYGON_MODE aFastMode );
 
+    /**
+     * Collects many shapes and merges them with a single conversion to and from Clipper.
+     *
+     * Calling BooleanAdd() in a loop converts the whole accumulated result to Clipper paths
+     * and back for every shape added.  A UNION_BATCH converts each shape once when it is added
+     * and builds the SHAPE_POLY_SET only for the final result.  Large batches are split into
+     * chunks merged by several threads, and the partial results are then merged pairwise.
+     */
+    class UNION_BATCH
+    {
+    public:
+        ///< Add all the polygons of \a aSet
+        void Add( const SHAPE_POLY_SET& aSet );
+
+        ///< Add a closed outline without holes
+        void Add( const SHAPE_LINE_CHAIN& aOutline );
+
+        bool Empty() const { return m_polys.empty(); }
+
+        void Clear() { m_polys.clear(); }
+
+        /**
+         * Merge all the shapes added and store the union in \a aResult.  The batch is empty
+         * afterwards.
+         *
+         * \a aResult may also have been added to the batch.
+         *
+         * @param aFastMode see SHAPE_POLY_SET::booleanOp().
+         * @param aMaxThreads limits the number of threads (0 for one per core).
+         */
+        void Execute( SHAPE_POLY_SET& aResult, POLYGON_MODE aFastMode, size_t aMaxThreads = 0 );
+
+    private:
+        ///< Clipper paths of each polygon added, outline first
+        std::vector<ClipperLib::Paths> m_polys;
+    };
+
     enum CORNER_STRATEGY        ///< define how inflate transform build inflated polygon
     {
         ALLOW_ACUTE_CORNERS,    ///< just inflate the polygon. Acute angles create spikes
@@ -958,14 +1008,17 @@ public:
      *                        #CHOP_ACUTE_CORNERS to chop angles less than 90°,
      *                        #ROUND_ACUTE_CORNERS to round off angles less than 90°,
      *                        #ROUND_ALL_CORNERS to round regardless of angles
+     * @param aMaxThreads limits the number of threads used for large sets (0 for one per core).
+     *                    Large sets are split into runs of polygons and, when inflating, very
+     *                    large polygons into tiles, which are offset concurrently and merged.
      */
     void Inflate( int aAmount, int aCircleSegmentsCount,
-                  CORNER_STRATEGY aCornerStrategy = ROUND_ALL_CORNERS );
+                  CORNER_STRATEGY aCornerStrategy = ROUND_ALL_CORNERS, size_t aMaxThreads = 1 );
 
     void Deflate( int aAmount, int aCircleSegmentsCount,
-                  CORNER_STRATEGY aCornerStrategy = ROUND_ALL_CORNERS )
+                  CORNER_STRATEGY aCornerStrategy = ROUND_ALL_CORNERS, size_t aMaxThreads = 1 )
     {
-        Inflate( -aAmount, aCircleSegmentsCount, aCornerStrategy );
+        Inflate( -aAmount, aCircleSegmentsCount, aCornerStrategy, aMaxThreads );
     }
 
     /**
@@ -997,6 +1050,16 @@ public:
     ///< For \a aFastMode meaning, see function booleanOp
     void Simplify( POLYGON_MODE aFastMode );
 
+    /**
+     * Return a lower resolution copy of the set, for display at a scale where details smaller
+     * than \a aMaxError are not visible.
+     *
+     * Each contour is decimated with SHAPE_LINE_CHAIN::Decimated() and contours whose bounding
+     * box fits in \a aMaxError are dropped.  Unlike Simplify(), this does not clean up the
+     * result: it may have small self-intersections and is not meant for further processing.
+     */
+    SHAPE_POLY_SET Decimated( int aMaxError ) const;
+
     /**
      * Convert a self-intersecting polygon to one (or more) non self-intersecting polygon(s).
      *
@@ -1142,6 +1205,19 @@ public:
 
     const BOX2I BBoxFromCaches() const;
 
+    /**
+     * Build a spatial index of the edges of the polygons, used by Contains(), Collide() and
+     * SquaredDistance() in place of a linear scan of the edges.  Worth it before many queries
+     * of a set with many vertices; smaller sets are not indexed.
+     *
+     * @note The index is dropped by every editing method and by the non-const contour
+     *       accessors (Outline(), Hole(), Polygon()), and is shared by copies of the set.  It
+     *       is **not** kept up-to-date by edits made through contour references obtained
+     *       before it was built, so such references must not be used to edit the set while
+     *       it is indexed.
+     */
+    void BuildEdgeIndex();
+
     /**
      * Return true if a given subpolygon contains the point \a aP.
      *
@@ -1317,6 +1393,12 @@ public:
     bool IsVertexInHole( int aGlobalIdx );
 
 private:
+    /**
+     * Spatial index of the edges of the polygons, used by Contains(), Collide() and
+     * SquaredDistance() on sets with many vertices.
+     */
+    struct EDGE_INDEX;
+
     void fractureSingle( POLYGON& paths );
     void unfractureSingle ( POLYGON& path );
     void importTree( ClipperLib::PolyTree* tree );
@@ -1354,7 +1436,28 @@ private:
      * @return true if \a aP is inside aSubpolyIndex-th polygon; false in any other case.
      */
     bool containsSingle( const VECTOR2I& aP, int aSubpolyIndex, int aAccuracy,
-                         bool aUseBBoxCaches = false ) const;
+                         bool aUseBBoxCaches = false,
+                         const EDGE_INDEX* aEdgeIndex = nullptr ) const;
+
+    SEG::ecoord squaredDistanceToPolygon( const VECTOR2I& aPoint, int aIndex, VECTOR2I* aNearest,
+                                          const EDGE_INDEX* aEdgeIndex ) const;
+
+    SEG::ecoord squaredDistanceToPolygon( const SEG& aSegment, int aIndex, VECTOR2I* aNearest,
+                                          const EDGE_INDEX* aEdgeIndex ) const;
+
+    /**
+     * Return the edge index built by BuildEdgeIndex().
+     *
+     * @return the index, or nullptr if the queries should use a linear scan of the edges.
+     */
+    const EDGE_INDEX* edgeIndex() const;
+
+    ///< Drop the edge index.  Must be called by every method that can modify the contours.
+    void invalidateEdgeIndex()
+    {
+        if( m_edgeIndex )
+            m_edgeIndex.reset();
+    }
 
     /**
      * Operation ChamferPolygon and FilletPolygon are computed under the private chamferFillet
@@ -1397,6 +1500,9 @@ private:
 
     bool     m_triangulationValid = false;
     MD5_HASH m_hash;
+
+    ///< Edge index built by BuildEdgeIndex(), shared between copies until one is modified
+    std::shared_ptr<const EDGE_INDEX> m_edgeIndex;
 };
 
 #endif
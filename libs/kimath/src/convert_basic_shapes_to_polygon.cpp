@@ -49,6 +49,8 @@ void TransformCircleToPolygon( SHAPE_LINE_CHAIN& aCornerBuffer, wxPoint aCenter,
     if( aErrorLoc == ERROR_OUTSIDE )
         radius += GetCircleToPolyCorrection( aError );
 
+    aCornerBuffer.Reserve( aCornerBuffer.PointCount() + ( 3599 / delta ) + 1 );
+
     for( int angle = 0; angle < 3600; angle += delta )
     {
         corner_position.x   = radius;
@@ -73,7 +75,9 @@ void TransformCircleToPolygon( SHAPE_POLY_SET& aCornerBuffer, wxPoint aCenter, i
     if( aErrorLoc == ERROR_OUTSIDE )
         radius += GetCircleToPolyCorrection( aError );
 
-    aCornerBuffer.NewOutline();
+    int outline = aCornerBuffer.NewOutline();
+
+    aCornerBuffer.Outline( outline ).Reserve( ( 3599 / delta ) + 2 );
 
     for( int angle = 0; angle < 3600; angle += delta )
     {
@@ -115,6 +119,7 @@ void TransformOvalToPolygon( SHAPE_POLY_SET& aCornerBuffer, wxPoint aStart, wxPo
     SHAPE_POLY_SET polyshape;
 
     polyshape.NewOutline();
+    polyshape.Outline( 0 ).Reserve( 2 * ( ( 1799 / delta ) + 2 ) );
 
     // normalize the position in order to have endp.x >= 0
     // it makes calculations more easy to understand
@@ -0,0 +1,183 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <geometry/point_batch.h>
+#include <math/util.h>
+
+
+void MovePoints( VECTOR2I* aPoints, size_t aCount, const VECTOR2I& aVector )
+{
+    const int dx = aVector.x;
+    const int dy = aVector.y;
+
+    for( size_t i = 0; i < aCount; i++ )
+    {
+        aPoints[i].x += dx;
+        aPoints[i].y += dy;
+    }
+}
+
+
+void MirrorPoints( VECTOR2I* aPoints, size_t aCount, bool aX, bool aY, const VECTOR2I& aRef )
+{
+    if( aX )
+    {
+        const int twiceRef = 2 * aRef.x;
+
+        for( size_t i = 0; i < aCount; i++ )
+            aPoints[i].x = -aPoints[i].x + twiceRef;
+    }
+
+    if( aY )
+    {
+        const int twiceRef = 2 * aRef.y;
+
+        for( size_t i = 0; i < aCount; i++ )
+            aPoints[i].y = -aPoints[i].y + twiceRef;
+    }
+}
+
+
+/**
+ * Rotate by a number of quarter turns, without rounding.
+ */
+static void rotateQuarters( VECTOR2I* aPoints, size_t aCount, int aQuarters,
+                            const VECTOR2I& aCenter )
+{
+    const int cx = aCenter.x;
+    const int cy = aCenter.y;
+
+    switch( aQuarters )
+    {
+    case 1:
+        for( size_t i = 0; i < aCount; i++ )
+        {
+            int dx = aPoints[i].x - cx;
+            int dy = aPoints[i].y - cy;
+
+            aPoints[i].x = -dy + cx;
+            aPoints[i].y = dx + cy;
+        }
+
+        break;
+
+    case 2:
+        for( size_t i = 0; i < aCount; i++ )
+        {
+            aPoints[i].x = -( aPoints[i].x - cx ) + cx;
+            aPoints[i].y = -( aPoints[i].y - cy ) + cy;
+        }
+
+        break;
+
+    case 3:
+        for( size_t i = 0; i < aCount; i++ )
+        {
+            int dx = aPoints[i].x - cx;
+            int dy = aPoints[i].y - cy;
+
+            aPoints[i].x = dy + cx;
+            aPoints[i].y = -dx + cy;
+        }
+
+        break;
+
+    default:
+        break;
+    }
+}
+
+
+void RotatePoints( VECTOR2I* aPoints, size_t aCount, double aAngle, const VECTOR2I& aCenter )
+{
+    const double quarters = aAngle / M_PI_2;
+    const double wholeQuarters = std::round( quarters );
+
+    if( std::abs( quarters - wholeQuarters ) < 1e-12 )
+    {
+        int turns = (int) std::fmod( wholeQuarters, 4.0 );
+        rotateQuarters( aPoints, aCount, ( turns + 4 ) % 4, aCenter );
+        return;
+    }
+
+    const double sa = sin( aAngle );
+    const double ca = cos( aAngle );
+    const int    cx = aCenter.x;
+    const int    cy = aCenter.y;
+
+    // Points are rotated in blocks: the rounded coordinates of a block are range-checked at
+    // once and only a block with an out of range value goes through KiROUND() point by point.
+    const size_t BLOCK_SIZE = 64;
+    const double intMin = std::numeric_limits<int>::lowest();
+    const double intMax = std::numeric_limits<int>::max();
+
+    double rx[BLOCK_SIZE];
+    double ry[BLOCK_SIZE];
+
+    for( size_t start = 0; start < aCount; start += BLOCK_SIZE )
+    {
+        VECTOR2I*    pts = aPoints + start;
+        const size_t n = std::min( BLOCK_SIZE, aCount - start );
+        double       lo = 0.0;
+        double       hi = 0.0;
+
+        for( size_t i = 0; i < n; i++ )
+        {
+            const double x = pts[i].x - cx;
+            const double y = pts[i].y - cy;
+            const double vx = x * ca - y * sa;
+            const double vy = x * sa + y * ca;
+
+            // Same rounding as KiROUND()
+            rx[i] = vx < 0 ? vx - 0.5 : vx + 0.5;
+            ry[i] = vy < 0 ? vy - 0.5 : vy + 0.5;
+
+            lo = std::min( lo, std::min( rx[i], ry[i] ) );
+            hi = std::max( hi, std::max( rx[i], ry[i] ) );
+        }
+
+        if( lo >= intMin && hi <= intMax )
+        {
+            for( size_t i = 0; i < n; i++ )
+            {
+                pts[i].x = (int) (long long) rx[i] + cx;
+                pts[i].y = (int) (long long) ry[i] + cy;
+            }
+        }
+        else
+        {
+            for( size_t i = 0; i < n; i++ )
+            {
+                double x = pts[i].x - cx;
+                double y = pts[i].y - cy;
+
+                pts[i].x = KiROUND( x * ca - y * sa ) + cx;
+                pts[i].y = KiROUND( x * sa + y * ca ) + cy;
+            }
+        }
+    }
+}
@@ -0,0 +1,269 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include <geometry/seg_batch.h>
+
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+#define SEG_BATCH_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+
+namespace
+{
+
+/*
+ * The segment kernel is written once against the handful of operations below, which exist for
+ * plain doubles (the fallback) and for pairs of doubles in SSE2 registers.  A comparison
+ * gives a bool or a lane mask, and select() keeps the lanes of a value where the mask is set
+ * and zeroes the others.
+ */
+
+inline double add( double a, double b ) { return a + b; }
+inline double sub( double a, double b ) { return a - b; }
+inline double mul( double a, double b ) { return a * b; }
+inline double div( double a, double b ) { return a / b; }
+inline double min( double a, double b ) { return std::min( a, b ); }
+inline double max( double a, double b ) { return std::max( a, b ); }
+inline double abs( double a )           { return std::abs( a ); }
+inline bool   gt( double a, double b )  { return a > b; }
+inline bool   lt( double a, double b )  { return a < b; }
+inline bool   both( bool a, bool b )    { return a && b; }
+inline bool   either( bool a, bool b )  { return a || b; }
+inline double select( bool m, double a ) { return m ? a : 0.0; }
+
+template <typename V>
+V splat( double aValue );
+
+template <>
+inline double splat<double>( double aValue )
+{
+    return aValue;
+}
+
+#ifdef SEG_BATCH_USE_SSE2
+inline __m128d add( __m128d a, __m128d b ) { return _mm_add_pd( a, b ); }
+inline __m128d sub( __m128d a, __m128d b ) { return _mm_sub_pd( a, b ); }
+inline __m128d mul( __m128d a, __m128d b ) { return _mm_mul_pd( a, b ); }
+inline __m128d div( __m128d a, __m128d b ) { return _mm_div_pd( a, b ); }
+inline __m128d min( __m128d a, __m128d b ) { return _mm_min_pd( a, b ); }
+inline __m128d max( __m128d a, __m128d b ) { return _mm_max_pd( a, b ); }
+inline __m128d abs( __m128d a )            { return _mm_andnot_pd( _mm_set1_pd( -0.0 ), a ); }
+inline __m128d gt( __m128d a, __m128d b )  { return _mm_cmpgt_pd( a, b ); }
+inline __m128d lt( __m128d a, __m128d b )  { return _mm_cmplt_pd( a, b ); }
+inline __m128d both( __m128d a, __m128d b )   { return _mm_and_pd( a, b ); }
+inline __m128d either( __m128d a, __m128d b ) { return _mm_or_pd( a, b ); }
+inline __m128d select( __m128d m, __m128d a ) { return _mm_and_pd( m, a ); }
+
+template <>
+inline __m128d splat<__m128d>( double aValue )
+{
+    return _mm_set1_pd( aValue );
+}
+#endif
+
+
+/// The query segment, as splatted by makeQuery()
+enum QUERY_FIELD
+{
+    Q_AX, Q_AY, Q_BX, Q_BY,
+    Q_DX, Q_DY,     ///< B - A (exact, as coordinates are ints)
+    Q_LEN,          ///< Squared length, at least 1 so that a point needs no special case
+    Q_MINX, Q_MAXX, Q_MINY, Q_MAXY,
+    Q_COUNT
+};
+
+
+template <typename V>
+void makeQuery( const SEG& aSeg, V* aQuery )
+{
+    aQuery[Q_AX] = splat<V>( aSeg.A.x );
+    aQuery[Q_AY] = splat<V>( aSeg.A.y );
+    aQuery[Q_BX] = splat<V>( aSeg.B.x );
+    aQuery[Q_BY] = splat<V>( aSeg.B.y );
+    aQuery[Q_DX] = sub( aQuery[Q_BX], aQuery[Q_AX] );
+    aQuery[Q_DY] = sub( aQuery[Q_BY], aQuery[Q_AY] );
+    aQuery[Q_LEN] = max( add( mul( aQuery[Q_DX], aQuery[Q_DX] ),
+                              mul( aQuery[Q_DY], aQuery[Q_DY] ) ),
+                         splat<V>( 1.0 ) );
+    aQuery[Q_MINX] = min( aQuery[Q_AX], aQuery[Q_BX] );
+    aQuery[Q_MAXX] = max( aQuery[Q_AX], aQuery[Q_BX] );
+    aQuery[Q_MINY] = min( aQuery[Q_AY], aQuery[Q_BY] );
+    aQuery[Q_MAXY] = max( aQuery[Q_AY], aQuery[Q_BY] );
+}
+
+
+/**
+ * Squared distance from point P to the segment starting at S with direction D and squared
+ * length \a aLen (see QUERY::len).
+ */
+template <typename V>
+V pointToSegment( V aPx, V aPy, V aSx, V aSy, V aDx, V aDy, V aLen )
+{
+    V vx = sub( aPx, aSx );
+    V vy = sub( aPy, aSy );
+    V t = div( add( mul( vx, aDx ), mul( vy, aDy ) ), aLen );
+
+    t = min( max( t, splat<V>( 0.0 ) ), splat<V>( 1.0 ) );
+
+    V nx = sub( vx, mul( t, aDx ) );
+    V ny = sub( vy, mul( t, aDy ) );
+
+    return add( mul( nx, nx ), mul( ny, ny ) );
+}
+
+
+/**
+ * True (or set) where P and Q lie strictly on the same side of the line through S with
+ * direction D, by more than the rounding error of the orientation test.
+ */
+template <typename V>
+auto sameSide( V aSx, V aSy, V aDx, V aDy, V aPx, V aPy, V aQx, V aQy )
+        -> decltype( gt( aSx, aSy ) )
+{
+    // Each product rounds by at most 2^-53 of its magnitude; 1e-15 covers both products and
+    // the difference, and the extra unit keeps exact zeros out.
+    auto orient =
+            [&]( V aX, V aY, V& aError ) -> V
+            {
+                V p1 = mul( aDx, sub( aY, aSy ) );
+                V p2 = mul( aDy, sub( aX, aSx ) );
+
+                aError = add( mul( add( abs( p1 ), abs( p2 ) ), splat<V>( 1e-15 ) ),
+                              splat<V>( 1.0 ) );
+                return sub( p1, p2 );
+            };
+
+    V ep, eq;
+    V op = orient( aPx, aPy, ep );
+    V oq = orient( aQx, aQy, eq );
+    V zero = splat<V>( 0.0 );
+
+    return either( both( gt( op, ep ), gt( oq, eq ) ),
+                   both( lt( op, sub( zero, ep ) ), lt( oq, sub( zero, eq ) ) ) );
+}
+
+
+template <typename V>
+V segmentLowerBound( const V* aQ, V aAx, V aAy, V aBx, V aBy )
+{
+    V dx = sub( aBx, aAx );
+    V dy = sub( aBy, aAy );
+    V len = max( add( mul( dx, dx ), mul( dy, dy ) ), splat<V>( 1.0 ) );
+
+    // Segments that don't cross are closest at one of the four end points
+    V dist = min( min( pointToSegment( aQ[Q_AX], aQ[Q_AY], aAx, aAy, dx, dy, len ),
+                       pointToSegment( aQ[Q_BX], aQ[Q_BY], aAx, aAy, dx, dy, len ) ),
+                  min( pointToSegment( aAx, aAy, aQ[Q_AX], aQ[Q_AY], aQ[Q_DX], aQ[Q_DY],
+                                       aQ[Q_LEN] ),
+                       pointToSegment( aBx, aBy, aQ[Q_AX], aQ[Q_AY], aQ[Q_DX], aQ[Q_DY],
+                                       aQ[Q_LEN] ) ) );
+
+    // They don't cross when either one lies on one side of the other, or when their bounding
+    // boxes don't meet (which also covers collinear segments)
+    auto apart = either( sameSide( aAx, aAy, dx, dy, aQ[Q_AX], aQ[Q_AY], aQ[Q_BX], aQ[Q_BY] ),
+                         sameSide( aQ[Q_AX], aQ[Q_AY], aQ[Q_DX], aQ[Q_DY], aAx, aAy, aBx,
+                                   aBy ) );
+
+    apart = either( apart, either( either( gt( aQ[Q_MINX], max( aAx, aBx ) ),
+                                           lt( aQ[Q_MAXX], min( aAx, aBx ) ) ),
+                                   either( gt( aQ[Q_MINY], max( aAy, aBy ) ),
+                                           lt( aQ[Q_MAXY], min( aAy, aBy ) ) ) ) );
+
+    // The computed distance d is within 1e-5 of the true one for any int coordinates, and
+    // SEG::NearestPoint() rounds to the grid, which brings the exact result up to 0.71
+    // closer.  So the exact squared distance is at least (d - 1)^2 >= d^2 - 2d, and
+    // d^2 * (1 - 1e-4) - 1e4 is below that for any d.
+    return select( apart, sub( mul( dist, splat<V>( 1.0 - 1e-4 ) ), splat<V>( 1e4 ) ) );
+}
+
+} // namespace
+
+
+const double* SEG_BATCH::DistanceLowerBounds( const SEG& aSeg )
+{
+#ifdef SEG_BATCH_USE_SSE2
+    __m128d q[Q_COUNT];
+
+    makeQuery( aSeg, q );
+
+    // An odd count computes one unused lane, which only ever holds finite values
+    for( int i = 0; i < m_count; i += 2 )
+    {
+        __m128d lb = segmentLowerBound( q, _mm_load_pd( m_ax + i ), _mm_load_pd( m_ay + i ),
+                                        _mm_load_pd( m_bx + i ), _mm_load_pd( m_by + i ) );
+
+        _mm_store_pd( m_lowerBounds + i, lb );
+    }
+#else
+    double q[Q_COUNT];
+
+    makeQuery( aSeg, q );
+
+    for( int i = 0; i < m_count; i++ )
+        m_lowerBounds[i] = segmentLowerBound( q, m_ax[i], m_ay[i], m_bx[i], m_by[i] );
+#endif
+
+    return m_lowerBounds;
+}
+
+
+const double* SEG_BATCH::BoxDistanceLowerBounds( const BOX2I& aBox )
+{
+    const double qMinX = aBox.GetX();
+    const double qMinY = aBox.GetY();
+    const double qMaxX = aBox.GetRight();
+    const double qMaxY = aBox.GetBottom();
+
+    // The gaps are differences of ints, so they are exact in double.  The two squares and the
+    // sum round by at most 3 ulps in total, and scaling by (1 - 1e-12) more than makes up for
+    // that and for the rounding of the threshold the caller compares against.
+    const double roundDown = 1.0 - 1e-12;
+
+    // Deliberately free of comparisons and runs over the whole block, so that the compiler
+    // vectorizes it on its own.  ( a + b +/- |a - b| ) / 2 is an exact max / min of two ints,
+    // and as at most one of the two gaps along an axis is positive, ( g0 + |g0| + g1 + |g1| ) / 2
+    // is max( g0, g1, 0 ).
+    for( int i = 0; i < BLOCK_SIZE; i++ )
+    {
+        double minX = ( m_ax[i] + m_bx[i] - std::abs( m_ax[i] - m_bx[i] ) ) * 0.5;
+        double maxX = ( m_ax[i] + m_bx[i] + std::abs( m_ax[i] - m_bx[i] ) ) * 0.5;
+        double minY = ( m_ay[i] + m_by[i] - std::abs( m_ay[i] - m_by[i] ) ) * 0.5;
+        double maxY = ( m_ay[i] + m_by[i] + std::abs( m_ay[i] - m_by[i] ) ) * 0.5;
+
+        double gx0 = qMinX - maxX;
+        double gx1 = minX - qMaxX;
+        double gy0 = qMinY - maxY;
+        double gy1 = minY - qMaxY;
+
+        double dx = ( gx0 + std::abs( gx0 ) + gx1 + std::abs( gx1 ) ) * 0.5;
+        double dy = ( gy0 + std::abs( gy0 ) + gy1 + std::abs( gy1 ) ) * 0.5;
+
+        m_lowerBounds[i] = ( dx * dx + dy * dy ) * roundDown;
+    }
+
+    return m_lowerBounds;
+}
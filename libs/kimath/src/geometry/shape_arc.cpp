@@ -191,69 +191,261 @@ SHAPE_ARC& SHAPE_ARC::ConstructFromStartEndAngle( const VECTOR2I& aStart, const
 bool SHAPE_ARC::Collide( const SEG& aSeg, int aClearance, int* aActual, VECTOR2I* aLocation ) const
 {
     int minDist = aClearance + m_width / 2;
-    VECTOR2I center = GetCenter();
-    ecoord dist_sq;
-    ecoord closest_dist_sq = VECTOR2I::ECOORD_MAX;
+
+    if( !BBox( minDist ).Intersects( BOX2I( aSeg.A, aSeg.B - aSeg.A ).Normalize() ) )
+        return false;
+
     VECTOR2I nearest;
+    ecoord   dist_sq = SquaredDistance( aSeg, &nearest );
+
+    if( dist_sq == 0 || dist_sq < SEG::Square( minDist ) )
+    {
+        if( aLocation )
+            *aLocation = nearest;
+
+        if( aActual )
+            *aActual = std::max( 0, (int) sqrt( dist_sq ) - m_width / 2 );
+
+        return true;
+    }
+
+    return false;
+}
+
+
+/**
+ * An arc whose three points are collinear (but distinct ends) has no finite center and is
+ * handled as its chord.
+ */
+static bool isStraightArc( const SHAPE_ARC& aArc )
+{
+    return aArc.GetP0() != aArc.GetP1()
+           && ( aArc.GetArcMid() - aArc.GetP0() ).Cross( aArc.GetP1() - aArc.GetP0() ) == 0;
+}
+
+
+/**
+ * Check if the point \a aPt of the arc's circle belongs to the arc: it does if it lies on the
+ * same side of the chord as the arc mid point.
+ */
+static bool arcContains( const SHAPE_ARC& aArc, const VECTOR2D& aPt )
+{
+    if( aArc.GetP0() == aArc.GetP1() )
+        return true;
+
+    const VECTOR2D start( aArc.GetP0() );
+    const VECTOR2D chord = VECTOR2D( aArc.GetP1() ) - start;
+
+    double sidePt = chord.Cross( aPt - start );
+    double sideMid = chord.Cross( VECTOR2D( aArc.GetArcMid() ) - start );
+
+    return sidePt * sideMid >= 0.0;
+}
+
+
+static VECTOR2I roundPoint( const VECTOR2D& aPt )
+{
+    return VECTOR2I( KiROUND( aPt.x ), KiROUND( aPt.y ) );
+}
+
+
+VECTOR2I SHAPE_ARC::NearestPoint( const VECTOR2I& aP ) const
+{
+    if( isStraightArc( *this ) )
+        return GetChord().NearestPoint( aP );
+
+    const VECTOR2D center = GetArcCenter( VECTOR2D( m_start ), VECTOR2D( m_mid ),
+                                          VECTOR2D( m_end ) );
+    const VECTOR2D dir = VECTOR2D( aP ) - center;
 
-    VECTOR2I ab = ( aSeg.B - aSeg.A );
-    VECTOR2I ac = ( center - aSeg.A );
+    if( dir.x != 0.0 || dir.y != 0.0 )
+    {
+        double   radius = ( VECTOR2D( m_start ) - center ).EuclideanNorm();
+        VECTOR2D onCircle = center + dir * ( radius / dir.EuclideanNorm() );
+
+        if( arcContains( *this, onCircle ) )
+            return roundPoint( onCircle );
+    }
 
-    ecoord lenAbSq = ab.SquaredEuclideanNorm();
-    double lambda = (double) ac.Dot( ab ) / (double) lenAbSq;
+    if( ( m_start - aP ).SquaredEuclideanNorm() <= ( m_end - aP ).SquaredEuclideanNorm() )
+        return m_start;
 
-    if( lambda >= 0.0 && lambda <= 1.0 )
+    return m_end;
+}
+
+
+SEG::ecoord SHAPE_ARC::SquaredDistance( const SEG& aSeg, VECTOR2I* aNearest ) const
+{
+    if( isStraightArc( *this ) )
     {
-        VECTOR2I p;
+        const SEG chord = GetChord();
 
-        p.x = (double) aSeg.A.x * lambda + (double) aSeg.B.x * (1.0 - lambda);
-        p.y = (double) aSeg.A.y * lambda + (double) aSeg.B.y * (1.0 - lambda);
+        if( aNearest )
+            *aNearest = chord.NearestPoint( aSeg );
 
-        dist_sq = ( m_start - p ).SquaredEuclideanNorm();
+        return chord.SquaredDistance( aSeg );
+    }
+
+    const VECTOR2D center = GetArcCenter( VECTOR2D( m_start ), VECTOR2D( m_mid ),
+                                          VECTOR2D( m_end ) );
+    const double   radius = ( VECTOR2D( m_start ) - center ).EuclideanNorm();
+
+    ecoord   best = VECTOR2I::ECOORD_MAX;
+    VECTOR2I bestPt;
+
+    auto consider =
+            [&]( const VECTOR2I& aPt )
+            {
+                ecoord d = aSeg.SquaredDistance( aPt );
+
+                if( d < best )
+                {
+                    best = d;
+                    bestPt = aPt;
+                }
+            };
+
+    auto considerOnCircle =
+            [&]( const VECTOR2D& aPt )
+            {
+                if( arcContains( *this, aPt ) )
+                    consider( roundPoint( aPt ) );
+            };
+
+    // The distance is reached either at an end of one of the shapes, where the segment crosses
+    // the arc or along the line through the center perpendicular to the segment.
+    consider( m_start );
+    consider( m_end );
+    consider( NearestPoint( aSeg.A ) );
+    consider( NearestPoint( aSeg.B ) );
+
+    const VECTOR2D a( aSeg.A );
+    const VECTOR2D d = VECTOR2D( aSeg.B ) - a;
+    const double   lenSq = d.SquaredEuclideanNorm();
+
+    if( lenSq > 0.0 )
+    {
+        const VECTOR2D ac = a - center;
+        const double   t = -ac.Dot( d ) / lenSq;
+        const VECTOR2D foot = a + d * t;
+        const double   footDistSq = ( foot - center ).SquaredEuclideanNorm();
 
-        if( dist_sq < closest_dist_sq )
+        if( footDistSq > 0.0 )
         {
-            closest_dist_sq = dist_sq;
-            nearest = p;
+            VECTOR2D radial = ( foot - center ) * ( radius / sqrt( footDistSq ) );
+            considerOnCircle( center + radial );
+            considerOnCircle( center - radial );
         }
 
-        dist_sq = ( m_end - p ).SquaredEuclideanNorm();
-
-        if( dist_sq < closest_dist_sq )
+        if( footDistSq <= radius * radius )
         {
-            closest_dist_sq = dist_sq;
-            nearest = p;
+            const double halfChord = sqrt( ( radius * radius - footDistSq ) / lenSq );
+
+            for( double u : { t - halfChord, t + halfChord } )
+            {
+                if( u >= 0.0 && u <= 1.0 )
+                    considerOnCircle( a + d * u );
+            }
         }
     }
 
-    dist_sq = aSeg.SquaredDistance( m_start );
+    if( aNearest )
+        *aNearest = bestPt;
+
+    return best;
+}
 
-    if( dist_sq < closest_dist_sq )
-    {
-        closest_dist_sq = dist_sq;
-        nearest = m_start;
-    }
 
-    dist_sq = aSeg.SquaredDistance( m_end );
+SEG::ecoord SHAPE_ARC::SquaredDistance( const SHAPE_ARC& aArc, VECTOR2I* aNearest ) const
+{
+    if( isStraightArc( aArc ) )
+        return SquaredDistance( aArc.GetChord(), aNearest );
 
-    if( dist_sq < closest_dist_sq )
+    if( isStraightArc( *this ) )
     {
-        closest_dist_sq = dist_sq;
-        nearest = m_end;
+        VECTOR2I nearestOther;
+        ecoord   dist = aArc.SquaredDistance( GetChord(), &nearestOther );
+
+        if( aNearest )
+            *aNearest = GetChord().NearestPoint( nearestOther );
+
+        return dist;
     }
 
-    if( closest_dist_sq == 0 || closest_dist_sq < SEG::Square( minDist ) )
+    ecoord   best = VECTOR2I::ECOORD_MAX;
+    VECTOR2I bestPt;
+
+    auto consider =
+            [&]( const VECTOR2I& aPt, const VECTOR2I& aOtherPt )
+            {
+                ecoord d = ( aPt - aOtherPt ).SquaredEuclideanNorm();
+
+                if( d < best )
+                {
+                    best = d;
+                    bestPt = aPt;
+                }
+            };
+
+    // Ends of either arc against the other one
+    consider( m_start, aArc.NearestPoint( m_start ) );
+    consider( m_end, aArc.NearestPoint( m_end ) );
+    consider( NearestPoint( aArc.GetP0() ), aArc.GetP0() );
+    consider( NearestPoint( aArc.GetP1() ), aArc.GetP1() );
+
+    const VECTOR2D centerA = GetArcCenter( VECTOR2D( m_start ), VECTOR2D( m_mid ),
+                                           VECTOR2D( m_end ) );
+    const VECTOR2D centerB = GetArcCenter( VECTOR2D( aArc.GetP0() ), VECTOR2D( aArc.GetArcMid() ),
+                                           VECTOR2D( aArc.GetP1() ) );
+    const double   rA = ( VECTOR2D( m_start ) - centerA ).EuclideanNorm();
+    const double   rB = ( VECTOR2D( aArc.GetP0() ) - centerB ).EuclideanNorm();
+    const VECTOR2D axis = centerB - centerA;
+    const double   dist = axis.EuclideanNorm();
+
+    // Concentric arcs are fully handled by the ends above
+    if( dist > 0.0 )
     {
-        if( aLocation )
-            *aLocation = nearest;
+        const VECTOR2D u = axis / dist;
 
-        if( aActual )
-            *aActual = std::max( 0, (int) sqrt( closest_dist_sq ) - m_width / 2 );
+        // Interior pairs lie on the line through both centers
+        for( double sA : { -1.0, 1.0 } )
+        {
+            VECTOR2D pA = centerA + u * ( sA * rA );
 
-        return true;
+            if( !arcContains( *this, pA ) )
+                continue;
+
+            for( double sB : { -1.0, 1.0 } )
+            {
+                VECTOR2D pB = centerB + u * ( sB * rB );
+
+                if( arcContains( aArc, pB ) )
+                    consider( roundPoint( pA ), roundPoint( pB ) );
+            }
+        }
+
+        // Crossings of the two circles
+        if( dist <= rA + rB && dist >= std::abs( rA - rB ) )
+        {
+            const double   along = ( dist * dist + rA * rA - rB * rB ) / ( 2.0 * dist );
+            const double   h = sqrt( std::max( 0.0, rA * rA - along * along ) );
+            const VECTOR2D base = centerA + u * along;
+            const VECTOR2D perp( -u.y, u.x );
+
+            for( double s : { -1.0, 1.0 } )
+            {
+                VECTOR2D pt = base + perp * ( s * h );
+
+                if( arcContains( *this, pt ) && arcContains( aArc, pt ) )
+                    consider( roundPoint( pt ), roundPoint( pt ) );
+            }
+        }
     }
 
-    return false;
+    if( aNearest )
+        *aNearest = bestPt;
+
+    return best;
 }
 
 
@@ -319,19 +511,16 @@ bool SHAPE_ARC::Collide( const VECTOR2I& aP, int aClearance, int* aActual,
     if( !bbox.Contains( aP ) )
         return false;
 
-    ecoord min_dist_sq = SEG::Square( minDist );
-    ecoord r_sq = SEG::Square( GetRadius() );
+    VECTOR2I nearest = NearestPoint( aP );
+    ecoord   dist_sq = ( nearest - aP ).SquaredEuclideanNorm();
 
-    ecoord dist_sq = ( aP - GetCenter() ).SquaredEuclideanNorm();
-    ecoord dist_to_edge_sq = abs( dist_sq - r_sq );
-
-    if( dist_to_edge_sq == 0 || dist_to_edge_sq < min_dist_sq )
+    if( dist_sq == 0 || dist_sq < SEG::Square( minDist ) )
     {
         if( aLocation )
-            *aLocation = ( aP + GetCenter() ) / 2;
+            *aLocation = nearest;
 
         if( aActual )
-            *aActual = std::max( 0, (int) sqrt( dist_to_edge_sq ) - m_width / 2 );
+            *aActual = std::max( 0, (int) sqrt( dist_sq ) - m_width / 2 );
 
         return true;
     }
@@ -435,68 +435,153 @@ static inline bool Collide( const SHAPE_RECT& aA, const SHAPE_RECT& aB, int aCle
 }
 
 
-static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_RECT& aB, int aClearance,
+static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_LINE_CHAIN_BASE& aB, int aClearance,
                             int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
 {
-    int clearance = aClearance + ( aA.GetWidth() / 2 );
-    const SHAPE_LINE_CHAIN lc = aA.ConvertToPolyline();
+    wxASSERT_MSG( !aMTV, wxString::Format( "MTV not implemented for %s : %s collisions",
+                                           aA.Type(),
+                                           aB.Type() ) );
+
+    int closest_dist = INT_MAX;
+    VECTOR2I nearest;
+
+    if( aB.IsClosed() && aB.PointInside( aA.GetP0() ) )
+    {
+        closest_dist = 0;
+        nearest = aA.GetP0();
+    }
+    else
+    {
+        for( size_t i = 0; i < aB.GetSegmentCount(); i++ )
+        {
+            int collision_dist = 0;
+            VECTOR2I pn;
+
+            if( aA.Collide( aB.GetSegment( i ), aClearance,
+                            aActual || aLocation ? &collision_dist : nullptr,
+                            aLocation ? &pn : nullptr ) )
+            {
+                if( collision_dist < closest_dist )
+                {
+                    nearest = pn;
+                    closest_dist = collision_dist;
+                }
+
+                if( closest_dist == 0 )
+                    break;
+
+                // If we're not looking for aActual then any collision will do
+                if( !aActual )
+                    break;
+            }
+        }
+    }
+
+    if( closest_dist == 0 || closest_dist < aClearance )
+    {
+        if( aLocation )
+            *aLocation = nearest;
+
+        if( aActual )
+            *aActual = closest_dist;
+
+        return true;
+    }
+
+    return false;
+}
 
-    return Collide( lc, aB.Outline(), clearance, aActual, aLocation, aMTV );
+
+static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_RECT& aB, int aClearance,
+                            int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
+{
+    return Collide( aA, aB.Outline(), aClearance, aActual, aLocation, aMTV );
 }
 
 
 static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_CIRCLE& aB, int aClearance,
                             int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
 {
-    const SHAPE_LINE_CHAIN lc = aA.ConvertToPolyline();
-    int clearance = aClearance + ( aA.GetWidth() / 2 );
-    bool rv = Collide( aB, lc, clearance, aActual, aLocation, aMTV );
+    // The push-out force is only implemented for polylines
+    if( aMTV )
+    {
+        const SHAPE_LINE_CHAIN lc = aA.ConvertToPolyline();
+        int clearance = aClearance + ( aA.GetWidth() / 2 );
+        bool rv = Collide( aB, lc, clearance, aActual, aLocation, aMTV );
 
-    if( rv && aMTV )
-        *aMTV = - *aMTV ;
+        if( rv )
+            *aMTV = - *aMTV ;
 
-    return rv;
+        return rv;
+    }
+
+    if( aA.Collide( aB.GetCenter(), aClearance + aB.GetRadius(), aActual, aLocation ) )
+    {
+        if( aActual )
+            *aActual = std::max( 0, *aActual - aB.GetRadius() );
+
+        return true;
+    }
+
+    return false;
 }
 
 
 static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_LINE_CHAIN& aB, int aClearance,
                             int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
 {
-    int clearance = aClearance + ( aA.GetWidth() / 2 );
-    const SHAPE_LINE_CHAIN lc = aA.ConvertToPolyline();
-
-    return Collide( lc, aB, clearance, aActual, aLocation, aMTV );
+    return Collide( aA, static_cast<const SHAPE_LINE_CHAIN_BASE&>( aB ), aClearance, aActual,
+                    aLocation, aMTV );
 }
 
 
 static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_SEGMENT& aB, int aClearance,
                             int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
 {
-    int clearance = aClearance + ( aA.GetWidth() / 2 );
-    const SHAPE_LINE_CHAIN lc = aA.ConvertToPolyline();
-
-    return Collide( lc, aB, clearance, aActual, aLocation, aMTV );
-}
+    wxASSERT_MSG( !aMTV, wxString::Format( "MTV not implemented for %s : %s collisions",
+                                           aA.Type(),
+                                           aB.Type() ) );
 
+    if( aA.Collide( aB.GetSeg(), aClearance + aB.GetWidth() / 2, aActual, aLocation ) )
+    {
+        if( aActual )
+            *aActual = std::max( 0, *aActual - aB.GetWidth() / 2 );
 
-static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_LINE_CHAIN_BASE& aB, int aClearance,
-                            int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
-{
-    int clearance = aClearance + ( aA.GetWidth() / 2 );
-    const SHAPE_LINE_CHAIN lc = aA.ConvertToPolyline();
+        return true;
+    }
 
-    return Collide( lc, aB, clearance, aActual, aLocation, aMTV );
+    return false;
 }
 
 
 static inline bool Collide( const SHAPE_ARC& aA, const SHAPE_ARC& aB, int aClearance,
                             int* aActual, VECTOR2I* aLocation, VECTOR2I* aMTV )
 {
-    const SHAPE_LINE_CHAIN lcA = aA.ConvertToPolyline();
-    const SHAPE_LINE_CHAIN lcB = aB.ConvertToPolyline();
-    int clearance = aClearance + ( aA.GetWidth() / 2 ) + ( aB.GetWidth() / 2 );
+    wxASSERT_MSG( !aMTV, wxString::Format( "MTV not implemented for %s : %s collisions",
+                                           aA.Type(),
+                                           aB.Type() ) );
+
+    int halfWidths = ( aA.GetWidth() / 2 ) + ( aB.GetWidth() / 2 );
+    int minDist = aClearance + halfWidths;
 
-    return Collide( lcA, lcB, clearance, aActual, aLocation, aMTV );
+    if( !aA.BBox( minDist ).Intersects( aB.BBox() ) )
+        return false;
+
+    VECTOR2I    nearest;
+    SEG::ecoord dist_sq = aA.SquaredDistance( aB, &nearest );
+
+    if( dist_sq == 0 || dist_sq < SEG::Square( minDist ) )
+    {
+        if( aLocation )
+            *aLocation = nearest;
+
+        if( aActual )
+            *aActual = std::max( 0, (int) sqrt( dist_sq ) - halfWidths );
+
+        return true;
+    }
+
+    return false;
 }
 
 
@@ -29,6 +29,7 @@
 
 #include <clipper.hpp>
 #include <geometry/seg.h>    // for SEG, OPT_VECTOR2I
+#include <geometry/seg_batch.h>
 #include <geometry/shape_line_chain.h>
 #include <math/box2.h>       // for BOX2I
 #include <math/util.h>  // for rescale
@@ -85,6 +86,58 @@ void SHAPE_LINE_CHAIN::convertArc( ssize_t aArcIndex )
 }
 
 
+/**
+ * Return the squared distance at or beyond which a segment cannot change the outcome of a
+ * SHAPE_LINE_CHAIN_BASE::Collide() query: it can't be closer than the best candidate so far,
+ * and when the actual distance isn't requested, it can't be within the clearance either.
+ */
+static SEG::ecoord pruneThreshold( SEG::ecoord aClosestSq, SEG::ecoord aClearanceSq,
+                                   int* aActual )
+{
+    if( aActual )
+        return aClosestSq;
+
+    // A zero clearance still collides at distance zero
+    return std::min( aClosestSq, std::max<SEG::ecoord>( aClearanceSq, 1 ) );
+}
+
+
+/**
+ * Call \a aVisitor, in order, for each segment of \a aChain that may lie closer to \a aQuery
+ * than \a aPruneSq (squared).  Segments are gathered in SEG_BATCH blocks, and those that the
+ * batched distance lower bound rules out are skipped before the visitor runs the exact test.
+ * The visitor may lower \a aPruneSq and returns true to stop the walk.
+ */
+template <typename VISITOR>
+static void visitNearbySegments( const SHAPE_LINE_CHAIN_BASE& aChain, const SEG& aQuery,
+                                 const SEG::ecoord& aPruneSq, VISITOR aVisitor )
+{
+    SEG_BATCH batch;
+    size_t    count = aChain.GetSegmentCount();
+
+    for( size_t i = 0; i < count; i++ )
+    {
+        batch.Add( aChain.GetSegment( i ) );
+
+        if( !batch.Full() && i + 1 < count )
+            continue;
+
+        const double* lowerBounds = batch.DistanceLowerBounds( aQuery );
+
+        for( int j = 0; j < batch.Size(); j++ )
+        {
+            if( lowerBounds[j] >= (double) aPruneSq )
+                continue;
+
+            if( aVisitor( batch.Get( j ) ) )
+                return;
+        }
+
+        batch.Clear();
+    }
+}
+
+
 bool SHAPE_LINE_CHAIN_BASE::Collide( const VECTOR2I& aP, int aClearance, int* aActual,
                                      VECTOR2I* aLocation ) const
 {
@@ -101,27 +154,31 @@ bool SHAPE_LINE_CHAIN_BASE::Collide( const VECTOR2I& aP, int aClearance, int* aA
 
     SEG::ecoord closest_dist_sq = VECTOR2I::ECOORD_MAX;
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
+    SEG::ecoord prune_sq = pruneThreshold( closest_dist_sq, clearance_sq, aActual );
     VECTOR2I nearest;
 
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
-    {
-        const SEG& s = GetSegment( i );
-        VECTOR2I pn = s.NearestPoint( aP );
-        SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
+    visitNearbySegments( *this, SEG( aP, aP ), prune_sq,
+            [&]( const SEG& s ) -> bool
+            {
+                VECTOR2I pn = s.NearestPoint( aP );
+                SEG::ecoord dist_sq = ( pn - aP ).SquaredEuclideanNorm();
 
-        if( dist_sq < closest_dist_sq )
-        {
-            nearest = pn;
-            closest_dist_sq = dist_sq;
+                if( dist_sq < closest_dist_sq )
+                {
+                    nearest = pn;
+                    closest_dist_sq = dist_sq;
+                    prune_sq = pruneThreshold( closest_dist_sq, clearance_sq, aActual );
 
-            if( closest_dist_sq == 0 )
-                break;
+                    if( closest_dist_sq == 0 )
+                        return true;
 
-            // If we're not looking for aActual then any collision will do
-            if( closest_dist_sq < clearance_sq && !aActual )
-                break;
-        }
-    }
+                    // If we're not looking for aActual then any collision will do
+                    if( closest_dist_sq < clearance_sq && !aActual )
+                        return true;
+                }
+
+                return false;
+            } );
 
     if( closest_dist_sq == 0 || closest_dist_sq < clearance_sq )
     {
@@ -140,12 +197,7 @@ bool SHAPE_LINE_CHAIN_BASE::Collide( const VECTOR2I& aP, int aClearance, int* aA
 
 void SHAPE_LINE_CHAIN::Rotate( double aAngle, const VECTOR2I& aCenter )
 {
-    for( auto& pt : m_points )
-    {
-        pt -= aCenter;
-        pt = pt.Rotate( aAngle );
-        pt += aCenter;
-    }
+    RotatePoints( m_points.data(), m_points.size(), aAngle, aCenter );
 
     for( auto& arc : m_arcs )
         arc.Rotate( aAngle, aCenter );
@@ -168,28 +220,32 @@ bool SHAPE_LINE_CHAIN_BASE::Collide( const SEG& aSeg, int aClearance, int* aActu
 
     SEG::ecoord closest_dist_sq = VECTOR2I::ECOORD_MAX;
     SEG::ecoord clearance_sq = SEG::Square( aClearance );
+    SEG::ecoord prune_sq = pruneThreshold( closest_dist_sq, clearance_sq, aActual );
     VECTOR2I nearest;
 
-    for( size_t i = 0; i < GetSegmentCount(); i++ )
-    {
-        const SEG& s = GetSegment( i );
-        SEG::ecoord dist_sq =s.SquaredDistance( aSeg );
+    visitNearbySegments( *this, aSeg, prune_sq,
+            [&]( const SEG& s ) -> bool
+            {
+                SEG::ecoord dist_sq = s.SquaredDistance( aSeg );
 
-        if( dist_sq < closest_dist_sq )
-        {
-            if( aLocation )
-                nearest = s.NearestPoint( aSeg );
+                if( dist_sq < closest_dist_sq )
+                {
+                    if( aLocation )
+                        nearest = s.NearestPoint( aSeg );
 
-            closest_dist_sq = dist_sq;
+                    closest_dist_sq = dist_sq;
+                    prune_sq = pruneThreshold( closest_dist_sq, clearance_sq, aActual );
 
-            if( closest_dist_sq == 0)
-                break;
+                    if( closest_dist_sq == 0 )
+                        return true;
 
-            // If we're not looking for aActual then any collision will do
-            if( closest_dist_sq < clearance_sq && !aActual )
-                break;
-        }
-    }
+                    // If we're not looking for aActual then any collision will do
+                    if( closest_dist_sq < clearance_sq && !aActual )
+                        return true;
+                }
+
+                return false;
+            } );
 
     if( closest_dist_sq == 0 || closest_dist_sq < clearance_sq )
     {
@@ -210,9 +266,9 @@ const SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Reverse() const
 {
     SHAPE_LINE_CHAIN a( *this );
 
-    reverse( a.m_points.begin(), a.m_points.end() );
-    reverse( a.m_shapes.begin(), a.m_shapes.end() );
-    reverse( a.m_arcs.begin(), a.m_arcs.end() );
+    std::reverse( a.m_points.begin(), a.m_points.end() );
+    std::reverse( a.m_shapes.begin(), a.m_shapes.end() );
+    std::reverse( a.m_arcs.begin(), a.m_arcs.end() );
 
     for( auto& sh : a.m_shapes )
     {
@@ -242,14 +298,7 @@ long long int SHAPE_LINE_CHAIN::Length() const
 
 void SHAPE_LINE_CHAIN::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 {
-    for( auto& pt : m_points )
-    {
-        if( aX )
-            pt.x = -pt.x + 2 * aRef.x;
-
-        if( aY )
-            pt.y = -pt.y + 2 * aRef.y;
-    }
+    MirrorPoints( m_points.data(), m_points.size(), aX, aY, aRef );
 
     for( auto& arc : m_arcs )
         arc.Mirror( aX, aY, aRef );
@@ -951,6 +1000,102 @@ const OPT<SHAPE_LINE_CHAIN::INTERSECTION> SHAPE_LINE_CHAIN::SelfIntersecting() c
 }
 
 
+SHAPE_LINE_CHAIN SHAPE_LINE_CHAIN::Decimated( int aMaxError ) const
+{
+    const int np = PointCount();
+
+    if( np < 3 || aMaxError <= 0 )
+        return *this;
+
+    // For closed chains, index np stands for the first point again so the closing segment
+    // is simplified like the others
+    auto point =
+            [&]( int aIdx ) -> const VECTOR2I&
+            {
+                return m_points[aIdx == np ? 0 : aIdx];
+            };
+
+    const SEG::ecoord     maxErrorSq = SEG::Square( aMaxError );
+    const int             last = m_closed ? np : np - 1;
+    std::vector<bool>     keep( np, false );
+    std::vector<std::pair<int, int>> ranges;
+
+    keep[0] = true;
+
+    if( m_closed )
+    {
+        // Split the loop at the vertex farthest from the first one
+        int         farthest = 1;
+        SEG::ecoord farthestDist = 0;
+
+        for( int i = 1; i < np; i++ )
+        {
+            SEG::ecoord d = ( m_points[i] - m_points[0] ).SquaredEuclideanNorm();
+
+            if( d > farthestDist )
+            {
+                farthestDist = d;
+                farthest = i;
+            }
+        }
+
+        keep[farthest] = true;
+        ranges.emplace_back( 0, farthest );
+        ranges.emplace_back( farthest, last );
+    }
+    else
+    {
+        keep[last] = true;
+        ranges.emplace_back( 0, last );
+    }
+
+    // Explicit stack rather than recursion: fill outlines can have 100k+ vertices
+    while( !ranges.empty() )
+    {
+        const std::pair<int, int> range = ranges.back();
+        ranges.pop_back();
+
+        if( range.second - range.first < 2 )
+            continue;
+
+        const SEG   chord( point( range.first ), point( range.second ) );
+        int         worst = -1;
+        SEG::ecoord worstDist = maxErrorSq;
+
+        for( int i = range.first + 1; i < range.second; i++ )
+        {
+            SEG::ecoord d = chord.SquaredDistance( m_points[i] );
+
+            if( d > worstDist )
+            {
+                worstDist = d;
+                worst = i;
+            }
+        }
+
+        if( worst >= 0 )
+        {
+            keep[worst] = true;
+            ranges.emplace_back( range.first, worst );
+            ranges.emplace_back( worst, range.second );
+        }
+    }
+
+    SHAPE_LINE_CHAIN result;
+
+    for( int i = 0; i < np; i++ )
+    {
+        if( keep[i] )
+            result.Append( m_points[i] );
+    }
+
+    result.SetClosed( m_closed );
+    result.SetWidth( m_width );
+
+    return result;
+}
+
+
 SHAPE_LINE_CHAIN& SHAPE_LINE_CHAIN::Simplify( bool aRemoveColinear )
 {
     std::vector<VECTOR2I> pts_unique;
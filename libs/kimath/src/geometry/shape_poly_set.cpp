@@ -27,20 +27,24 @@
  */
 
 #include <algorithm>
+#include <atomic>
 #include <assert.h>                          // for assert
 #include <cmath>                             // for sqrt, cos, hypot, isinf
 #include <cstdio>
+#include <future>
 #include <istream>                           // for operator<<, operator>>
 #include <limits>                            // for numeric_limits
 #include <memory>
 #include <set>
 #include <string>                            // for char_traits, operator!=
+#include <thread>
 #include <type_traits>                       // for swap, move
 #include <unordered_set>
 #include <vector>
 
 #include <clipper.hpp>                       // for Clipper, PolyNode, Clipp...
 #include <geometry/geometry_utils.h>
+#include <geometry/packed_rtree.h>
 #include <geometry/polygon_triangulation.h>
 #include <geometry/seg.h>                    // for SEG, OPT_VECTOR2I
 #include <geometry/shape.h>
@@ -71,7 +75,8 @@ SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_LINE_CHAIN& aOutline ) :
 
 
 SHAPE_POLY_SET::SHAPE_POLY_SET( const SHAPE_POLY_SET& aOther ) :
-    SHAPE( aOther ), m_polys( aOther.m_polys )
+    SHAPE( aOther ), m_polys( aOther.m_polys ),
+    m_edgeIndex( aOther.m_edgeIndex )
 {
     if( aOther.IsTriangulationUpToDate() )
     {
@@ -187,18 +192,22 @@ bool SHAPE_POLY_SET::GetGlobalIndex( SHAPE_POLY_SET::VERTEX_INDEX aRelativeIndic
 
 int SHAPE_POLY_SET::NewOutline()
 {
+    invalidateEdgeIndex();
+
     SHAPE_LINE_CHAIN empty_path;
     POLYGON poly;
 
     empty_path.SetClosed( true );
-    poly.push_back( empty_path );
-    m_polys.push_back( poly );
+    poly.push_back( std::move( empty_path ) );
+    m_polys.push_back( std::move( poly ) );
     return m_polys.size() - 1;
 }
 
 
 int SHAPE_POLY_SET::NewHole( int aOutline )
 {
+    invalidateEdgeIndex();
+
     SHAPE_LINE_CHAIN empty_path;
 
     empty_path.SetClosed( true );
@@ -208,7 +217,7 @@ int SHAPE_POLY_SET::NewHole( int aOutline )
         aOutline += m_polys.size();
 
     // Add hole to the selected outline
-    m_polys[aOutline].push_back( empty_path );
+    m_polys[aOutline].push_back( std::move( empty_path ) );
 
     return m_polys.back().size() - 2;
 }
@@ -216,6 +225,8 @@ int SHAPE_POLY_SET::NewHole( int aOutline )
 
 int SHAPE_POLY_SET::Append( int x, int y, int aOutline, int aHole, bool aAllowDuplication )
 {
+    invalidateEdgeIndex();
+
     assert( m_polys.size() );
 
     if( aOutline < 0 )
@@ -239,6 +250,8 @@ int SHAPE_POLY_SET::Append( int x, int y, int aOutline, int aHole, bool aAllowDu
 
 void SHAPE_POLY_SET::InsertVertex( int aGlobalIndex, VECTOR2I aNewVertex )
 {
+    invalidateEdgeIndex();
+
     VERTEX_INDEX index;
 
     if( aGlobalIndex < 0 )
@@ -424,13 +437,15 @@ bool SHAPE_POLY_SET::IsSelfIntersecting() const
 
 int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 {
+    invalidateEdgeIndex();
+
     assert( aOutline.IsClosed() );
 
     POLYGON poly;
 
     poly.push_back( aOutline );
 
-    m_polys.push_back( poly );
+    m_polys.push_back( std::move( poly ) );
 
     return m_polys.size() - 1;
 }
@@ -438,6 +453,8 @@ int SHAPE_POLY_SET::AddOutline( const SHAPE_LINE_CHAIN& aOutline )
 
 int SHAPE_POLY_SET::AddHole( const SHAPE_LINE_CHAIN& aHole, int aOutline )
 {
+    invalidateEdgeIndex();
+
     assert( m_polys.size() );
 
     if( aOutline < 0 )
@@ -467,6 +484,8 @@ void SHAPE_POLY_SET::booleanOp( ClipperLib::ClipType aType,
         const SHAPE_POLY_SET& aOtherShape,
         POLYGON_MODE aFastMode )
 {
+    invalidateEdgeIndex();
+
     Clipper c;
 
     c.StrictlySimple( aFastMode == PM_STRICTLY_SIMPLE );
@@ -533,6 +552,126 @@ void SHAPE_POLY_SET::BooleanIntersection( const SHAPE_POLY_SET& a,
 }
 
 
+///< Smallest number of polygons given to each thread merging a UNION_BATCH
+static const size_t UNION_BATCH_MIN_CHUNK = 256;
+
+
+void SHAPE_POLY_SET::UNION_BATCH::Add( const SHAPE_POLY_SET& aSet )
+{
+    for( const POLYGON& poly : aSet.m_polys )
+    {
+        m_polys.emplace_back();
+
+        for( size_t i = 0; i < poly.size(); i++ )
+            m_polys.back().push_back( poly[i].convertToClipper( i == 0 ) );
+    }
+}
+
+
+void SHAPE_POLY_SET::UNION_BATCH::Add( const SHAPE_LINE_CHAIN& aOutline )
+{
+    m_polys.emplace_back();
+    m_polys.back().push_back( aOutline.convertToClipper( true ) );
+}
+
+
+void SHAPE_POLY_SET::UNION_BATCH::Execute( SHAPE_POLY_SET& aResult, POLYGON_MODE aFastMode,
+                                           size_t aMaxThreads )
+{
+    size_t threadCount = aMaxThreads ? aMaxThreads : std::thread::hardware_concurrency();
+    size_t chunkCount = std::max<size_t>( 1, std::min( threadCount,
+                                                       m_polys.size() / UNION_BATCH_MIN_CHUNK ) );
+
+    // Clipper's union output has the outlines in the positive orientation and the holes in
+    // the negative one, so the partial results can be merged again with the non-zero rule.
+    std::vector<Paths> partials;
+
+    if( chunkCount > 1 )
+    {
+        partials.resize( chunkCount );
+
+        std::atomic<size_t> nextChunk( 0 );
+
+        auto mergeChunks =
+                [&]()
+                {
+                    for( size_t ii = nextChunk++; ii < chunkCount; ii = nextChunk++ )
+                    {
+                        Clipper c;
+                        size_t  first = m_polys.size() * ii / chunkCount;
+                        size_t  last = m_polys.size() * ( ii + 1 ) / chunkCount;
+
+                        for( size_t jj = first; jj < last; jj++ )
+                            c.AddPaths( m_polys[jj], ptSubject, true );
+
+                        c.Execute( ctUnion, partials[ii], pftNonZero, pftNonZero );
+                    }
+                };
+
+        std::vector<std::future<void>> workers;
+
+        for( size_t ii = 1; ii < chunkCount; ii++ )
+            workers.push_back( std::async( std::launch::async, mergeChunks ) );
+
+        mergeChunks();
+
+        for( std::future<void>& worker : workers )
+            worker.get();
+
+        // Merge the partial results pairwise until two are left for the final pass
+        while( partials.size() > 2 )
+        {
+            std::vector<Paths>             merged( partials.size() / 2 );
+            std::vector<std::future<void>> pairs;
+
+            for( size_t ii = 0; ii < merged.size(); ii++ )
+            {
+                pairs.push_back( std::async( std::launch::async,
+                        [&partials, &merged, ii]()
+                        {
+                            Clipper c;
+
+                            c.AddPaths( partials[2 * ii], ptSubject, true );
+                            c.AddPaths( partials[2 * ii + 1], ptSubject, true );
+                            c.Execute( ctUnion, merged[ii], pftNonZero, pftNonZero );
+                        } ) );
+            }
+
+            for( std::future<void>& pair : pairs )
+                pair.get();
+
+            if( partials.size() % 2 )
+                merged.push_back( std::move( partials.back() ) );
+
+            partials.swap( merged );
+        }
+    }
+
+    Clipper c;
+
+    c.StrictlySimple( aFastMode == PM_STRICTLY_SIMPLE );
+
+    if( chunkCount > 1 )
+    {
+        for( const Paths& paths : partials )
+            c.AddPaths( paths, ptSubject, true );
+    }
+    else
+    {
+        for( const Paths& paths : m_polys )
+            c.AddPaths( paths, ptSubject, true );
+    }
+
+    m_polys.clear();
+
+    PolyTree solution;
+
+    c.Execute( ctUnion, solution, pftNonZero, pftNonZero );
+
+    aResult.importTree( &solution );
+}
+
+
 void SHAPE_POLY_SET::InflateWithLinkedHoles( int aFactor, int aCircleSegmentsCount,
                                              POLYGON_MODE aFastMode )
 {
@@ -542,17 +681,24 @@ void SHAPE_POLY_SET::InflateWithLinkedHoles( int aFactor, int aCircleSegmentsCou
 }
 
 
+///< Sets with fewer vertices than this are inflated by the calling thread only
+static const int PARALLEL_INFLATE_MIN_VERTICES = 20000;
+
+///< Approximate number of vertices in each piece of a set inflated by several threads
+static const int INFLATE_PIECE_VERTICES = 4096;
+
+
 void SHAPE_POLY_SET::Inflate( int aAmount, int aCircleSegmentsCount,
-                              CORNER_STRATEGY aCornerStrategy )
+                              CORNER_STRATEGY aCornerStrategy, size_t aMaxThreads )
 {
+    invalidateEdgeIndex();
+
     // A static table to avoid repetitive calculations of the coefficient
     // 1.0 - cos( M_PI / aCircleSegmentsCount )
     // aCircleSegmentsCount is most of time <= 64 and usually 8, 12, 16, 32
     #define SEG_CNT_MAX 64
     static double arc_tolerance_factor[SEG_CNT_MAX + 1];
 
-    ClipperOffset c;
-
     // N.B. see the Clipper documentation for jtSquare/jtMiter/jtRound.  They are poorly named
     // and are not what you'd think they are.
     // http://www.angusj.com/delphi/clipper/documentation/Docs/Units/ClipperLib/Types/JoinType.htm
@@ -589,14 +735,6 @@ void SHAPE_POLY_SET::Inflate( int aAmount, int aCircleSegmentsCount,
         break;
     }
 
-    for( const POLYGON& poly : m_polys )
-    {
-        for( size_t i = 0; i < poly.size(); i++ )
-            c.AddPath( poly[i].convertToClipper( i == 0 ), joinType, etClosedPolygon );
-    }
-
-    PolyTree solution;
-
     // Calculate the arc tolerance (arc error) from the seg count by circle. The seg count is
     // nn = M_PI / acos(1.0 - c.ArcTolerance / abs(aAmount))
     // http://www.angusj.com/delphi/clipper/documentation/Docs/Units/ClipperLib/Classes/ClipperOffset/Properties/ArcTolerance.htm
@@ -616,10 +754,198 @@ void SHAPE_POLY_SET::Inflate( int aAmount, int aCircleSegmentsCount,
     else
         coeff = arc_tolerance_factor[aCircleSegmentsCount];
 
-    c.ArcTolerance = std::abs( aAmount ) * coeff;
-    c.MiterLimit = miterLimit;
-    c.MiterFallback = miterFallback;
-    c.Execute( solution, aAmount );
+    auto configure =
+            [&]( ClipperOffset& aOffset )
+            {
+                aOffset.ArcTolerance = std::abs( aAmount ) * coeff;
+                aOffset.MiterLimit = miterLimit;
+                aOffset.MiterFallback = miterFallback;
+            };
+
+    size_t threadCount = 1;
+
+    if( aMaxThreads != 1 && TotalVertices() >= PARALLEL_INFLATE_MIN_VERTICES )
+        threadCount = aMaxThreads ? aMaxThreads : std::thread::hardware_concurrency();
+
+    PolyTree solution;
+
+    if( threadCount <= 1 )
+    {
+        ClipperOffset c;
+
+        for( const POLYGON& poly : m_polys )
+        {
+            for( size_t i = 0; i < poly.size(); i++ )
+                c.AddPath( poly[i].convertToClipper( i == 0 ), joinType, etClosedPolygon );
+        }
+
+        configure( c );
+        c.Execute( solution, aAmount );
+
+        importTree( &solution );
+        return;
+    }
+
+    // The offset of a union is the union of the offsets, so the set is split into pieces that
+    // are inflated independently and merged afterwards.  A piece is either a run of polygons
+    // or, when inflating, one tile of a polygon too large to be handled by a single thread.
+    // Deflating a tile would move its cut edges inwards, so large polygons are kept whole then.
+    struct PIECE
+    {
+        int   m_first;
+        int   m_last;
+        bool  m_tiled;
+        BOX2I m_tile;
+    };
+
+    std::vector<PIECE> pieces;
+    int                groupStart = 0;
+    int                groupVertices = 0;
+
+    for( int ii = 0; ii < (int) m_polys.size(); ii++ )
+    {
+        const POLYGON& poly = m_polys[ii];
+        int            vertices = 0;
+
+        for( const SHAPE_LINE_CHAIN& path : poly )
+            vertices += path.PointCount();
+
+        int   cells = (int) std::ceil( std::sqrt( (double) vertices / INFLATE_PIECE_VERTICES ) );
+        BOX2I bbox = cells > 1 ? poly[0].BBox() : BOX2I();
+
+        if( aAmount > 0 && cells > 1 && bbox.GetWidth() >= cells && bbox.GetHeight() >= cells )
+        {
+            if( groupStart < ii )
+                pieces.push_back( { groupStart, ii, false, BOX2I() } );
+
+            auto gridLine =
+                    [cells]( int aStart, int aSize, int aIndex )
+                    {
+                        return aStart + (int) ( (int64_t) aSize * aIndex / cells );
+                    };
+
+            // Neighbouring tiles share their edges so that no gap is left between them
+            for( int row = 0; row < cells; row++ )
+            {
+                int top = gridLine( bbox.GetY(), bbox.GetHeight(), row );
+                int bottom = gridLine( bbox.GetY(), bbox.GetHeight(), row + 1 );
+
+                for( int col = 0; col < cells; col++ )
+                {
+                    int left = gridLine( bbox.GetX(), bbox.GetWidth(), col );
+                    int right = gridLine( bbox.GetX(), bbox.GetWidth(), col + 1 );
+
+                    pieces.push_back( { ii, ii + 1, true,
+                                        BOX2I( VECTOR2I( left, top ),
+                                               VECTOR2I( right - left, bottom - top ) ) } );
+                }
+            }
+
+            groupStart = ii + 1;
+            groupVertices = 0;
+            continue;
+        }
+
+        groupVertices += vertices;
+
+        if( groupVertices >= INFLATE_PIECE_VERTICES )
+        {
+            pieces.push_back( { groupStart, ii + 1, false, BOX2I() } );
+            groupStart = ii + 1;
+            groupVertices = 0;
+        }
+    }
+
+    if( groupStart < (int) m_polys.size() )
+        pieces.push_back( { groupStart, (int) m_polys.size(), false, BOX2I() } );
+
+    threadCount = std::min( threadCount, pieces.size() );
+
+    std::vector<Paths>  results( pieces.size() );
+    std::atomic<size_t> nextPiece( 0 );
+
+    auto inflatePieces =
+            [&]()
+            {
+                for( size_t ii = nextPiece++; ii < pieces.size(); ii = nextPiece++ )
+                {
+                    const PIECE&  piece = pieces[ii];
+                    ClipperOffset c;
+
+                    if( piece.m_tiled )
+                    {
+                        const POLYGON& poly = m_polys[piece.m_first];
+                        const BOX2I&   tile = piece.m_tile;
+                        Clipper        clip;
+                        Paths          tilePaths;
+
+                        clip.AddPath( poly[0].convertToClipper( true ), ptSubject, true );
+
+                        // Holes away from the tile do not change its part of the polygon
+                        for( size_t jj = 1; jj < poly.size(); jj++ )
+                        {
+                            if( poly[jj].BBox().Intersects( tile ) )
+                                clip.AddPath( poly[jj].convertToClipper( false ), ptSubject, true );
+                        }
+
+                        Path rect = { IntPoint( tile.GetLeft(), tile.GetTop() ),
+                                      IntPoint( tile.GetRight(), tile.GetTop() ),
+                                      IntPoint( tile.GetRight(), tile.GetBottom() ),
+                                      IntPoint( tile.GetLeft(), tile.GetBottom() ) };
+
+                        clip.AddPath( rect, ptClip, true );
+                        clip.Execute( ctIntersection, tilePaths, pftNonZero, pftNonZero );
+
+                        c.AddPaths( tilePaths, joinType, etClosedPolygon );
+                    }
+                    else
+                    {
+                        for( int jj = piece.m_first; jj < piece.m_last; jj++ )
+                        {
+                            const POLYGON& poly = m_polys[jj];
+
+                            for( size_t i = 0; i < poly.size(); i++ )
+                                c.AddPath( poly[i].convertToClipper( i == 0 ), joinType,
+                                           etClosedPolygon );
+                        }
+                    }
+
+                    // The Paths variant of ClipperOffset::Execute() does not reliably remove
+                    // the bounding rectangle it adds when deflating, so use a PolyTree.
+                    PolyTree tree;
+
+                    configure( c );
+                    c.Execute( tree, aAmount );
+
+                    for( PolyNode* node = tree.GetFirst(); node; node = node->GetNext() )
+                    {
+                        results[ii].push_back( std::move( node->Contour ) );
+
+                        if( Orientation( results[ii].back() ) == node->IsHole() )
+                            ReversePath( results[ii].back() );
+                    }
+                }
+            };
+
+    std::vector<std::future<void>> workers;
+
+    for( size_t ii = 1; ii < threadCount; ii++ )
+        workers.push_back( std::async( std::launch::async, inflatePieces ) );
+
+    inflatePieces();
+
+    // get() rethrows anything a worker threw
+    for( std::future<void>& worker : workers )
+        worker.get();
+
+    // The pieces have their outlines in the positive orientation and their holes in the
+    // negative one, so overlapping pieces are merged with the non-zero rule.
+    Clipper merge;
+
+    for( const Paths& paths : results )
+        merge.AddPaths( paths, ptSubject, true );
+
+    merge.Execute( ctUnion, solution, pftNonZero, pftNonZero );
 
     importTree( &solution );
 }
@@ -627,6 +953,8 @@ void SHAPE_POLY_SET::Inflate( int aAmount, int aCircleSegmentsCount,
 
 void SHAPE_POLY_SET::importTree( PolyTree* tree )
 {
+    invalidateEdgeIndex();
+
     m_polys.clear();
 
     for( PolyNode* n = tree->GetFirst(); n; n = n->GetNext() )
@@ -674,10 +1002,84 @@ struct FractureEdge
 };
 
 
-typedef std::vector<FractureEdge*> FractureEdgeSet;
+/**
+ * The edges of a polygon being fractured, bucketed by the horizontal bands they cross so
+ * that the edges crossing a given y are found without scanning the whole polygon.
+ *
+ * The bands form a hierarchy: each level merges pairs of bands of the level below, and an
+ * edge is stored at the lowest level where it spans at most two bands.  Tall edges therefore
+ * take no more room than short ones, and a query visits one band per level.
+ */
+class FRACTURE_EDGE_INDEX
+{
+public:
+    FRACTURE_EDGE_INDEX( int aYMin, int aYMax, size_t aEdgeCount ) :
+            m_yMin( aYMin ),
+            m_height( (int64_t) aYMax - aYMin + 1 )
+    {
+        size_t bands = std::max<size_t>( 1, aEdgeCount / FRACTURE_EDGES_PER_BAND );
+
+        bands = std::min<size_t>( bands, FRACTURE_MAX_BANDS );
+        bands = std::min<size_t>( bands, m_height );
+
+        m_bandCount = bands;
+
+        for( ; bands > 1; bands = ( bands + 1 ) / 2 )
+            m_levels.emplace_back( bands );
+
+        m_levels.emplace_back( 1 );
+    }
+
+    void Add( FractureEdge* aEdge )
+    {
+        size_t first = band( std::min( aEdge->m_p1.y, aEdge->m_p2.y ) );
+        size_t last = band( std::max( aEdge->m_p1.y, aEdge->m_p2.y ) );
+        size_t level = 0;
+
+        for( ; last - first > 1; level++ )
+        {
+            first /= 2;
+            last /= 2;
+        }
 
+        for( size_t i = first; i <= last; i++ )
+            m_levels[level][i].push_back( aEdge );
+    }
 
-static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
+    ///< Call \a aFunc on the edges that may cross the horizontal line at \a aY
+    template <typename FUNC>
+    void ForEachEdge( int aY, FUNC aFunc ) const
+    {
+        size_t i = band( aY );
+
+        for( const std::vector<std::vector<FractureEdge*>>& level : m_levels )
+        {
+            for( FractureEdge* edge : level[i] )
+                aFunc( edge );
+
+            i /= 2;
+        }
+    }
+
+private:
+    static constexpr size_t FRACTURE_EDGES_PER_BAND = 16;
+    static constexpr size_t FRACTURE_MAX_BANDS = 65536;
+
+    ///< Band of \a aY at the lowest level
+    size_t band( int aY ) const
+    {
+        return (size_t) ( ( (int64_t) aY - m_yMin ) * (int64_t) m_bandCount / m_height );
+    }
+
+    int                                                  m_yMin;
+    int64_t                                              m_height;
+    size_t                                               m_bandCount;
+    std::vector<std::vector<std::vector<FractureEdge*>>> m_levels;
+};
+
+
+static int processEdge( FRACTURE_EDGE_INDEX& aIndex, std::vector<FractureEdge>& aEdges,
+                        FractureEdge* edge )
 {
     int x   = edge->m_p1.x;
     int y   = edge->m_p1.y;
@@ -686,44 +1088,56 @@ static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
 
     FractureEdge* e_nearest = NULL;
 
-    for( FractureEdge* e : edges )
-    {
-        if( !e->matches( y ) )
-            continue;
+    aIndex.ForEachEdge( y,
+            [&]( FractureEdge* e )
+            {
+                if( !e->m_connected || !e->matches( y ) )
+                    return;
 
-        int x_intersect;
+                int x_intersect;
 
-        if( e->m_p1.y == e->m_p2.y ) // horizontal edge
-        {
-            x_intersect = std::max( e->m_p1.x, e->m_p2.x );
-        }
-        else
-        {
-            x_intersect = e->m_p1.x + rescale( e->m_p2.x - e->m_p1.x, y - e->m_p1.y,
-                                               e->m_p2.y - e->m_p1.y );
-        }
+                if( e->m_p1.y == e->m_p2.y ) // horizontal edge
+                {
+                    x_intersect = std::max( e->m_p1.x, e->m_p2.x );
+                }
+                else
+                {
+                    x_intersect = e->m_p1.x + rescale( e->m_p2.x - e->m_p1.x, y - e->m_p1.y,
+                                                       e->m_p2.y - e->m_p1.y );
+                }
 
-        int dist = ( x - x_intersect );
+                int dist = ( x - x_intersect );
 
-        if( dist >= 0 && dist < min_dist && e->m_connected )
-        {
-            min_dist    = dist;
-            x_nearest   = x_intersect;
-            e_nearest   = e;
-        }
-    }
+                // The edges live in a single vector in creation order: break ties towards the
+                // first one created, as a scan of all the edges would
+                if( dist >= 0 && ( dist < min_dist || ( dist == min_dist && e < e_nearest ) ) )
+                {
+                    min_dist    = dist;
+                    x_nearest   = x_intersect;
+                    e_nearest   = e;
+                }
+            } );
 
-    if( e_nearest && e_nearest->m_connected )
+    if( e_nearest )
     {
         int count = 0;
 
-        FractureEdge* lead1 = new FractureEdge( true, VECTOR2I( x_nearest, y ), VECTOR2I( x, y ) );
-        FractureEdge* lead2 = new FractureEdge( true, VECTOR2I( x, y ), VECTOR2I( x_nearest, y ) );
-        FractureEdge* split_2 = new FractureEdge( true, VECTOR2I( x_nearest, y ), e_nearest->m_p2 );
+        // The storage was reserved for the bridges of all the holes, so adding the edges of
+        // this one does not move the others.
+        assert( aEdges.size() + 3 <= aEdges.capacity() );
 
-        edges.push_back( split_2 );
-        edges.push_back( lead1 );
-        edges.push_back( lead2 );
+        aEdges.emplace_back( true, VECTOR2I( x_nearest, y ), e_nearest->m_p2 );
+        FractureEdge* split_2 = &aEdges.back();
+
+        aEdges.emplace_back( true, VECTOR2I( x_nearest, y ), VECTOR2I( x, y ) );
+        FractureEdge* lead1 = &aEdges.back();
+
+        aEdges.emplace_back( true, VECTOR2I( x, y ), VECTOR2I( x_nearest, y ) );
+        FractureEdge* lead2 = &aEdges.back();
+
+        aIndex.Add( split_2 );
+        aIndex.Add( lead1 );
+        aIndex.Add( lead2 );
 
         FractureEdge* link = e_nearest->m_next;
 
@@ -753,23 +1167,51 @@ static int processEdge( FractureEdgeSet& edges, FractureEdge* edge )
 
 void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
 {
-    FractureEdgeSet edges;
-    FractureEdgeSet border_edges;
-    FractureEdge*   root = NULL;
+    if( paths.size() == 1 )
+        return;
 
-    bool first = true;
+    size_t pointTotal = 0;
+    int    y_min = std::numeric_limits<int>::max();
+    int    y_max = std::numeric_limits<int>::min();
 
-    if( paths.size() == 1 )
+    for( const SHAPE_LINE_CHAIN& path : paths )
+    {
+        pointTotal += path.PointCount();
+
+        for( const VECTOR2I& p : path.CPoints() )
+        {
+            y_min = std::min( y_min, p.y );
+            y_max = std::max( y_max, p.y );
+        }
+    }
+
+    if( pointTotal == 0 )
         return;
 
-    int num_unconnected = 0;
+    // Every hole adds three edges when it is bridged to the outline
+    std::vector<FractureEdge> edges;
+    edges.reserve( pointTotal + 3 * ( paths.size() - 1 ) );
+
+    FRACTURE_EDGE_INDEX index( y_min, y_max, pointTotal );
+
+    // The left-most edge of each hole, in hole order
+    std::vector<FractureEdge*> border_edges;
+
+    bool first = true;
 
     for( const SHAPE_LINE_CHAIN& path : paths )
     {
-        const std::vector<VECTOR2I>& points = path.CPoints();
+        const SHAPE_LINE_CHAIN::POINT_VECTOR& points = path.CPoints();
         int pointCount = points.size();
 
-        FractureEdge* prev = NULL, * first_edge = NULL;
+        if( pointCount == 0 )
+        {
+            first = false;
+            continue;
+        }
+
+        FractureEdge* first_edge = NULL;
+        FractureEdge* border_edge = NULL;
 
         int x_min = std::numeric_limits<int>::max();
 
@@ -783,80 +1225,77 @@ void SHAPE_POLY_SET::fractureSingle( POLYGON& paths )
         {
             // Do not use path.CPoint() here; open-coding it using the local variables "points"
             // and "pointCount" gives a non-trivial performance boost to zone fill times.
-            FractureEdge* fe = new FractureEdge( first, points[ i ],
-                                                        points[ i+1 == pointCount ? 0 : i+1 ] );
-
-            if( !root )
-                root = fe;
+            edges.emplace_back( first, points[ i ], points[ i+1 == pointCount ? 0 : i+1 ] );
+            FractureEdge* fe = &edges.back();
 
             if( !first_edge )
                 first_edge = fe;
-
-            if( prev )
-                prev->m_next = fe;
+            else
+                fe[-1].m_next = fe;
 
             if( i == pointCount - 1 )
                 fe->m_next = first_edge;
 
-            prev = fe;
-            edges.push_back( fe );
-
-            if( !first )
-            {
-                if( fe->m_p1.x == x_min )
-                    border_edges.push_back( fe );
-            }
+            index.Add( fe );
 
-            if( !fe->m_connected )
-                num_unconnected++;
+            if( !first && !border_edge && fe->m_p1.x == x_min )
+                border_edge = fe;
         }
 
+        if( border_edge )
+            border_edges.push_back( border_edge );
+
         first = false;    // first path is always the outline
     }
 
-    // keep connecting holes to the main outline, until there's no holes left...
-    while( num_unconnected > 0 )
-    {
-        int x_min = std::numeric_limits<int>::max();
+    // Connect the holes to the outline from left to right, so that each hole can always be
+    // bridged to the outline or to a hole already connected to it.
+    std::stable_sort( border_edges.begin(), border_edges.end(),
+                      []( const FractureEdge* a, const FractureEdge* b )
+                      {
+                          return a->m_p1.x < b->m_p1.x;
+                      } );
 
-        FractureEdge* smallestX = NULL;
+    // Holes which cannot be bridged (i.e. not inside the outline) are kept as they are
+    std::vector<FractureEdge*> unbridged;
 
-        // find the left-most hole edge and merge with the outline
-        for( FractureEdge* border_edge : border_edges )
+    for( FractureEdge* border_edge : border_edges )
+    {
+        if( !processEdge( index, edges, border_edge ) )
         {
-            int xt = border_edge->m_p1.x;
-
-            if( ( xt < x_min ) && !border_edge->m_connected )
-            {
-                x_min = xt;
-                smallestX = border_edge;
-            }
+            wxFAIL_MSG( "Fracture(): found no edge to bridge a hole to" );
+            unbridged.push_back( border_edge );
         }
-
-        num_unconnected -= processEdge( edges, smallestX );
     }
 
-    paths.clear();
-    SHAPE_LINE_CHAIN newPath;
+    auto contour =
+            []( FractureEdge* aRoot )
+            {
+                SHAPE_LINE_CHAIN path;
+                FractureEdge*    e;
 
-    newPath.SetClosed( true );
+                path.SetClosed( true );
 
-    FractureEdge* e;
+                for( e = aRoot; e->m_next != aRoot; e = e->m_next )
+                    path.Append( e->m_p1 );
 
-    for( e = root; e->m_next != root; e = e->m_next )
-        newPath.Append( e->m_p1 );
+                path.Append( e->m_p1 );
 
-    newPath.Append( e->m_p1 );
+                return path;
+            };
 
-    for( FractureEdge* edge : edges )
-        delete edge;
+    paths.clear();
+    paths.push_back( contour( &edges.front() ) );
 
-    paths.push_back( std::move( newPath ) );
+    for( FractureEdge* hole : unbridged )
+        paths.push_back( contour( hole ) );
 }
 
 
 void SHAPE_POLY_SET::Fracture( POLYGON_MODE aFastMode )
 {
+    invalidateEdgeIndex();
+
     Simplify( aFastMode );    // remove overlapping holes/degeneracy
 
     for( POLYGON& paths : m_polys )
@@ -1044,6 +1483,8 @@ bool SHAPE_POLY_SET::HasHoles() const
 
 void SHAPE_POLY_SET::Unfracture( POLYGON_MODE aFastMode )
 {
+    invalidateEdgeIndex();
+
     for( POLYGON& path : m_polys )
     {
         unfractureSingle( path );
@@ -1061,8 +1502,53 @@ void SHAPE_POLY_SET::Simplify( POLYGON_MODE aFastMode )
 }
 
 
+SHAPE_POLY_SET SHAPE_POLY_SET::Decimated( int aMaxError ) const
+{
+    SHAPE_POLY_SET result;
+
+    auto visible =
+            [aMaxError]( const SHAPE_LINE_CHAIN& aContour )
+            {
+                const BOX2I bbox = aContour.BBox();
+
+                return bbox.GetWidth() > aMaxError || bbox.GetHeight() > aMaxError;
+            };
+
+    for( const POLYGON& poly : m_polys )
+    {
+        if( poly.empty() || !visible( poly[0] ) )
+            continue;
+
+        SHAPE_LINE_CHAIN outline = poly[0].Decimated( aMaxError );
+
+        if( outline.PointCount() < 3 )
+            continue;
+
+        POLYGON decimated;
+        decimated.push_back( std::move( outline ) );
+
+        for( size_t ii = 1; ii < poly.size(); ii++ )
+        {
+            if( !visible( poly[ii] ) )
+                continue;
+
+            SHAPE_LINE_CHAIN hole = poly[ii].Decimated( aMaxError );
+
+            if( hole.PointCount() >= 3 )
+                decimated.push_back( std::move( hole ) );
+        }
+
+        result.m_polys.push_back( std::move( decimated ) );
+    }
+
+    return result;
+}
+
+
 int SHAPE_POLY_SET::NormalizeAreaOutlines()
 {
+    invalidateEdgeIndex();
+
     // We are expecting only one main outline, but this main outline can have holes
     // if holes: combine holes and remove them from the main outline.
     // Note also we are using SHAPE_POLY_SET::PM_STRICTLY_SIMPLE in polygon
@@ -1127,6 +1613,8 @@ const std::string SHAPE_POLY_SET::Format() const
 
 bool SHAPE_POLY_SET::Parse( std::stringstream& aStream )
 {
+    invalidateEdgeIndex();
+
     std::string tmp;
 
     aStream >> tmp;
@@ -1356,12 +1844,16 @@ bool SHAPE_POLY_SET::Collide( const SHAPE* aShape, int aClearance, int* aActual,
 
 void SHAPE_POLY_SET::RemoveAllContours()
 {
+    invalidateEdgeIndex();
+
     m_polys.clear();
 }
 
 
 void SHAPE_POLY_SET::RemoveContour( int aContourIdx, int aPolygonIdx )
 {
+    invalidateEdgeIndex();
+
     // Default polygon is the last one
     if( aPolygonIdx < 0 )
         aPolygonIdx += m_polys.size();
@@ -1372,6 +1864,8 @@ void SHAPE_POLY_SET::RemoveContour( int aContourIdx, int aPolygonIdx )
 
 int SHAPE_POLY_SET::RemoveNullSegments()
 {
+    invalidateEdgeIndex();
+
     int removed = 0;
 
     ITERATOR iterator = IterateWithHoles();
@@ -1425,12 +1919,16 @@ int SHAPE_POLY_SET::RemoveNullSegments()
 
 void SHAPE_POLY_SET::DeletePolygon( int aIdx )
 {
+    invalidateEdgeIndex();
+
     m_polys.erase( m_polys.begin() + aIdx );
 }
 
 
 void SHAPE_POLY_SET::Append( const SHAPE_POLY_SET& aSet )
 {
+    invalidateEdgeIndex();
+
     m_polys.insert( m_polys.end(), aSet.m_polys.begin(), aSet.m_polys.end() );
 }
 
@@ -1511,13 +2009,316 @@ bool SHAPE_POLY_SET::CollideEdge( const VECTOR2I& aPoint,
 
 void SHAPE_POLY_SET::BuildBBoxCaches()
 {
-    for( int polygonIdx = 0; polygonIdx < OutlineCount(); polygonIdx++ )
+    // Through m_polys: the non-const contour accessors would drop the edge index
+    for( POLYGON& poly : m_polys )
+    {
+        for( SHAPE_LINE_CHAIN& contour : poly )
+            contour.GenerateBBoxCache();
+    }
+}
+
+
+/**
+ * Sets with fewer vertices are always queried with a linear scan of their edges; building
+ * the index would cost more than it could save.
+ */
+static const int EDGE_INDEX_MIN_SET_VERTICES = 1000;
+
+///< Polygons of an indexed set with fewer vertices than this are still scanned linearly
+static const int EDGE_INDEX_MIN_POLY_VERTICES = 64;
+
+
+struct SHAPE_POLY_SET::EDGE_INDEX
+{
+    struct EDGE
+    {
+        int m_contour;
+        int m_segment;
+    };
+
+    /**
+     * A box given by its corners.  Unlike a BOX2I it can span the whole range of int
+     * coordinates.
+     */
+    struct BOUNDS
+    {
+        ///< An empty box, which any box merged into it replaces
+        BOUNDS() :
+                m_min{ std::numeric_limits<int>::max(), std::numeric_limits<int>::max() },
+                m_max{ std::numeric_limits<int>::min(), std::numeric_limits<int>::min() }
+        {
+        }
+
+        BOUNDS( const VECTOR2I& aP ) :
+                m_min{ aP.x, aP.y },
+                m_max{ aP.x, aP.y }
+        {
+        }
+
+        BOUNDS( const SEG& aSeg ) :
+                m_min{ std::min( aSeg.A.x, aSeg.B.x ), std::min( aSeg.A.y, aSeg.B.y ) },
+                m_max{ std::max( aSeg.A.x, aSeg.B.x ), std::max( aSeg.A.y, aSeg.B.y ) }
+        {
+        }
+
+        ///< Return the box inflated by \a aMargin, clamped to the range of int coordinates
+        BOUNDS Inflated( int64_t aMargin ) const
+        {
+            const int64_t lo = std::numeric_limits<int>::min();
+            const int64_t hi = std::numeric_limits<int>::max();
+
+            BOUNDS box( *this );
+
+            for( int axis = 0; axis < 2; axis++ )
+            {
+                box.m_min[axis] = (int) std::max( lo, (int64_t) m_min[axis] - aMargin );
+                box.m_max[axis] = (int) std::min( hi, (int64_t) m_max[axis] + aMargin );
+            }
+
+            return box;
+        }
+
+        bool Contains( const BOUNDS& aOther ) const
+        {
+            return m_min[0] <= aOther.m_min[0] && m_min[1] <= aOther.m_min[1]
+                   && m_max[0] >= aOther.m_max[0] && m_max[1] >= aOther.m_max[1];
+        }
+
+        int m_min[2];
+        int m_max[2];
+    };
+
+    /**
+     * Packed R-tree of the edges of all the contours of one polygon.
+     */
+    struct POLY_INDEX
     {
-        Outline( polygonIdx ).GenerateBBoxCache();
+        PACKED_RTREE<EDGE> m_tree;
+        BOUNDS             m_bbox;          ///< bounding box of all the edges
+        int64_t            m_edgeSize;      ///< mean size of the edge bounding boxes
+
+        POLY_INDEX( const POLYGON& aPoly ) :
+                m_edgeSize( 1 )
+        {
+            int64_t totalSize = 0;
+
+            for( int contour = 0; contour < (int) aPoly.size(); contour++ )
+            {
+                const SHAPE_LINE_CHAIN& chain = aPoly[contour];
+
+                for( int i = 0; i < chain.SegmentCount(); i++ )
+                {
+                    const BOUNDS edge( chain.CSegment( i ) );
+
+                    m_tree.Insert( edge.m_min, edge.m_max, EDGE{ contour, i } );
+                    totalSize += std::max( (int64_t) edge.m_max[0] - edge.m_min[0],
+                                           (int64_t) edge.m_max[1] - edge.m_min[1] );
+
+                    for( int axis = 0; axis < 2; axis++ )
+                    {
+                        m_bbox.m_min[axis] = std::min( m_bbox.m_min[axis], edge.m_min[axis] );
+                        m_bbox.m_max[axis] = std::max( m_bbox.m_max[axis], edge.m_max[axis] );
+                    }
+                }
+            }
+
+            m_tree.Build();
+
+            if( !m_tree.empty() )
+                m_edgeSize = std::max<int64_t>( 1, totalSize / (int64_t) m_tree.size() );
+        }
 
-        for( int holeIdx = 0; holeIdx < HoleCount( polygonIdx ); holeIdx++ )
-            Hole( polygonIdx, holeIdx ).GenerateBBoxCache();
+        /**
+         * Same as SHAPE_POLY_SET::containsSingle(), but only visits the edges crossed by a ray
+         * from \a aP towards +x (and, for an accuracy above 1, the edges near \a aP).
+         */
+        bool Contains( const POLYGON& aPoly, const VECTOR2I& aP, int aAccuracy ) const
+        {
+            const SHAPE_LINE_CHAIN& outline = aPoly[0];
+
+            if( !outline.IsClosed() || outline.PointCount() < 3 )
+                return false;
+
+            // Crossing parity of the ray for each contour, with the same test as
+            // SHAPE_LINE_CHAIN_BASE::PointInside()
+            std::vector<char> inside( aPoly.size(), 0 );
+
+            auto crossing =
+                    [&]( const EDGE& aEdge ) -> bool
+                    {
+                        const SEG  seg = aPoly[aEdge.m_contour].CSegment( aEdge.m_segment );
+                        const auto diff = seg.B - seg.A;
+
+                        if( diff.y != 0 )
+                        {
+                            const int d = rescale( diff.x, ( aP.y - seg.A.y ), diff.y );
+
+                            if( ( ( seg.A.y > aP.y ) != ( seg.B.y > aP.y ) )
+                                    && ( aP.x - seg.A.x < d ) )
+                            {
+                                inside[aEdge.m_contour] ^= 1;
+                            }
+                        }
+
+                        return true;
+                    };
+
+            const int rayMin[2] = { aP.x, aP.y };
+            const int rayMax[2] = { std::numeric_limits<int>::max(), aP.y };
+
+            m_tree.Search( rayMin, rayMax, crossing );
+
+            bool inOutline = inside[0];
+
+            // If accuracy is above 1, points close enough to an edge of the outline are inside
+            // too (see SHAPE_LINE_CHAIN_BASE::PointOnEdge())
+            if( !inOutline && aAccuracy > 1 )
+            {
+                auto onEdge =
+                        [&]( const EDGE& aEdge ) -> bool
+                        {
+                            if( aEdge.m_contour != 0 )
+                                return true;
+
+                            const SEG seg = outline.CSegment( aEdge.m_segment );
+
+                            if( seg.A == aP || seg.B == aP || seg.Distance( aP ) <= aAccuracy + 1 )
+                                inOutline = true;
+
+                            return !inOutline;
+                        };
+
+                const BOUNDS nearBox = BOUNDS( aP ).Inflated( (int64_t) aAccuracy + 2 );
+
+                m_tree.Search( nearBox.m_min, nearBox.m_max, onEdge );
+            }
+
+            if( !inOutline )
+                return false;
+
+            for( size_t hole = 1; hole < aPoly.size(); hole++ )
+            {
+                if( inside[hole] && aPoly[hole].IsClosed() && aPoly[hole].PointCount() >= 3 )
+                    return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * Find the edge nearest to \a aQuery (a VECTOR2I or a SEG).
+         *
+         * The search box around the query is grown until it contains an edge, and then once
+         * more to the distance of that edge so that no closer edge can be missed.
+         *
+         * @return the squared distance to the nearest edge (VECTOR2I::ECOORD_MAX if there are
+         *         no edges).
+         */
+        template <class QUERY>
+        SEG::ecoord NearestEdge( const POLYGON& aPoly, const QUERY& aQuery,
+                                 VECTOR2I* aNearest ) const
+        {
+            SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+            SEG         bestSeg;
+            bool        found = false;
+
+            if( m_tree.empty() )
+                return best;
+
+            auto visitor =
+                    [&]( const EDGE& aEdge ) -> bool
+                    {
+                        const SEG         seg = aPoly[aEdge.m_contour].CSegment( aEdge.m_segment );
+                        const SEG::ecoord dist = seg.SquaredDistance( aQuery );
+
+                        if( !found || dist < best )
+                        {
+                            best = dist;
+                            bestSeg = seg;
+                            found = true;
+                        }
+
+                        return best > 0;
+                    };
+
+            const BOUNDS query( aQuery );
+
+            // Start from the gap between the query and the polygon
+            int64_t margin = m_edgeSize;
+
+            for( int axis = 0; axis < 2; axis++ )
+            {
+                margin = std::max( margin, (int64_t) m_bbox.m_min[axis] - query.m_max[axis] );
+                margin = std::max( margin, (int64_t) query.m_min[axis] - m_bbox.m_max[axis] );
+            }
+
+            while( true )
+            {
+                const BOUNDS box = query.Inflated( margin );
+
+                m_tree.Search( box.m_min, box.m_max, visitor );
+
+                if( found )
+                    break;
+
+                if( box.Contains( m_bbox ) )
+                    return best;
+
+                margin *= 2;
+            }
+
+            // A closer edge has its bounding box within the distance of the best edge so far
+            const int64_t reach = (int64_t) std::sqrt( (double) best ) + 1;
+
+            if( best > 0 && reach > margin )
+            {
+                const BOUNDS box = query.Inflated( reach );
+
+                m_tree.Search( box.m_min, box.m_max, visitor );
+            }
+
+            if( aNearest )
+                *aNearest = bestSeg.NearestPoint( aQuery );
+
+            return best;
+        }
+    };
+
+    EDGE_INDEX( const SHAPE_POLY_SET& aSet )
+    {
+        m_polys.resize( aSet.OutlineCount() );
+
+        for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
+        {
+            const POLYGON& poly = aSet.CPolygon( ii );
+            int            vertices = 0;
+
+            for( const SHAPE_LINE_CHAIN& chain : poly )
+                vertices += chain.PointCount();
+
+            if( vertices >= EDGE_INDEX_MIN_POLY_VERTICES )
+                m_polys[ii] = std::make_unique<POLY_INDEX>( poly );
+        }
     }
+
+    ///< Index of each polygon of the set, or nullptr for polygons too small to be indexed
+    std::vector<std::unique_ptr<POLY_INDEX>> m_polys;
+};
+
+
+void SHAPE_POLY_SET::BuildEdgeIndex()
+{
+    if( TotalVertices() < EDGE_INDEX_MIN_SET_VERTICES )
+        m_edgeIndex.reset();
+    else
+        m_edgeIndex = std::make_shared<const EDGE_INDEX>( *this );
+}
+
+
+const SHAPE_POLY_SET::EDGE_INDEX* SHAPE_POLY_SET::edgeIndex() const
+{
+    // Every edit drops the index, so one that is still there is up to date
+    return m_edgeIndex.get();
 }
 
 
@@ -1527,14 +2328,16 @@ bool SHAPE_POLY_SET::Contains( const VECTOR2I& aP, int aSubpolyIndex, int aAccur
     if( m_polys.empty() )
         return false;
 
+    const EDGE_INDEX* index = edgeIndex();
+
     // If there is a polygon specified, check the condition against that polygon
     if( aSubpolyIndex >= 0 )
-        return containsSingle( aP, aSubpolyIndex, aAccuracy, aUseBBoxCaches );
+        return containsSingle( aP, aSubpolyIndex, aAccuracy, aUseBBoxCaches, index );
 
     // In any other case, check it against all polygons in the set
     for( int polygonIdx = 0; polygonIdx < OutlineCount(); polygonIdx++ )
     {
-        if( containsSingle( aP, polygonIdx, aAccuracy, aUseBBoxCaches ) )
+        if( containsSingle( aP, polygonIdx, aAccuracy, aUseBBoxCaches, index ) )
             return true;
     }
 
@@ -1556,6 +2359,8 @@ void SHAPE_POLY_SET::RemoveVertex( int aGlobalIndex )
 
 void SHAPE_POLY_SET::RemoveVertex( VERTEX_INDEX aIndex )
 {
+    invalidateEdgeIndex();
+
     m_polys[aIndex.m_polygon][aIndex.m_contour].Remove( aIndex.m_vertex );
 }
 
@@ -1573,13 +2378,22 @@ void SHAPE_POLY_SET::SetVertex( int aGlobalIndex, const VECTOR2I& aPos )
 
 void SHAPE_POLY_SET::SetVertex( const VERTEX_INDEX& aIndex, const VECTOR2I& aPos )
 {
+    invalidateEdgeIndex();
+
     m_polys[aIndex.m_polygon][aIndex.m_contour].SetPoint( aIndex.m_vertex, aPos );
 }
 
 
 bool SHAPE_POLY_SET::containsSingle( const VECTOR2I& aP, int aSubpolyIndex, int aAccuracy,
-                                     bool aUseBBoxCaches ) const
+                                     bool aUseBBoxCaches, const EDGE_INDEX* aEdgeIndex ) const
 {
+    // Large polygons of an indexed set only test the edges crossed by the ray
+    if( aEdgeIndex && aEdgeIndex->m_polys[aSubpolyIndex] )
+    {
+        return aEdgeIndex->m_polys[aSubpolyIndex]->Contains( m_polys[aSubpolyIndex], aP,
+                                                             aAccuracy );
+    }
+
     // Check that the point is inside the outline
     if( m_polys[aSubpolyIndex][0].PointInside( aP, aAccuracy ) )
     {
@@ -1603,6 +2417,8 @@ bool SHAPE_POLY_SET::containsSingle( const VECTOR2I& aP, int aSubpolyIndex, int
 
 void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
 {
+    invalidateEdgeIndex();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -1618,6 +2434,8 @@ void SHAPE_POLY_SET::Move( const VECTOR2I& aVector )
 
 void SHAPE_POLY_SET::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 {
+    invalidateEdgeIndex();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -1631,6 +2449,8 @@ void SHAPE_POLY_SET::Mirror( bool aX, bool aY, const VECTOR2I& aRef )
 
 void SHAPE_POLY_SET::Rotate( double aAngle, const VECTOR2I& aCenter )
 {
+    invalidateEdgeIndex();
+
     for( POLYGON& poly : m_polys )
     {
         for( SHAPE_LINE_CHAIN& path : poly )
@@ -1672,12 +2492,20 @@ SHAPE_POLY_SET::POLYGON SHAPE_POLY_SET::FilletPolygon( unsigned int aRadius, int
 
 SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( VECTOR2I aPoint, int aPolygonIndex,
                                                       VECTOR2I* aNearest ) const
+{
+    return squaredDistanceToPolygon( aPoint, aPolygonIndex, aNearest, edgeIndex() );
+}
+
+
+SEG::ecoord SHAPE_POLY_SET::squaredDistanceToPolygon( const VECTOR2I& aPoint, int aPolygonIndex,
+                                                      VECTOR2I* aNearest,
+                                                      const EDGE_INDEX* aEdgeIndex ) const
 {
     // We calculate the min dist between the segment and each outline segment.  However, if the
     // segment to test is inside the outline, and does not cross any edge, it can be seen outside
     // the polygon.  Therefore test if a segment end is inside (testing only one end is enough).
     // Use an accuracy of "1" to say that we don't care if it's exactly on the edge or not.
-    if( containsSingle( aPoint, aPolygonIndex, 1 ) )
+    if( containsSingle( aPoint, aPolygonIndex, 1, false, aEdgeIndex ) )
     {
         if( aNearest )
             *aNearest = aPoint;
@@ -1685,10 +2513,19 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( VECTOR2I aPoint, int aPoly
         return 0;
     }
 
+    if( aEdgeIndex && aEdgeIndex->m_polys[aPolygonIndex] )
+    {
+        return aEdgeIndex->m_polys[aPolygonIndex]->NearestEdge( m_polys[aPolygonIndex], aPoint,
+                                                                aNearest );
+    }
+
     CONST_SEGMENT_ITERATOR iterator = CIterateSegmentsWithHoles( aPolygonIndex );
 
     SEG::ecoord minDistance = (*iterator).SquaredDistance( aPoint );
 
+    if( aNearest )
+        *aNearest = (*iterator).NearestPoint( aPoint );
+
     for( iterator++; iterator && minDistance > 0; iterator++ )
     {
         SEG::ecoord currentDistance = (*iterator).SquaredDistance( aPoint );
@@ -1708,12 +2545,20 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( VECTOR2I aPoint, int aPoly
 
 SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( const SEG& aSegment, int aPolygonIndex,
                                                       VECTOR2I* aNearest ) const
+{
+    return squaredDistanceToPolygon( aSegment, aPolygonIndex, aNearest, edgeIndex() );
+}
+
+
+SEG::ecoord SHAPE_POLY_SET::squaredDistanceToPolygon( const SEG& aSegment, int aPolygonIndex,
+                                                      VECTOR2I* aNearest,
+                                                      const EDGE_INDEX* aEdgeIndex ) const
 {
     // We calculate the min dist between the segment and each outline segment.  However, if the
     // segment to test is inside the outline, and does not cross any edge, it can be seen outside
     // the polygon.  Therefore test if a segment end is inside (testing only one end is enough).
     // Use an accuracy of "1" to say that we don't care if it's exactly on the edge or not.
-    if( containsSingle( aSegment.A, aPolygonIndex, 1 ) )
+    if( containsSingle( aSegment.A, aPolygonIndex, 1, false, aEdgeIndex ) )
     {
         if( aNearest )
             *aNearest = ( aSegment.A + aSegment.B ) / 2;
@@ -1721,9 +2566,18 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistanceToPolygon( const SEG& aSegment, int a
         return 0;
     }
 
+    if( aEdgeIndex && aEdgeIndex->m_polys[aPolygonIndex] )
+    {
+        return aEdgeIndex->m_polys[aPolygonIndex]->NearestEdge( m_polys[aPolygonIndex], aSegment,
+                                                                aNearest );
+    }
+
     CONST_SEGMENT_ITERATOR iterator = CIterateSegmentsWithHoles( aPolygonIndex );
     SEG::ecoord            minDistance = (*iterator).SquaredDistance( aSegment );
 
+    if( aNearest )
+        *aNearest = (*iterator).NearestPoint( aSegment );
+
     for( iterator++; iterator && minDistance > 0; iterator++ )
     {
         SEG::ecoord currentDistance = (*iterator).SquaredDistance( aSegment );
@@ -1748,11 +2602,14 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistance( VECTOR2I aPoint, VECTOR2I* aNearest
     SEG::ecoord minDistance_sq = VECTOR2I::ECOORD_MAX;
     VECTOR2I    nearest;
 
+    const EDGE_INDEX* index = edgeIndex();
+
     // Iterate through all the polygons and get the minimum distance.
     for( unsigned int polygonIdx = 0; polygonIdx < m_polys.size(); polygonIdx++ )
     {
-        currentDistance_sq = SquaredDistanceToPolygon( aPoint, polygonIdx,
-                                                       aNearest ? &nearest : nullptr );
+        currentDistance_sq = squaredDistanceToPolygon( aPoint, polygonIdx,
+                                                       aNearest ? &nearest : nullptr,
+                                                       index );
 
         if( currentDistance_sq < minDistance_sq )
         {
@@ -1773,11 +2630,14 @@ SEG::ecoord SHAPE_POLY_SET::SquaredDistance( const SEG& aSegment, VECTOR2I* aNea
     SEG::ecoord minDistance_sq = VECTOR2I::ECOORD_MAX;
     VECTOR2I    nearest;
 
+    const EDGE_INDEX* index = edgeIndex();
+
     // Iterate through all the polygons and get the minimum distance.
     for( unsigned int polygonIdx = 0; polygonIdx < m_polys.size(); polygonIdx++ )
     {
-        currentDistance_sq = SquaredDistanceToPolygon( aSegment, polygonIdx,
-                                                       aNearest ? &nearest : nullptr );
+        currentDistance_sq = squaredDistanceToPolygon( aSegment, polygonIdx,
+                                                       aNearest ? &nearest : nullptr,
+                                                       index );
 
         if( currentDistance_sq < minDistance_sq )
         {
@@ -1992,6 +2852,7 @@ SHAPE_POLY_SET &SHAPE_POLY_SET::operator=( const SHAPE_POLY_SET& aOther )
 {
     static_cast<SHAPE&>(*this) = aOther;
     m_polys = aOther.m_polys;
+    m_edgeIndex = aOther.m_edgeIndex;
     m_triangulatedPolys.clear();
     m_triangulationValid = false;
 
@@ -2033,6 +2894,10 @@ bool SHAPE_POLY_SET::IsTriangulationUpToDate() const
 }
 
 
+///< Sets with fewer vertices than this are triangulated by the calling thread only
+static const int PARALLEL_TRIANGULATION_MIN_VERTICES = 20000;
+
+
 static void partitionPolyIntoRegularCellGrid( const SHAPE_POLY_SET& aPoly, int aSize,
                                               SHAPE_POLY_SET& aOut )
 {
@@ -2103,7 +2968,7 @@ static void partitionPolyIntoRegularCellGrid( const SHAPE_POLY_SET& aPoly, int a
 }
 
 
-void SHAPE_POLY_SET::CacheTriangulation( bool aPartition )
+void SHAPE_POLY_SET::CacheTriangulation( bool aPartition, size_t aMaxThreads )
 {
     bool recalculate = !m_hash.IsValid();
     MD5_HASH hash;
@@ -2145,21 +3010,66 @@ void SHAPE_POLY_SET::CacheTriangulation( bool aPartition )
 
     while( tmpSet.OutlineCount() > 0 )
     {
-        m_triangulatedPolys.push_back( std::make_unique<TRIANGULATED_POLYGON>() );
-        PolygonTriangulation tess( *m_triangulatedPolys.back() );
+        const size_t count = tmpSet.OutlineCount();
+
+        std::vector<std::unique_ptr<TRIANGULATED_POLYGON>> results( count );
+        std::vector<char>                                   succeeded( count, 0 );
+        std::atomic<size_t>                                 nextPoly( 0 );
+
+        // The polygons (or grid cells) are independent, so large sets are triangulated by
+        // several threads.  Each thread reuses one vertex arena for all its polygons.
+        auto triangulate =
+                [&]()
+                {
+                    PolygonTriangulation::VertexArena arena;
+
+                    for( size_t ii = nextPoly++; ii < count; ii = nextPoly++ )
+                    {
+                        results[ii] = std::make_unique<TRIANGULATED_POLYGON>();
+                        PolygonTriangulation tess( *results[ii], &arena );
+
+                        succeeded[ii] = tess.TesselatePolygon( tmpSet.CPolygon( ii ).front() );
+                    }
+                };
+
+        size_t threadCount = 1;
+
+        if( count > 1 && tmpSet.TotalVertices() >= PARALLEL_TRIANGULATION_MIN_VERTICES )
+        {
+            threadCount = aMaxThreads ? aMaxThreads : std::thread::hardware_concurrency();
+            threadCount = std::max<size_t>( 1, std::min( threadCount, count ) );
+        }
+
+        std::vector<std::future<void>> workers;
+
+        for( size_t ii = 1; ii < threadCount; ii++ )
+            workers.push_back( std::async( std::launch::async, triangulate ) );
+
+        triangulate();
+
+        // get() rethrows anything a worker threw
+        for( std::future<void>& worker : workers )
+            worker.get();
 
         // If the tesselation fails, we re-fracture the polygon, which will
         // first simplify the system before fracturing and removing the holes
         // This may result in multiple, disjoint polygons.
-        if( !tess.TesselatePolygon( tmpSet.Polygon( 0 ).front() ) )
+        SHAPE_POLY_SET failed;
+
+        for( size_t ii = 0; ii < count; ii++ )
         {
-            tmpSet.Fracture( PM_FAST );
-            m_triangulationValid = false;
-            continue;
+            if( succeeded[ii] )
+                m_triangulatedPolys.push_back( std::move( results[ii] ) );
+            else
+                failed.m_polys.push_back( tmpSet.CPolygon( ii ) );
         }
 
-        tmpSet.DeletePolygon( 0 );
-        m_triangulationValid = true;
+        m_triangulationValid = failed.m_polys.empty();
+
+        if( !m_triangulationValid )
+            failed.Fracture( PM_FAST );
+
+        tmpSet = failed;
     }
 
     if( m_triangulationValid )
@@ -0,0 +1,178 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <board_image_renderer.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <track.h>
+#include <zone.h>
+#include <pcb_draw_panel_gal.h>
+#include <pcb_painter.h>
+#include <pcb_view.h>
+#include <settings/color_settings.h>
+#include <zoom_defines.h>
+
+#include <gal/cairo/cairo_gal.h>
+
+#include <vector>
+
+
+BOARD_IMAGE_RENDERER::BOARD_IMAGE_RENDERER( int aWidth, int aHeight,
+                                            const COLOR_SETTINGS* aColors ) :
+        m_width( aWidth ),
+        m_height( aHeight )
+{
+    m_surface = cairo_image_surface_create( CAIRO_FORMAT_ARGB32, aWidth, aHeight );
+
+    m_gal = std::make_unique<KIGFX::CAIRO_IMAGE_GAL>( m_options, m_surface );
+    m_gal->SetWorldUnitLength( 1e-9 /* 1 nm */ / 0.0254 /* 1 inch in meters */ );
+
+    m_painter = std::make_unique<KIGFX::PCB_PAINTER>( m_gal.get() );
+
+    if( aColors )
+    {
+        m_painter->GetSettings()->LoadColors( aColors );
+    }
+    else
+    {
+        COLOR_SETTINGS defaultColors;
+        defaultColors.ResetToDefaults();
+        m_painter->GetSettings()->LoadColors( &defaultColors );
+    }
+
+    m_view = std::make_unique<KIGFX::PCB_VIEW>( true );
+    m_view->SetGAL( m_gal.get() );
+    m_view->SetPainter( m_painter.get() );
+    m_view->SetScaleLimits( ZOOM_MAX_LIMIT_PCBNEW, ZOOM_MIN_LIMIT_PCBNEW );
+
+    PCB_DRAW_PANEL_GAL::SetDefaultLayerOrder( m_view.get() );
+    PCB_DRAW_PANEL_GAL::SetDefaultLayerDeps( m_view.get(), EDA_DRAW_PANEL_GAL::GAL_TYPE_CAIRO );
+}
+
+
+BOARD_IMAGE_RENDERER::~BOARD_IMAGE_RENDERER()
+{
+    m_view.reset();
+    m_painter.reset();
+    m_gal.reset();
+
+    // The GAL held its own reference to the surface
+    cairo_surface_destroy( m_surface );
+}
+
+
+bool BOARD_IMAGE_RENDERER::Render( BOARD* aBoard )
+{
+    return Render( aBoard, aBoard->GetBoundingBox() );
+}
+
+
+bool BOARD_IMAGE_RENDERER::Render( BOARD* aBoard, const BOX2I& aArea )
+{
+    // Same items as PCB_DRAW_PANEL_GAL::DisplayBoard(), without the markers and the ratsnest
+    std::vector<KIGFX::VIEW_ITEM*> items;
+
+    for( BOARD_ITEM* drawing : aBoard->Drawings() )
+        items.push_back( drawing );
+
+    for( TRACK* track : aBoard->Tracks() )
+        items.push_back( track );
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+        items.push_back( footprint );
+
+    for( ZONE* zone : aBoard->Zones() )
+        items.push_back( zone );
+
+    for( KIGFX::VIEW_ITEM* item : items )
+    {
+        bool onOtherView = m_view->IsOnOtherView( item );
+
+        if( FOOTPRINT* footprint = dynamic_cast<FOOTPRINT*>( item ) )
+        {
+            footprint->RunOnChildren(
+                    [&]( BOARD_ITEM* aChild )
+                    {
+                        onOtherView |= m_view->IsOnOtherView( aChild );
+                    } );
+        }
+
+        if( onOtherView )
+        {
+            // Don't leave the previous board's image behind to be taken for this one
+            clearSurface();
+
+            wxFAIL_MSG( "Cannot render a board whose items are shown by another view" );
+            return false;
+        }
+    }
+
+    m_view->Add( items );
+
+    PCB_DRAW_PANEL_GAL::SyncLayersVisibility( m_view.get(), aBoard );
+
+    // Leave a small margin around the area
+    BOX2D viewport( VECTOR2D( aArea.GetPosition() ), VECTOR2D( aArea.GetSize() ) );
+    viewport.Inflate( aArea.GetWidth() / 50.0, aArea.GetHeight() / 50.0 );
+
+    m_view->SetViewport( viewport );
+    m_view->UpdateItems();
+
+    {
+        KIGFX::GAL_DRAWING_CONTEXT ctx( m_gal.get() );
+
+        m_gal->SetClearColor( m_painter->GetSettings()->GetBackgroundColor() );
+        m_gal->ClearScreen();
+
+        m_view->MarkDirty();
+        m_view->ClearTargets();
+        m_view->Redraw();
+    }
+
+    cairo_surface_flush( m_surface );
+
+    // Detach the items from the view, so that the board and the renderer can be deleted in
+    // any order
+    m_view->Clear();
+
+    return true;
+}
+
+
+void BOARD_IMAGE_RENDERER::clearSurface()
+{
+    cairo_t* cr = cairo_create( m_surface );
+
+    cairo_set_operator( cr, CAIRO_OPERATOR_CLEAR );
+    cairo_paint( cr );
+    cairo_destroy( cr );
+
+    cairo_surface_flush( m_surface );
+}
+
+
+bool BOARD_IMAGE_RENDERER::SavePNG( const wxString& aFileName ) const
+{
+    return cairo_surface_write_to_png( m_surface, aFileName.fn_str() ) == CAIRO_STATUS_SUCCESS;
+}
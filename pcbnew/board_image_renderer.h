@@ -0,0 +1,112 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef BOARD_IMAGE_RENDERER_H_
+#define BOARD_IMAGE_RENDERER_H_
+
+#include <gal/gal_display_options.h>
+#include <math/box2.h>
+
+#include <memory>
+
+#include <cairo.h>
+#include <wx/string.h>
+
+class BOARD;
+class COLOR_SETTINGS;
+
+namespace KIGFX
+{
+    class CAIRO_IMAGE_GAL;
+    class PCB_PAINTER;
+    class PCB_VIEW;
+}
+
+/**
+ * Render boards to images without any window, using the Cairo GAL on an image surface and
+ * the same view and painter as the board editor canvas.
+ *
+ * One renderer can draw any number of boards one after the other; the image of the last
+ * board drawn stays available until the next Render() call.
+ */
+class BOARD_IMAGE_RENDERER
+{
+public:
+    /**
+     * @param aWidth, aHeight are the size of the images in pixels.
+     * @param aColors is the color theme to use; the default colors are used if not given.
+     */
+    BOARD_IMAGE_RENDERER( int aWidth, int aHeight, const COLOR_SETTINGS* aColors = nullptr );
+
+    ~BOARD_IMAGE_RENDERER();
+
+    /**
+     * Draw the whole board, fitted to the image.
+     *
+     * @return false if the board could not be drawn; the image is then left blank.
+     */
+    bool Render( BOARD* aBoard );
+
+    /**
+     * Draw the part of the board inside \a aArea, fitted to the image.
+     *
+     * The board must not be shown by any other view (such as an editor canvas) at the same
+     * time: its items are added to the renderer's view while drawing, which would take them
+     * away from the other view.
+     *
+     * The board is no longer referred to once this returns, so it may be deleted or
+     * modified right after.
+     *
+     * @return false if the board is shown by another view; the image is then left blank.
+     */
+    bool Render( BOARD* aBoard, const BOX2I& aArea );
+
+    /**
+     * Write the image of the last board drawn to a PNG file.
+     *
+     * @return true if the file was written.
+     */
+    bool SavePNG( const wxString& aFileName ) const;
+
+    ///< The image surface drawn to, in CAIRO_FORMAT_ARGB32
+    cairo_surface_t* GetSurface() const { return m_surface; }
+
+    int GetWidth() const { return m_width; }
+    int GetHeight() const { return m_height; }
+
+    KIGFX::PCB_VIEW* GetView() const { return m_view.get(); }
+
+private:
+    ///< Make the whole image transparent
+    void clearSurface();
+
+    int                                     m_width;
+    int                                     m_height;
+    cairo_surface_t*                        m_surface;
+    KIGFX::GAL_DISPLAY_OPTIONS              m_options;
+    std::unique_ptr<KIGFX::CAIRO_IMAGE_GAL> m_gal;
+    std::unique_ptr<KIGFX::PCB_PAINTER>     m_painter;
+    std::unique_ptr<KIGFX::PCB_VIEW>        m_view;
+};
+
+#endif /* BOARD_IMAGE_RENDERER_H_ */
@@ -605,6 +605,48 @@ void PAD::TransformShapeWithClearanceToPolygon( SHAPE_POLY_SET& aCornerBuffer,
 {
     wxASSERT_MSG( !ignoreLineWidth, "IgnoreLineWidth has no meaning for pads." );
 
+    // A pad is only ever asked for a few combinations of clearance and error, so there is no
+    // need for an eviction policy beyond a bound on the number of entries.
+    const size_t maxCachedPolys = 8;
+
+    std::lock_guard<std::mutex> RAII_lock( m_clearancePolysLock );
+
+    if( m_clearancePolysRevision != m_geometryRevision )
+    {
+        m_clearancePolys.clear();
+        m_clearancePolysRevision = m_geometryRevision;
+    }
+
+    // Only the primitives of custom pads depend on the layer, and they are merged with the
+    // board's max error rather than aError (see MergePrimitivesAsPolygon())
+    CLEARANCE_POLY_KEY key = { UNDEFINED_LAYER, aClearanceValue, aError, aErrorLoc, 0 };
+
+    if( GetShape() == PAD_SHAPE_CUSTOM )
+    {
+        BOARD* board = GetBoard();
+
+        key.m_layer = aLayer;
+        key.m_boardMaxError = board ? board->GetDesignSettings().m_MaxError : ARC_HIGH_DEF;
+    }
+
+    auto it = m_clearancePolys.find( key );
+
+    if( it == m_clearancePolys.end() )
+    {
+        if( m_clearancePolys.size() >= maxCachedPolys )
+            m_clearancePolys.clear();
+
+        it = m_clearancePolys.emplace( key, SHAPE_POLY_SET() ).first;
+        buildClearancePolygon( it->second, aClearanceValue, aError, aErrorLoc, aLayer );
+    }
+
+    aCornerBuffer.Append( it->second );
+}
+
+
+void PAD::buildClearancePolygon( SHAPE_POLY_SET& aCornerBuffer, int aClearanceValue,
+                                 int aError, ERROR_LOC aErrorLoc, PCB_LAYER_ID aLayer ) const
+{
     // minimal segment count to approximate a circle to create the polygonal pad shape
     // This minimal value is mainly for very small pads, like SM0402.
     // Most of time pads are using the segment count given by aError value.
@@ -34,6 +34,7 @@
 #include <connectivity/connectivity_data.h>
 #include <connectivity/connectivity_algo.h>
 #include <connectivity/from_to_cache.h>
+#include <connectivity/net_length_cache.h>
 
 #include <ratsnest/ratsnest_data.h>
 
@@ -42,12 +43,14 @@ CONNECTIVITY_DATA::CONNECTIVITY_DATA()
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO );
     m_progressReporter = nullptr;
     m_fromToCache.reset( new FROM_TO_CACHE );
+    m_netLengthCache.reset( new NET_LENGTH_CACHE );
 }
 
 
 CONNECTIVITY_DATA::CONNECTIVITY_DATA( const std::vector<BOARD_ITEM*>& aItems, bool aSkipRatsnest )
     : m_skipRatsnest( aSkipRatsnest )
 {
+    m_netLengthCache.reset( new NET_LENGTH_CACHE );
     Build( aItems );
     m_progressReporter = nullptr;
     m_fromToCache.reset( new FROM_TO_CACHE );
@@ -63,6 +66,7 @@ CONNECTIVITY_DATA::~CONNECTIVITY_DATA()
 bool CONNECTIVITY_DATA::Add( BOARD_ITEM* aItem )
 {
     m_connAlgo->Add( aItem );
+    m_netLengthCache->InvalidateItem( aItem );
     return true;
 }
 
@@ -70,6 +74,7 @@ bool CONNECTIVITY_DATA::Add( BOARD_ITEM* aItem )
 bool CONNECTIVITY_DATA::Remove( BOARD_ITEM* aItem )
 {
     m_connAlgo->Remove( aItem );
+    m_netLengthCache->Forget( aItem );
     return true;
 }
 
@@ -78,6 +83,7 @@ bool CONNECTIVITY_DATA::Update( BOARD_ITEM* aItem )
 {
     m_connAlgo->Remove( aItem );
     m_connAlgo->Add( aItem );
+    m_netLengthCache->InvalidateItem( aItem );
     return true;
 }
 
@@ -86,6 +92,7 @@ void CONNECTIVITY_DATA::Build( BOARD* aBoard, PROGRESS_REPORTER* aReporter )
 {
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO );
     m_connAlgo->Build( aBoard, aReporter );
+    m_netLengthCache->InvalidateAll();
 
     m_netclassMap.clear();
 
@@ -101,6 +108,7 @@ void CONNECTIVITY_DATA::Build( const std::vector<BOARD_ITEM*>& aItems )
 {
     m_connAlgo.reset( new CN_CONNECTIVITY_ALGO );
     m_connAlgo->Build( aItems );
+    m_netLengthCache->InvalidateAll();
 
     RecalculateRatsnest();
 }
@@ -192,6 +200,7 @@ void CONNECTIVITY_DATA::RecalculateRatsnest( BOARD_COMMIT* aCommit  )
         if( m_connAlgo->IsNetDirty( net ) )
         {
             m_nets[net]->Clear();
+            m_netLengthCache->Invalidate( net );
             dirtyNets++;
         }
     }
@@ -700,6 +709,14 @@ void CONNECTIVITY_DATA::MarkItemNetAsDirty( BOARD_ITEM *aItem )
     {
         m_connAlgo->MarkNetAsDirty( static_cast<BOARD_CONNECTED_ITEM*>( aItem )->GetNetCode() );
     }
+
+    m_netLengthCache->InvalidateItem( aItem );
+}
+
+
+NET_LENGTH_CACHE::ENTRY CONNECTIVITY_DATA::GetNetLength( int aNetCode )
+{
+    return m_netLengthCache->Get( *m_connAlgo, aNetCode );
 }
 
 
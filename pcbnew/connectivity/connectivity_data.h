@@ -39,6 +39,8 @@
 #include <geometry/shape_poly_set.h>
 #include <zone.h>
 
+#include <connectivity/net_length_cache.h>
+
 class FROM_TO_CACHE;
 class CN_CLUSTER;
 class CN_CONNECTIVITY_ALGO;
@@ -287,6 +289,15 @@ public:
         return m_fromToCache;
     }
 
+#ifndef SWIG
+    /**
+     * Return the routed length totals of a net.  The totals are cached and only the nets
+     * touched by Add(), Remove(), Update() or net propagation since the last call are summed
+     * again.
+     */
+    NET_LENGTH_CACHE::ENTRY GetNetLength( int aNetCode );
+#endif
+
 private:
 
     void    updateRatsnest();
@@ -301,6 +312,7 @@ private:
 
     std::shared_ptr<CN_CONNECTIVITY_ALGO> m_connAlgo;
     std::shared_ptr<FROM_TO_CACHE> m_fromToCache;
+    std::shared_ptr<NET_LENGTH_CACHE> m_netLengthCache;
     std::vector<RN_DYNAMIC_LINE> m_dynamicRatsnest;
     std::vector<RN_NET*> m_nets;
 
@@ -0,0 +1,195 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstdlib>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <track.h>
+
+#include <connectivity/connectivity_algo.h>
+#include <connectivity/net_length_cache.h>
+
+
+int64_t NET_LENGTH_CACHE::ENTRY::ViaLength( const BOARD* aBoard ) const
+{
+    int64_t length = 0;
+
+    for( const std::pair<const std::pair<PCB_LAYER_ID, PCB_LAYER_ID>, int>& span : viaSpans )
+        length += (int64_t) span.second * ViaSpanLength( aBoard, span.first.first,
+                                                         span.first.second );
+
+    return length;
+}
+
+
+void NET_LENGTH_CACHE::InvalidateItem( BOARD_ITEM* aItem )
+{
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+    {
+        for( PAD* pad : static_cast<FOOTPRINT*>( aItem )->Pads() )
+            InvalidateItem( pad );
+    }
+    else if( aItem->IsConnected() )
+    {
+        BOARD_CONNECTED_ITEM* item = static_cast<BOARD_CONNECTED_ITEM*>( aItem );
+        auto                  counted = m_itemNets.find( item );
+
+        if( counted != m_itemNets.end() )
+            Invalidate( counted->second );
+
+        Invalidate( item->GetNetCode() );
+    }
+}
+
+
+void NET_LENGTH_CACHE::Forget( BOARD_ITEM* aItem )
+{
+    InvalidateItem( aItem );
+
+    if( aItem->Type() == PCB_FOOTPRINT_T )
+    {
+        for( PAD* pad : static_cast<FOOTPRINT*>( aItem )->Pads() )
+            m_itemNets.erase( pad );
+    }
+    else if( aItem->IsConnected() )
+    {
+        m_itemNets.erase( static_cast<BOARD_CONNECTED_ITEM*>( aItem ) );
+    }
+}
+
+
+const NET_LENGTH_CACHE::ENTRY& NET_LENGTH_CACHE::Get( const CN_CONNECTIVITY_ALGO& aAlgo,
+                                                      int aNetCode )
+{
+    static const ENTRY empty;
+
+    if( m_allInvalid || !m_invalidNets.empty() )
+        refresh( aAlgo );
+
+    auto it = m_nets.find( aNetCode );
+
+    return it != m_nets.end() ? it->second : empty;
+}
+
+
+void NET_LENGTH_CACHE::refresh( const CN_CONNECTIVITY_ALGO& aAlgo )
+{
+    if( m_allInvalid )
+    {
+        m_nets.clear();
+        m_itemNets.clear();
+    }
+    else
+    {
+        for( int net : m_invalidNets )
+            m_nets.erase( net );
+    }
+
+    aAlgo.ForEachItem(
+            [&]( CN_ITEM& aItem )
+            {
+                if( !aItem.Valid() )
+                    return;
+
+                BOARD_CONNECTED_ITEM* parent = aItem.Parent();
+                KICAD_T               type = parent->Type();
+
+                if( type != PCB_TRACE_T && type != PCB_ARC_T && type != PCB_VIA_T
+                        && type != PCB_PAD_T )
+                {
+                    return;
+                }
+
+                int net = parent->GetNetCode();
+
+                if( !m_allInvalid && !m_invalidNets.count( net ) )
+                    return;
+
+                ENTRY& entry = m_nets[net];
+                m_itemNets[parent] = net;
+
+                if( type == PCB_PAD_T )
+                {
+                    entry.padToDieLength += static_cast<PAD*>( parent )->GetPadToDieLength();
+                }
+                else if( type == PCB_VIA_T )
+                {
+                    const VIA* via = static_cast<VIA*>( parent );
+
+                    entry.routedCount++;
+                    entry.viaCount++;
+                    entry.viaSpans[ { via->TopLayer(), via->BottomLayer() } ]++;
+                }
+                else
+                {
+                    entry.routedCount++;
+                    entry.trackLength += static_cast<TRACK*>( parent )->GetLength();
+                }
+            } );
+
+    m_invalidNets.clear();
+    m_allInvalid = false;
+}
+
+
+int NET_LENGTH_CACHE::ViaSpanLength( const BOARD* aBoard, PCB_LAYER_ID aTop,
+                                     PCB_LAYER_ID aBottom )
+{
+    const BOARD_DESIGN_SETTINGS& bds = aBoard->GetDesignSettings();
+
+    // calculate the via length individually from the board stackup and via's start and end layer.
+    if( bds.m_HasStackup )
+    {
+        const BOARD_STACKUP& stackup = bds.GetStackupDescriptor();
+
+        std::pair<PCB_LAYER_ID, int> layer_dist[2] = { std::make_pair( aTop, 0 ),
+                                                       std::make_pair( aBottom, 0 ) };
+
+        for( const BOARD_STACKUP_ITEM* i : stackup.GetList() )
+        {
+            for( std::pair<PCB_LAYER_ID, int>& j : layer_dist )
+            {
+                if( j.first != UNDEFINED_LAYER )
+                    j.second += i->GetThickness();
+
+                if( j.first == i->GetBrdLayerId() )
+                    j.first = UNDEFINED_LAYER;
+            }
+        }
+
+        return std::abs( layer_dist[0].second - layer_dist[1].second );
+    }
+    else
+    {
+        int dielectricLayers = bds.GetCopperLayerCount() - 1;
+        int layerThickness = bds.GetBoardThickness() / dielectricLayers;
+        int effectiveBottomLayer;
+
+        if( aBottom == B_Cu )
+            effectiveBottomLayer = F_Cu + dielectricLayers;
+        else
+            effectiveBottomLayer = aBottom;
+
+        int layerCount = effectiveBottomLayer - aTop;
+
+        return layerCount * layerThickness;
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License as published by the
+ * Free Software Foundation, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but
+ * WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef __NET_LENGTH_CACHE_H
+#define __NET_LENGTH_CACHE_H
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <utility>
+
+#include <layers_id_colors_and_visibility.h>
+
+class BOARD;
+class BOARD_CONNECTED_ITEM;
+class BOARD_ITEM;
+class CN_CONNECTIVITY_ALGO;
+
+/**
+ * Per-net routed length totals, shared by the net inspector and the matched length DRC.
+ *
+ * The owning CONNECTIVITY_DATA invalidates the nets of every item it adds, removes or updates,
+ * and the nets that net propagation marks dirty when a commit recalculates the ratsnest.  A
+ * query recomputes all invalid nets in a single pass over the connectivity items, so editing a
+ * few tracks of a bus only re-sums the nets of those tracks.
+ */
+class NET_LENGTH_CACHE
+{
+public:
+    struct ENTRY
+    {
+        int64_t trackLength    = 0;  ///< Summed length of the tracks and arcs
+        int64_t padToDieLength = 0;
+        int     routedCount    = 0;  ///< Number of tracks, arcs and vias
+        int     viaCount       = 0;
+
+        /// Via count per (top, bottom) layer span, so that the via length follows the stackup
+        std::map<std::pair<PCB_LAYER_ID, PCB_LAYER_ID>, int> viaSpans;
+
+        /**
+         * @return the summed length of the vias, measured through the current stackup of
+         *         \a aBoard.
+         */
+        int64_t ViaLength( const BOARD* aBoard ) const;
+    };
+
+    NET_LENGTH_CACHE() :
+            m_allInvalid( true )
+    {
+    }
+
+    /**
+     * Mark the nets of \a aItem (or of its pads, for a footprint) as invalid, including the
+     * net it was counted in if that has since changed.
+     */
+    void InvalidateItem( BOARD_ITEM* aItem );
+
+    void Invalidate( int aNetCode )
+    {
+        m_invalidNets.insert( aNetCode );
+    }
+
+    void InvalidateAll()
+    {
+        m_allInvalid = true;
+    }
+
+    /**
+     * Forget \a aItem, which is about to leave the connectivity data.
+     */
+    void Forget( BOARD_ITEM* aItem );
+
+    /**
+     * @return the totals of \a aNetCode, recomputing the invalid nets from \a aAlgo first.
+     */
+    const ENTRY& Get( const CN_CONNECTIVITY_ALGO& aAlgo, int aNetCode );
+
+    /**
+     * @return the length of a via going from \a aTop to \a aBottom through the stackup of
+     *         \a aBoard, or through evenly spaced layers if the board has no stackup.
+     */
+    static int ViaSpanLength( const BOARD* aBoard, PCB_LAYER_ID aTop, PCB_LAYER_ID aBottom );
+
+private:
+    void refresh( const CN_CONNECTIVITY_ALGO& aAlgo );
+
+    std::map<int, ENTRY> m_nets;
+    std::set<int>        m_invalidNets;
+    bool                 m_allInvalid;
+
+    /// Net each item was counted in, to invalidate it when the item moves to another net
+    std::unordered_map<const BOARD_CONNECTED_ITEM*, int> m_itemNets;
+};
+
+#endif
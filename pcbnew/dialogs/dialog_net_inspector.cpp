@@ -34,7 +34,6 @@
 #include <view/view_controls.h>
 #include <pcb_painter.h>
 #include <connectivity/connectivity_data.h>
-#include <connectivity/connectivity_algo.h>
 #include <dialogs/dialog_text_entry.h>
 #include <validators.h>
 #include <bitmaps.h>
@@ -1011,51 +1010,6 @@ bool DIALOG_NET_INSPECTOR::netFilterMatches( NETINFO_ITEM* aNet ) const
 }
 
 
-struct NETCODE_CMP_LESS
-{
-    bool operator()( const CN_ITEM* a, const CN_ITEM* b ) const
-    {
-        return a->Net() < b->Net();
-    }
-
-    bool operator()( const CN_ITEM* a, int b ) const
-    {
-        return a->Net() < b;
-    }
-
-    bool operator()( int a, const CN_ITEM* b ) const
-    {
-        return a < b->Net();
-    }
-};
-
-
-std::vector<CN_ITEM*> DIALOG_NET_INSPECTOR::relevantConnectivityItems() const
-{
-    // pre-filter the connectivity items and sort them by netcode.
-    // this avoids quadratic runtime when building the whole net list and
-    // calculating the total length for each net.
-
-    const auto type_bits = std::bitset<MAX_STRUCT_TYPE_ID>()
-            .set( PCB_TRACE_T )
-            .set( PCB_VIA_T )
-            .set( PCB_PAD_T );
-
-    std::vector<CN_ITEM*> cn_items;
-    cn_items.reserve( 1024 );
-
-    for( CN_ITEM* cn_item : m_brd->GetConnectivity()->GetConnectivityAlgo()->ItemList() )
-    {
-        if( cn_item->Valid() && type_bits[cn_item->Parent()->Type()] )
-            cn_items.push_back( cn_item );
-    }
-
-    std::sort( cn_items.begin(), cn_items.end(), NETCODE_CMP_LESS() );
-
-    return cn_items;
-}
-
-
 void DIALOG_NET_INSPECTOR::updateDisplayedRowValues( const OPT<LIST_ITEM_ITER>& aRow )
 {
     if( !aRow )
@@ -1332,8 +1286,7 @@ void DIALOG_NET_INSPECTOR::updateNet( NETINFO_ITEM* aNet )
         return;
     }
 
-    std::unique_ptr<LIST_ITEM> new_list_item = buildNewItem( aNet, node_count,
-                                                             relevantConnectivityItems() );
+    std::unique_ptr<LIST_ITEM> new_list_item = buildNewItem( aNet, node_count );
 
     if( !cur_net_row )
     {
@@ -1355,6 +1308,7 @@ void DIALOG_NET_INSPECTOR::updateNet( NETINFO_ITEM* aNet )
         // update fields only
         cur_list_item->SetPadCount( new_list_item->GetPadCount() );
         cur_list_item->SetViaCount( new_list_item->GetViaCount() );
+        cur_list_item->SetViaLength( new_list_item->GetViaLength() );
         cur_list_item->SetBoardWireLength( new_list_item->GetBoardWireLength() );
         cur_list_item->SetChipWireLength( new_list_item->GetChipWireLength() );
 
@@ -1366,77 +1320,25 @@ void DIALOG_NET_INSPECTOR::updateNet( NETINFO_ITEM* aNet )
 unsigned int DIALOG_NET_INSPECTOR::calculateViaLength( const TRACK* aTrack ) const
 {
     const VIA& via = dynamic_cast<const VIA&>( *aTrack );
-    BOARD_DESIGN_SETTINGS& bds = m_brd->GetDesignSettings();
-
-    // calculate the via length individually from the board stackup and via's start and end layer.
-    if( bds.m_HasStackup )
-    {
-        const BOARD_STACKUP& stackup = bds.GetStackupDescriptor();
-
-        std::pair<PCB_LAYER_ID, int> layer_dist[2] = { std::make_pair( via.TopLayer(), 0 ),
-                                                       std::make_pair( via.BottomLayer(), 0 ) };
-
-        for( const BOARD_STACKUP_ITEM* i : stackup.GetList() )
-        {
-            for( std::pair<PCB_LAYER_ID, int>& j : layer_dist )
-            {
-                if( j.first != UNDEFINED_LAYER )
-                    j.second += i->GetThickness();
-
-                if( j.first == i->GetBrdLayerId() )
-                    j.first = UNDEFINED_LAYER;
-            }
-        }
-
-        return std::abs( layer_dist[0].second - layer_dist[1].second );
-    }
-    else
-    {
-        int dielectricLayers = bds.GetCopperLayerCount() - 1;
-        int layerThickness = bds.GetBoardThickness() / dielectricLayers;
-        int effectiveBottomLayer;
-
-        if( via.BottomLayer() == B_Cu )
-            effectiveBottomLayer = F_Cu + dielectricLayers;
-        else
-            effectiveBottomLayer = via.BottomLayer();
 
-        int layerCount = effectiveBottomLayer - via.TopLayer();
-
-        return layerCount * layerThickness;
-    }
+    return NET_LENGTH_CACHE::ViaSpanLength( m_brd, via.TopLayer(), via.BottomLayer() );
 }
 
 
 std::unique_ptr<DIALOG_NET_INSPECTOR::LIST_ITEM>
-DIALOG_NET_INSPECTOR::buildNewItem( NETINFO_ITEM* aNet, unsigned int aPadCount,
-                                    const std::vector<CN_ITEM*>& aCNItems )
+DIALOG_NET_INSPECTOR::buildNewItem( NETINFO_ITEM* aNet, unsigned int aPadCount )
 {
     std::unique_ptr<LIST_ITEM> new_item = std::make_unique<LIST_ITEM>( aNet );
 
-    new_item->SetPadCount( aPadCount );
+    // the lengths come from the connectivity's per-net cache, which only sums again the
+    // nets that have been edited since the last query.
+    NET_LENGTH_CACHE::ENTRY length = m_brd->GetConnectivity()->GetNetLength( aNet->GetNetCode() );
 
-    const auto cn_items = std::equal_range( aCNItems.begin(), aCNItems.end(), aNet->GetNetCode(),
-                                            NETCODE_CMP_LESS() );
-
-    for( auto i = cn_items.first; i != cn_items.second; ++i )
-    {
-        BOARD_CONNECTED_ITEM* item = ( *i )->Parent();
-
-        if( item->Type() == PCB_PAD_T )
-            new_item->AddChipWireLength( static_cast<PAD*>( item )->GetPadToDieLength() );
-
-        else if( TRACK* track = dynamic_cast<TRACK*>( item ) )
-        {
-            new_item->AddBoardWireLength( track->GetLength() );
-
-            if( item->Type() == PCB_VIA_T )
-            {
-                new_item->AddViaCount( 1 );
-                new_item->AddViaLength( calculateViaLength( track ) );
-            }
-        }
-    }
+    new_item->SetPadCount( aPadCount );
+    new_item->SetViaCount( length.viaCount );
+    new_item->SetViaLength( length.ViaLength( m_brd ) );
+    new_item->SetBoardWireLength( length.trackLength );
+    new_item->SetChipWireLength( length.padToDieLength );
 
     return new_item;
 }
@@ -1480,9 +1382,6 @@ void DIALOG_NET_INSPECTOR::buildNetsList()
         }
     }
 
-    std::vector<CN_ITEM*> prefiltered_cn_items = relevantConnectivityItems();
-
-
     // collect all nets which pass the filter string and also remember the
     // suffix after the filter match, if any.
     struct NET_INFO
@@ -1538,7 +1437,7 @@ void DIALOG_NET_INSPECTOR::buildNetsList()
     for( NET_INFO& ni : nets )
     {
         if( m_cbShowZeroPad->IsChecked() || ni.pad_count > 0 )
-            new_items.emplace_back( buildNewItem( ni.net, ni.pad_count, prefiltered_cn_items ) );
+            new_items.emplace_back( buildNewItem( ni.net, ni.pad_count ) );
     }
 
 
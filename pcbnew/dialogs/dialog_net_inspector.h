@@ -31,7 +31,6 @@
 class PCB_EDIT_FRAME;
 class NETINFO_ITEM;
 class BOARD;
-class CN_ITEM;
 class EDA_PATTERN_MATCH;
 
 class DIALOG_NET_INSPECTOR : public DIALOG_NET_INSPECTOR_BASE, public BOARD_LISTENER
@@ -86,7 +85,6 @@ private:
     wxString formatCount( unsigned int aValue ) const;
     wxString formatLength( int64_t aValue ) const;
 
-    std::vector<CN_ITEM*> relevantConnectivityItems() const;
     bool                  netFilterMatches( NETINFO_ITEM* aNet ) const;
     void                  updateNet( NETINFO_ITEM* aNet );
     unsigned int          calculateViaLength( const TRACK* ) const;
@@ -101,8 +99,7 @@ private:
     void onDeleteNet( wxCommandEvent& event ) override;
     void onReport( wxCommandEvent& event ) override;
 
-    std::unique_ptr<LIST_ITEM> buildNewItem( NETINFO_ITEM* aNet, unsigned int aPadCount,
-                                             const std::vector<CN_ITEM*>& aCNItems );
+    std::unique_ptr<LIST_ITEM> buildNewItem( NETINFO_ITEM* aNet, unsigned int aPadCount );
 
     void buildNetsList();
     void adjustListColumns();
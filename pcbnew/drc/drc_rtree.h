@@ -28,17 +28,27 @@
 #include <eda_rect.h>
 #include <board_item.h>
 #include <track.h>
+#include <climits>
+#include <functional>
+#include <map>
 #include <unordered_set>
 #include <set>
 #include <vector>
 
-#include <geometry/rtree.h>
+#include <geometry/packed_rtree.h>
+#include <geometry/seg_batch.h>
+#include <geometry/shape_circle.h>
+#include <geometry/shape_poly_set.h>
+#include <geometry/shape_segment.h>
 #include <math/vector2d.h>
 
 /**
  * DRC_RTREE -
  * Implements an R-tree for fast spatial and layer indexing of connectable items.
  * Non-owning.
+ *
+ * The items are all inserted first, then Build() packs the tree of each layer; queries are
+ * only allowed after that, until the next clear().
  */
 class DRC_RTREE
 {
@@ -61,7 +71,7 @@ public:
 
 private:
 
-    using drc_rtree = RTree<ITEM_WITH_SHAPE*, int, 2, double>;
+    using drc_rtree = PACKED_RTREE<ITEM_WITH_SHAPE*, int>;
 
 public:
 
@@ -75,13 +85,15 @@ public:
 
     ~DRC_RTREE()
     {
+        clear();
+
         for( auto tree : m_tree )
             delete tree;
     }
 
     /**
      * Function Insert()
-     * Inserts an item into the tree.
+     * Inserts an item into the tree.  Must be called before Build().
      */
     void Insert( BOARD_ITEM* aItem, int aWorstClearance = 0, int aLayer = UNDEFINED_LAYER )
     {
@@ -98,6 +110,11 @@ public:
                     else
                         subshapes.push_back( shape.get() );
 
+                    // Untriangulated polygons (e.g. zone fills) are collided as a whole, so
+                    // index their edges; the shape is our own copy
+                    if( shape->Type() == SH_POLY_SET && !shape->HasIndexableSubshapes() )
+                        static_cast<SHAPE_POLY_SET*>( shape.get() )->BuildEdgeIndex();
+
                     for( SHAPE* subshape : subshapes )
                     {
                         BOX2I bbox = subshape->BBox();
@@ -138,6 +155,16 @@ public:
         }
     }
 
+    /**
+     * Function Build()
+     * Packs the items inserted so far, so that the tree can be queried.
+     */
+    void Build()
+    {
+        for( auto tree : m_tree )
+            tree->Build();
+    }
+
     /**
      * Function RemoveAll()
      * Removes all items from the RTree
@@ -145,7 +172,12 @@ public:
     void clear()
     {
         for( auto tree : m_tree )
+        {
+            for( ITEM_WITH_SHAPE* item : *tree )
+                delete item;
+
             tree->RemoveAll();
+        }
 
         m_count = 0;
     }
@@ -153,12 +185,6 @@ public:
     bool CheckColliding( SHAPE* aRefShape, PCB_LAYER_ID aTargetLayer, int aClearance = 0,
                          std::function<bool( BOARD_ITEM*)> aFilter = nullptr ) const
     {
-        BOX2I box = aRefShape->BBox();
-        box.Inflate( aClearance );
-
-        int min[2] = { box.GetX(),         box.GetY() };
-        int max[2] = { box.GetRight(),     box.GetBottom() };
-
         int count = 0;
 
         auto visit =
@@ -178,7 +204,7 @@ public:
                     return true;
                 };
 
-        this->m_tree[aTargetLayer]->Search( min, max, visit );
+        searchNear( aRefShape->BBox(), aRefShape, aTargetLayer, aClearance, visit );
         return count > 0;
     }
 
@@ -199,12 +225,6 @@ public:
         // means we have a hit)
         std::unordered_set<BOARD_ITEM*> collidingCompounds;
 
-        EDA_RECT box = aRefItem->GetBoundingBox();
-        box.Inflate( aClearance );
-
-        int min[2] = { box.GetX(),         box.GetY() };
-        int max[2] = { box.GetRight(),     box.GetBottom() };
-
         std::shared_ptr<SHAPE> refShape = aRefItem->GetEffectiveShape( aRefLayer );
 
         int count = 0;
@@ -233,7 +253,10 @@ public:
                     return true;
                 };
 
-        this->m_tree[aTargetLayer]->Search( min, max, visit );
+        EDA_RECT box = aRefItem->GetBoundingBox();
+
+        searchNear( BOX2I( box.GetOrigin(), box.GetSize() ), refShape.get(), aTargetLayer,
+                    aClearance, visit );
         return count;
     }
 
@@ -246,11 +269,6 @@ public:
     bool QueryColliding( EDA_RECT aBox, SHAPE* aRefShape, PCB_LAYER_ID aLayer, int aClearance,
                          int* aActual, VECTOR2I* aPos ) const
     {
-        aBox.Inflate( aClearance );
-
-        int min[2] = { aBox.GetX(), aBox.GetY() };
-        int max[2] = { aBox.GetRight(), aBox.GetBottom() };
-
         bool     collision = false;
         int      actual = INT_MAX;
         VECTOR2I pos;
@@ -275,7 +293,8 @@ public:
                     return true;
                 };
 
-        this->m_tree[aLayer]->Search( min, max, visit );
+        searchNear( BOX2I( aBox.GetOrigin(), aBox.GetSize() ), aRefShape, aLayer, aClearance,
+                    visit );
 
         if( collision )
         {
@@ -391,7 +410,7 @@ public:
         return m_count == 0;
     }
 
-    using iterator = typename drc_rtree::Iterator;
+    using iterator = std::vector<ITEM_WITH_SHAPE*>::const_iterator;
 
     /**
      * The DRC_LAYER struct provides a layer-specific auto-range iterator to the RTree.  Using
@@ -403,28 +422,36 @@ public:
      */
     struct DRC_LAYER
     {
-        DRC_LAYER( drc_rtree* aTree ) : layer_tree( aTree )
+        DRC_LAYER( drc_rtree* aTree ) :
+                m_items( aTree->begin(), aTree->end() )
         {
-            m_rect = { { INT_MIN, INT_MIN }, { INT_MAX, INT_MAX } };
         };
 
-        DRC_LAYER( drc_rtree* aTree, const EDA_RECT aRect ) : layer_tree( aTree )
+        DRC_LAYER( drc_rtree* aTree, const EDA_RECT aRect )
         {
-            m_rect = { { aRect.GetX(), aRect.GetY() },
-                       { aRect.GetRight(), aRect.GetBottom() } };
+            int min[2] = { aRect.GetX(), aRect.GetY() };
+            int max[2] = { aRect.GetRight(), aRect.GetBottom() };
+
+            auto collect =
+                    [&]( ITEM_WITH_SHAPE* aItem ) -> bool
+                    {
+                        m_items.push_back( aItem );
+                        return true;
+                    };
+
+            aTree->Search( min, max, collect );
         };
 
-        drc_rtree::Rect m_rect;
-        drc_rtree*      layer_tree;
+        std::vector<ITEM_WITH_SHAPE*> m_items;
 
         iterator begin()
         {
-            return layer_tree->begin( m_rect );
+            return m_items.begin();
         }
 
         iterator end()
         {
-            return layer_tree->end( m_rect );
+            return m_items.end();
         }
     };
 
@@ -447,6 +474,93 @@ public:
 
 
 private:
+    /**
+     * Run \a aVisitor on the items of \a aLayer whose bounding box overlaps \a aBox inflated
+     * by \a aClearance, until it returns false.
+     *
+     * The tree boxes are inflated by the worst clearance, so many of the hits are nowhere near
+     * \a aRefShape.  Track segments are therefore gathered in SEG_BATCH blocks, and dropped
+     * without calling the visitor when the batched lower bound of their distance to
+     * \a aRefShape (its segment or centre if it is a segment or a circle, its bounding box
+     * otherwise) proves they are out of reach.
+     */
+    template <typename VISITOR>
+    void searchNear( const BOX2I& aBox, const SHAPE* aRefShape, PCB_LAYER_ID aLayer,
+                     int aClearance, VISITOR& aVisitor ) const
+    {
+        BOX2I box = aBox;
+        box.Inflate( aClearance );
+
+        int min[2] = { box.GetX(),     box.GetY() };
+        int max[2] = { box.GetRight(), box.GetBottom() };
+
+        SEG_BATCH        batch;
+        ITEM_WITH_SHAPE* batchItems[SEG_BATCH::BLOCK_SIZE];
+        bool             stopped = false;
+
+        auto flush =
+                [&]() -> bool
+                {
+                    const double* lowerBounds;
+                    int           refExtra = 0;
+
+                    if( aRefShape->Type() == SH_SEGMENT )
+                    {
+                        auto seg = static_cast<const SHAPE_SEGMENT*>( aRefShape );
+
+                        lowerBounds = batch.DistanceLowerBounds( seg->GetSeg() );
+                        refExtra = ( seg->GetWidth() + 1 ) / 2;
+                    }
+                    else if( aRefShape->Type() == SH_CIRCLE )
+                    {
+                        auto circle = static_cast<const SHAPE_CIRCLE*>( aRefShape );
+
+                        lowerBounds = batch.DistanceLowerBounds( circle->GetCenter() );
+                        refExtra = circle->GetRadius();
+                    }
+                    else
+                    {
+                        lowerBounds = batch.BoxDistanceLowerBounds( aRefShape->BBox() );
+                    }
+
+                    for( int i = 0; i < batch.Size() && !stopped; i++ )
+                    {
+                        auto   seg = static_cast<const SHAPE_SEGMENT*>( batchItems[i]->shape );
+                        double reach = std::max( 0, aClearance + refExtra
+                                                            + ( seg->GetWidth() + 1 ) / 2 );
+
+                        // A zero reach still collides at distance zero
+                        if( lowerBounds[i] >= std::max( reach * reach, 1.0 ) )
+                            continue;
+
+                        stopped = !aVisitor( batchItems[i] );
+                    }
+
+                    batch.Clear();
+                    return !stopped;
+                };
+
+        auto visit =
+                [&]( ITEM_WITH_SHAPE* aItem ) -> bool
+                {
+                    if( aItem->shape->Type() != SH_SEGMENT )
+                    {
+                        stopped = !aVisitor( aItem );
+                        return !stopped;
+                    }
+
+                    batchItems[batch.Size()] = aItem;
+                    batch.Add( static_cast<const SHAPE_SEGMENT*>( aItem->shape )->GetSeg() );
+
+                    return !batch.Full() || flush();
+                };
+
+        m_tree[aLayer]->Search( min, max, visit );
+
+        if( !stopped && batch.Size() )
+            flush();
+    }
+
     drc_rtree*  m_tree[PCB_LAYER_ID_COUNT];
     size_t      m_count;
 };
@@ -186,6 +186,7 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::Run()
 
     forEachGeometryItem( itemTypes, LSET::AllCuMask(), countItems );
     forEachGeometryItem( itemTypes, LSET::AllCuMask(), addToCopperTree );
+    m_copperTree.Build();
 
     if( !reportPhase( _( "Tessellating copper zones..." ) ) )
         return false;
@@ -208,6 +209,8 @@ bool DRC_TEST_PROVIDER_COPPER_CLEARANCE::Run()
                 m_zoneTrees[ zone ]->Insert( zone, layer );
         }
 
+        m_zoneTrees[ zone ]->Build();
+
     }
 
     reportAux( "Testing %d copper items and %d zones...", count, m_zones.size() );
@@ -726,7 +729,12 @@ void DRC_TEST_PROVIDER_COPPER_CLEARANCE::testZones()
         for( size_t ii = 0; ii < m_zones.size(); ii++ )
         {
             if( m_zones[ii]->IsOnLayer( layer ) )
+            {
                 m_zones[ii]->BuildSmoothedPoly( smoothed_polys[ii], layer, boardOutline );
+
+                // Tested against the corners of every other zone below
+                smoothed_polys[ii].BuildEdgeIndex();
+            }
         }
 
         // iterate through all areas
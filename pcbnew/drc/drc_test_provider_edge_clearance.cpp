@@ -198,6 +198,8 @@ bool DRC_TEST_PROVIDER_EDGE_CLEARANCE::Run()
     for( const std::unique_ptr<PCB_SHAPE>& edge : edges )
         edgesTree.Insert( edge.get(), m_largestClearance );
 
+    edgesTree.Build();
+
     wxString val;
     wxGetEnv( "WXTRACE", &val );
 
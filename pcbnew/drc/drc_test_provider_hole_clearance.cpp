@@ -162,6 +162,7 @@ bool DRC_TEST_PROVIDER_HOLE_CLEARANCE::Run()
     count *= 2;  // One for adding to tree; one for checking
 
     forEachGeometryItem( { PCB_PAD_T, PCB_VIA_T }, LSET::AllLayersMask(), addToHoleTree );
+    m_holeTree.Build();
 
     std::map< std::pair<BOARD_ITEM*, BOARD_ITEM*>, int> checkedPairs;
 
@@ -257,7 +257,8 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
                 return true;
             };
 
-    auto ftCache = m_board->GetConnectivity()->GetFromToCache();
+    std::shared_ptr<CONNECTIVITY_DATA> connectivity = m_board->GetConnectivity();
+    auto                               ftCache = connectivity->GetFromToCache();
 
     ftCache->Rebuild( m_board );
 
@@ -288,24 +289,37 @@ bool DRC_TEST_PROVIDER_MATCHED_LENGTH::runInternal( bool aDelayReportMode )
             ent.fromItem = nullptr;
             ent.toItem = nullptr;
 
-            for( BOARD_CONNECTED_ITEM* citem : nitem.second )
+            NET_LENGTH_CACHE::ENTRY netLength = connectivity->GetNetLength( ent.netcode );
+
+            if( (int) nitem.second.size() == netLength.routedCount )
             {
-                if( citem->Type() == PCB_VIA_T )
-                {
-                    ent.viaCount++;
-                    ent.totalVia += computeViaThruLength( static_cast<VIA*>( citem ), nitem.second );
-                }
-                else if( citem->Type() == PCB_TRACE_T )
-                {
-                    ent.totalRoute += static_cast<TRACK*>( citem )->GetLength();
-                }
-                else if ( citem->Type() == PCB_ARC_T )
-                {
-                    ent.totalRoute += static_cast<ARC*>( citem )->GetLength();
-                }
-                else if( citem->Type() == PCB_PAD_T )
+                // The rule matches every track, arc and via of the net: use the totals the
+                // connectivity keeps for it instead of summing them again.
+                ent.viaCount = netLength.viaCount;
+                ent.totalRoute = netLength.trackLength;
+            }
+            else
+            {
+                for( BOARD_CONNECTED_ITEM* citem : nitem.second )
                 {
-                    ent.totalPadToDie += static_cast<PAD*>( citem )->GetPadToDieLength();
+                    if( citem->Type() == PCB_VIA_T )
+                    {
+                        ent.viaCount++;
+                        ent.totalVia += computeViaThruLength( static_cast<VIA*>( citem ),
+                                                              nitem.second );
+                    }
+                    else if( citem->Type() == PCB_TRACE_T )
+                    {
+                        ent.totalRoute += static_cast<TRACK*>( citem )->GetLength();
+                    }
+                    else if ( citem->Type() == PCB_ARC_T )
+                    {
+                        ent.totalRoute += static_cast<ARC*>( citem )->GetLength();
+                    }
+                    else if( citem->Type() == PCB_PAD_T )
+                    {
+                        ent.totalPadToDie += static_cast<PAD*>( citem )->GetPadToDieLength();
+                    }
                 }
             }
 
@@ -209,6 +209,9 @@ bool DRC_TEST_PROVIDER_SILK_CLEARANCE::Run()
                          LSET::FrontMask() | LSET::BackMask() | LSET( 2, Edge_Cuts, Margin ),
                          addToTargetTree );
 
+    silkTree.Build();
+    targetTree.Build();
+
     reportAux( _("Testing %d silkscreen features against %d board items."),
                silkTree.size(),
                targetTree.size() );
@@ -63,6 +63,9 @@ FOOTPRINT_PREVIEW_PANEL::FOOTPRINT_PREVIEW_PANEL( KIWAY* aKiway, wxWindow* aPare
 
 FOOTPRINT_PREVIEW_PANEL::~FOOTPRINT_PREVIEW_PANEL( )
 {
+    // m_dummyBoard is deleted before the base class destructor runs
+    CancelZoneTriangulation();
+
     if( m_currentFootprint )
     {
         GetView()->Remove( m_currentFootprint.get() );
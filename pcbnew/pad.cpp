@@ -51,7 +51,9 @@ using KIGFX::PCB_PAINTER;
 using KIGFX::PCB_RENDER_SETTINGS;
 
 PAD::PAD( FOOTPRINT* parent ) :
-    BOARD_CONNECTED_ITEM( parent, PCB_PAD_T )
+    BOARD_CONNECTED_ITEM( parent, PCB_PAD_T ),
+    m_geometryRevision( 0 ),
+    m_clearancePolysRevision( 0 )
 {
     m_size.x = m_size.y   = Mils2iu( 60 );  // Default pad size 60 mils.
     m_drill.x = m_drill.y = Mils2iu( 30 );  // Default drill size 30 mils.
@@ -98,7 +100,9 @@ PAD::PAD( FOOTPRINT* parent ) :
 
 
 PAD::PAD( const PAD& aOther ) :
-    BOARD_CONNECTED_ITEM( aOther.GetParent(), PCB_PAD_T )
+    BOARD_CONNECTED_ITEM( aOther.GetParent(), PCB_PAD_T ),
+    m_geometryRevision( 0 ),
+    m_clearancePolysRevision( 0 )
 {
     BOARD_CONNECTED_ITEM::operator=( aOther );
 
@@ -25,7 +25,9 @@
 #ifndef PAD_H
 #define PAD_H
 
+#include <map>
 #include <mutex>
+#include <tuple>
 #include <zones.h>
 #include <board_connected_item.h>
 #include <board_item.h>
@@ -352,6 +354,7 @@ public:
     {
         m_shapesDirty = true;
         m_polyDirty = true;
+        m_geometryRevision++;
     }
 
     void SetLayerSet( LSET aLayers ) override   { m_layerMask = aLayers; }
@@ -528,7 +531,12 @@ public:
      *
      * @param aPositions a bit-set of #RECT_CHAMFER_POSITIONS.
      */
-    void SetChamferPositions( int aPositions ) { m_chamferPositions = aPositions; }
+    void SetChamferPositions( int aPositions )
+    {
+        m_chamferPositions = aPositions;
+        SetDirty();
+    }
+
     int GetChamferPositions() const { return m_chamferPositions; }
 
     /**
@@ -663,6 +671,10 @@ private:
     void addPadPrimitivesToPolygon( SHAPE_POLY_SET* aMergedPolygon, PCB_LAYER_ID aLayer,
                                     int aError, ERROR_LOC aErrorLoc ) const;
 
+    ///< Build the polygon returned by TransformShapeWithClearanceToPolygon(), without caching
+    void buildClearancePolygon( SHAPE_POLY_SET& aCornerBuffer, int aClearanceValue,
+                                int aError, ERROR_LOC aErrorLoc, PCB_LAYER_ID aLayer ) const;
+
 private:
     wxString      m_name;               // Pad name (pin number in schematic)
     wxString      m_pinFunction;        // Pin name in schematic
@@ -691,6 +703,33 @@ private:
     mutable std::shared_ptr<SHAPE_POLY_SET>   m_effectivePolygon;
     mutable int                               m_effectiveBoundingRadius;
 
+    unsigned                                  m_geometryRevision;
+
+    /*
+     * Polygons built by TransformShapeWithClearanceToPolygon(), which the zone filler, DRC,
+     * the 3D viewer and the plotters ask for many times with the same few parameters.  The
+     * entries are dropped when the geometry revision they were built for is outdated.
+     */
+    struct CLEARANCE_POLY_KEY
+    {
+        PCB_LAYER_ID m_layer;
+        int          m_clearance;
+        int          m_maxError;
+        ERROR_LOC    m_errorLoc;
+        int          m_boardMaxError;   ///< custom pads merge their primitives with this one
+
+        bool operator<( const CLEARANCE_POLY_KEY& aOther ) const
+        {
+            return std::tie( m_layer, m_clearance, m_maxError, m_errorLoc, m_boardMaxError )
+                   < std::tie( aOther.m_layer, aOther.m_clearance, aOther.m_maxError,
+                               aOther.m_errorLoc, aOther.m_boardMaxError );
+        }
+    };
+
+    mutable std::mutex                                   m_clearancePolysLock;
+    mutable unsigned                                     m_clearancePolysRevision;
+    mutable std::map<CLEARANCE_POLY_KEY, SHAPE_POLY_SET> m_clearancePolys;
+
     /*
      * How to build the custom shape in zone, to create the clearance area:
      * CUST_PAD_SHAPE_IN_ZONE_OUTLINE = use pad shape
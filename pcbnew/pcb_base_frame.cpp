@@ -78,6 +78,7 @@ PCB_BASE_FRAME::~PCB_BASE_FRAME()
     // Ensure m_canvasType is up to date, to save it in config
     m_canvasType = GetCanvas()->GetBackend();
 
+    GetCanvas()->CancelZoneTriangulation();
     delete m_pcb;
 }
 
@@ -145,6 +146,10 @@ void PCB_BASE_FRAME::SetBoard( BOARD* aBoard )
 {
     if( m_pcb != aBoard )
     {
+        // The canvas may still be triangulating the zones of the old board
+        if( GetCanvas() )
+            GetCanvas()->CancelZoneTriangulation();
+
         delete m_pcb;
         m_pcb = aBoard;
 
@@ -33,6 +33,8 @@
 #include <footprint.h>
 #include <track.h>
 #include <pcb_marker.h>
+#include <zone.h>
+#include <zone_fill_triangulation.h>
 #include <pcb_base_frame.h>
 #include <pcbnew_settings.h>
 #include <ratsnest/ratsnest_data.h>
@@ -42,7 +44,9 @@
 #include <settings/settings_manager.h>
 #include <confirm.h>
 
+#include <advanced_config.h>
 #include <gal/graphics_abstraction_layer.h>
+#include <view/view_profile.h>
 #include <zoom_defines.h>
 
 #include <functional>
@@ -167,67 +171,125 @@ PCB_DRAW_PANEL_GAL::PCB_DRAW_PANEL_GAL( wxWindow* aParentWindow, wxWindowID aWin
         if( frame )
             view->UpdateDisplayOptions( frame->GetDisplayOptions() );
     }
+
+    if( ADVANCED_CFG::GetCfg().m_ShowDrawProfile )
+        ShowDrawProfile( true );
 }
 
 
 PCB_DRAW_PANEL_GAL::~PCB_DRAW_PANEL_GAL()
 {
+    CancelZoneTriangulation();
 }
 
 
 void PCB_DRAW_PANEL_GAL::DisplayBoard( BOARD* aBoard )
 {
+    CancelZoneTriangulation();
 
     m_view->Clear();
 
-    auto zones = aBoard->Zones();
-    std::atomic<size_t> next( 0 );
-    std::atomic<size_t> count_done( 0 );
-    size_t parallelThreadCount = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+    // Triangulating large fills takes a while, so the zones are shown as outlines at first
+    // (see PCB_PAINTER::draw( const ZONE* )) and filled as their triangulation completes.
+    auto job = std::make_shared<ZONE_FILL_TRIANGULATION>( aBoard );
 
-    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    if( !job->Empty() )
     {
-        std::thread t = std::thread( [ &count_done, &next, &zones ]( )
-        {
-            for( size_t i = next.fetch_add( 1 ); i < zones.size(); i = next.fetch_add( 1 ) )
-                zones[i]->CacheTriangulation();
-
-            count_done++;
-        } );
-
-        t.detach();
+        std::weak_ptr<ZONE_FILL_TRIANGULATION> weakJob = job;
+
+        // The job waits for its workers when destroyed, so they must not own it
+        job->Start( [this, weakJob]()
+                    {
+                        CallAfter( [this, weakJob]()
+                                   {
+                                       applyZoneTriangulation( weakJob.lock() );
+                                   } );
+                    } );
+
+        m_zoneTriangulation = job;
+        static_cast<KIGFX::PCB_PAINTER*>( m_painter.get() )->SetZoneFillTriangulation( job.get() );
     }
 
     if( m_worksheet )
         m_worksheet->SetFileName( TO_UTF8( aBoard->GetFileName() ) );
 
+    // Items are added in bulk so that the view can bulk load its layer R-trees
+    std::vector<KIGFX::VIEW_ITEM*> items;
+
     // Load drawings
     for( BOARD_ITEM* drawing : aBoard->Drawings() )
-        m_view->Add( drawing );
+        items.push_back( drawing );
 
     // Load tracks
     for( TRACK* track : aBoard->Tracks() )
-        m_view->Add( track );
+        items.push_back( track );
 
     // Load footprints and its additional elements
     for( FOOTPRINT* footprint : aBoard->Footprints() )
-        m_view->Add( footprint );
+        items.push_back( footprint );
 
     // DRC markers
     for( PCB_MARKER* marker : aBoard->Markers() )
-        m_view->Add( marker );
-
-    // Finalize the triangulation threads
-    while( count_done < parallelThreadCount )
-        std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+        items.push_back( marker );
 
     // Load zones
     for( ZONE* zone : aBoard->Zones() )
-        m_view->Add( zone );
+        items.push_back( zone );
+
+    m_view->Add( items );
 
     // Ratsnest
     m_ratsnest = std::make_unique<KIGFX::RATSNEST_VIEWITEM>( aBoard->GetConnectivity() );
     m_view->Add( m_ratsnest.get() );
+
+    // Draw statistics, dropped by the view with the other items
+    if( m_drawProfile )
+    {
+        m_drawProfile = std::make_unique<KIGFX::VIEW_PROFILE_OVERLAY>( m_view->GetProfile(),
+                                                                       DrawProfileLayerName );
+        m_view->Add( m_drawProfile.get() );
+    }
+}
+
+
+void PCB_DRAW_PANEL_GAL::CancelZoneTriangulation()
+{
+    if( !m_zoneTriangulation )
+        return;
+
+    static_cast<KIGFX::PCB_PAINTER*>( m_painter.get() )->SetZoneFillTriangulation( nullptr );
+
+    // The zones still waiting were drawn as outlines
+    for( ZONE* zone : m_zoneTriangulation->GetBoard()->Zones() )
+    {
+        if( m_zoneTriangulation->IsPending( zone ) )
+            m_view->Update( zone, KIGFX::REPAINT );
+    }
+
+    m_zoneTriangulation->Cancel();
+
+    // Calls still queued by the workers find the job gone and do nothing
+    m_zoneTriangulation.reset();
+}
+
+
+void PCB_DRAW_PANEL_GAL::applyZoneTriangulation(
+        const std::shared_ptr<ZONE_FILL_TRIANGULATION>& aJob )
+{
+    // The job was cancelled or another board was displayed since
+    if( !aJob || aJob != m_zoneTriangulation )
+        return;
+
+    std::vector<ZONE*> completed = aJob->ApplyFinished();
+
+    for( ZONE* zone : completed )
+        m_view->Update( zone, KIGFX::REPAINT );
+
+    if( aJob->IsFinished() )
+        CancelZoneTriangulation();
+
+    if( !completed.empty() )
+        Refresh();
 }
 
 
@@ -397,39 +459,45 @@ void PCB_DRAW_PANEL_GAL::SetTopLayer( PCB_LAYER_ID aLayer )
 
 
 void PCB_DRAW_PANEL_GAL::SyncLayersVisibility( const BOARD* aBoard )
+{
+    SyncLayersVisibility( m_view, aBoard );
+}
+
+
+void PCB_DRAW_PANEL_GAL::SyncLayersVisibility( KIGFX::VIEW* aView, const BOARD* aBoard )
 {
     // Load layer & elements visibility settings
     for( LAYER_NUM i = 0; i < PCB_LAYER_ID_COUNT; ++i )
-        m_view->SetLayerVisible( i, aBoard->IsLayerVisible( PCB_LAYER_ID( i ) ) );
+        aView->SetLayerVisible( i, aBoard->IsLayerVisible( PCB_LAYER_ID( i ) ) );
 
     for( GAL_LAYER_ID i = GAL_LAYER_ID_START; i < GAL_LAYER_ID_END; ++i )
-        m_view->SetLayerVisible( i, aBoard->IsElementVisible( i ) );
+        aView->SetLayerVisible( i, aBoard->IsElementVisible( i ) );
 
     // Via layers controlled by dependencies
-    m_view->SetLayerVisible( LAYER_VIA_MICROVIA, true );
-    m_view->SetLayerVisible( LAYER_VIA_BBLIND, true );
-    m_view->SetLayerVisible( LAYER_VIA_THROUGH, true );
+    aView->SetLayerVisible( LAYER_VIA_MICROVIA, true );
+    aView->SetLayerVisible( LAYER_VIA_BBLIND, true );
+    aView->SetLayerVisible( LAYER_VIA_THROUGH, true );
 
     // Pad layers controlled by dependencies
-    m_view->SetLayerVisible( LAYER_PAD_FR, true );
-    m_view->SetLayerVisible( LAYER_PAD_BK, true );
+    aView->SetLayerVisible( LAYER_PAD_FR, true );
+    aView->SetLayerVisible( LAYER_PAD_BK, true );
 
     // Always enable netname layers, as their visibility is controlled by layer dependencies
     for( LAYER_NUM i = NETNAMES_LAYER_ID_START; i < NETNAMES_LAYER_ID_END; ++i )
-        m_view->SetLayerVisible( i, true );
+        aView->SetLayerVisible( i, true );
 
     for( LAYER_NUM i = LAYER_ZONE_START; i < LAYER_ZONE_END; i++ )
-        m_view->SetLayerVisible( i, true );
+        aView->SetLayerVisible( i, true );
 
     // Enable some layers that are GAL specific
-    m_view->SetLayerVisible( LAYER_PAD_PLATEDHOLES, true );
-    m_view->SetLayerVisible( LAYER_PAD_HOLEWALLS, true );
-    m_view->SetLayerVisible( LAYER_VIA_HOLES, true );
-    m_view->SetLayerVisible( LAYER_VIA_HOLEWALLS, true );
-    m_view->SetLayerVisible( LAYER_GP_OVERLAY, true );
-    m_view->SetLayerVisible( LAYER_SELECT_OVERLAY, true );
-    m_view->SetLayerVisible( LAYER_RATSNEST, true );
-    m_view->SetLayerVisible( LAYER_MARKER_SHADOWS, true );
+    aView->SetLayerVisible( LAYER_PAD_PLATEDHOLES, true );
+    aView->SetLayerVisible( LAYER_PAD_HOLEWALLS, true );
+    aView->SetLayerVisible( LAYER_VIA_HOLES, true );
+    aView->SetLayerVisible( LAYER_VIA_HOLEWALLS, true );
+    aView->SetLayerVisible( LAYER_GP_OVERLAY, true );
+    aView->SetLayerVisible( LAYER_SELECT_OVERLAY, true );
+    aView->SetLayerVisible( LAYER_RATSNEST, true );
+    aView->SetLayerVisible( LAYER_MARKER_SHADOWS, true );
 }
 
 
@@ -506,13 +574,19 @@ void PCB_DRAW_PANEL_GAL::OnShow()
 
 
 void PCB_DRAW_PANEL_GAL::setDefaultLayerOrder()
+{
+    SetDefaultLayerOrder( m_view );
+}
+
+
+void PCB_DRAW_PANEL_GAL::SetDefaultLayerOrder( KIGFX::VIEW* aView )
 {
     for( LAYER_NUM i = 0; (unsigned) i < sizeof( GAL_LAYER_ORDER ) / sizeof( LAYER_NUM ); ++i )
     {
         LAYER_NUM layer = GAL_LAYER_ORDER[i];
         wxASSERT( layer < KIGFX::VIEW::VIEW_MAX_LAYERS );
 
-        m_view->SetLayerOrder( layer, i );
+        aView->SetLayerOrder( layer, i );
     }
 }
 
@@ -533,6 +607,44 @@ void PCB_DRAW_PANEL_GAL::RedrawRatsnest()
 }
 
 
+void PCB_DRAW_PANEL_GAL::ShowDrawProfile( bool aShow )
+{
+    // Also removes the overlay from the view
+    m_drawProfile.reset();
+
+    m_view->SetProfiling( aShow );
+
+    if( aShow )
+    {
+        m_drawProfile = std::make_unique<KIGFX::VIEW_PROFILE_OVERLAY>( m_view->GetProfile(),
+                                                                       DrawProfileLayerName );
+        m_view->Add( m_drawProfile.get() );
+    }
+
+    m_view->MarkDirty();
+    Refresh();
+}
+
+
+wxString PCB_DRAW_PANEL_GAL::DrawProfileLayerName( int aLayer )
+{
+    if( IsPcbLayer( aLayer ) )
+        return LayerName( aLayer );
+
+    if( aLayer >= NETNAMES_LAYER_ID_START && aLayer < NETNAMES_LAYER_ID_RESERVED )
+        return LayerName( aLayer - NETNAMES_LAYER_ID_START ) + wxT( " netnames" );
+
+    if( aLayer >= LAYER_ZONE_START && aLayer < LAYER_ZONE_END )
+        return LayerName( aLayer - LAYER_ZONE_START ) + wxT( " zones" );
+
+    // LayerName() knows the layers that can be shown or hidden
+    if( aLayer > LAYER_VIAS && aLayer <= LAYER_AUX_ITEMS && aLayer != LAYER_GP_OVERLAY )
+        return LayerName( aLayer );
+
+    return wxString::Format( wxT( "layer %d" ), aLayer );
+}
+
+
 BOX2I PCB_DRAW_PANEL_GAL::GetDefaultViewBBox() const
 {
     if( m_worksheet && m_view->IsLayerVisible( LAYER_WORKSHEET ) )
@@ -543,12 +655,18 @@ BOX2I PCB_DRAW_PANEL_GAL::GetDefaultViewBBox() const
 
 
 void PCB_DRAW_PANEL_GAL::setDefaultLayerDeps()
+{
+    SetDefaultLayerDeps( m_view, m_backend );
+}
+
+
+void PCB_DRAW_PANEL_GAL::SetDefaultLayerDeps( KIGFX::VIEW* aView, GAL_TYPE aBackend )
 {
     // caching makes no sense for Cairo and other software renderers
-    auto target = m_backend == GAL_TYPE_OPENGL ? KIGFX::TARGET_CACHED : KIGFX::TARGET_NONCACHED;
+    auto target = aBackend == GAL_TYPE_OPENGL ? KIGFX::TARGET_CACHED : KIGFX::TARGET_NONCACHED;
 
     for( int i = 0; i < KIGFX::VIEW::VIEW_MAX_LAYERS; i++ )
-        m_view->SetLayerTarget( i, target );
+        aView->SetLayerTarget( i, target );
 
     for( LAYER_NUM i = 0; (unsigned) i < sizeof( GAL_LAYER_ORDER ) / sizeof( LAYER_NUM ); ++i )
     {
@@ -558,68 +676,68 @@ void PCB_DRAW_PANEL_GAL::setDefaultLayerDeps()
         // Set layer display dependencies & targets
         if( IsCopperLayer( layer ) )
         {
-            m_view->SetRequired( ZONE_LAYER_FOR( layer ), layer );
-            m_view->SetRequired( GetNetnameLayer( layer ), layer );
+            aView->SetRequired( ZONE_LAYER_FOR( layer ), layer );
+            aView->SetRequired( GetNetnameLayer( layer ), layer );
         }
         else if( IsNonCopperLayer( layer ) )
-            m_view->SetRequired( ZONE_LAYER_FOR( layer ), layer );
+            aView->SetRequired( ZONE_LAYER_FOR( layer ), layer );
         else if( IsNetnameLayer( layer ) )
-            m_view->SetLayerDisplayOnly( layer );
+            aView->SetLayerDisplayOnly( layer );
     }
 
-    m_view->SetLayerTarget( LAYER_ANCHOR, KIGFX::TARGET_NONCACHED );
-    m_view->SetLayerDisplayOnly( LAYER_ANCHOR );
+    aView->SetLayerTarget( LAYER_ANCHOR, KIGFX::TARGET_NONCACHED );
+    aView->SetLayerDisplayOnly( LAYER_ANCHOR );
 
     // Some more required layers settings
-    m_view->SetRequired( LAYER_VIA_NETNAMES, LAYER_VIAS );
-    m_view->SetRequired( LAYER_PAD_NETNAMES, LAYER_PADS );
+    aView->SetRequired( LAYER_VIA_NETNAMES, LAYER_VIAS );
+    aView->SetRequired( LAYER_PAD_NETNAMES, LAYER_PADS );
 
     // Holes can be independent of their host objects (cf: printing drill marks)
-    m_view->SetRequired( LAYER_VIA_HOLES, LAYER_VIAS );
-    m_view->SetRequired( LAYER_VIA_HOLEWALLS, LAYER_VIAS );
-    m_view->SetRequired( LAYER_PAD_PLATEDHOLES, LAYER_PADS );
-    m_view->SetRequired( LAYER_PAD_HOLEWALLS, LAYER_PADS );
-    m_view->SetRequired( LAYER_NON_PLATEDHOLES, LAYER_PADS );
+    aView->SetRequired( LAYER_VIA_HOLES, LAYER_VIAS );
+    aView->SetRequired( LAYER_VIA_HOLEWALLS, LAYER_VIAS );
+    aView->SetRequired( LAYER_PAD_PLATEDHOLES, LAYER_PADS );
+    aView->SetRequired( LAYER_PAD_HOLEWALLS, LAYER_PADS );
+    aView->SetRequired( LAYER_NON_PLATEDHOLES, LAYER_PADS );
 
     // Via visibility
-    m_view->SetRequired( LAYER_VIA_MICROVIA, LAYER_VIAS );
-    m_view->SetRequired( LAYER_VIA_BBLIND, LAYER_VIAS );
-    m_view->SetRequired( LAYER_VIA_THROUGH, LAYER_VIAS );
+    aView->SetRequired( LAYER_VIA_MICROVIA, LAYER_VIAS );
+    aView->SetRequired( LAYER_VIA_BBLIND, LAYER_VIAS );
+    aView->SetRequired( LAYER_VIA_THROUGH, LAYER_VIAS );
 
     // Pad visibility
-    m_view->SetRequired( LAYER_PADS_TH, LAYER_PADS );
-    m_view->SetRequired( LAYER_PAD_FR, LAYER_PADS );
-    m_view->SetRequired( LAYER_PAD_BK, LAYER_PADS );
+    aView->SetRequired( LAYER_PADS_TH, LAYER_PADS );
+    aView->SetRequired( LAYER_PAD_FR, LAYER_PADS );
+    aView->SetRequired( LAYER_PAD_BK, LAYER_PADS );
 
     // Front footprints
-    m_view->SetRequired( LAYER_PAD_FR, F_Cu );
-    m_view->SetRequired( LAYER_MOD_TEXT_FR, LAYER_MOD_FR );
-    m_view->SetRequired( LAYER_PAD_FR_NETNAMES, LAYER_PAD_FR );
+    aView->SetRequired( LAYER_PAD_FR, F_Cu );
+    aView->SetRequired( LAYER_MOD_TEXT_FR, LAYER_MOD_FR );
+    aView->SetRequired( LAYER_PAD_FR_NETNAMES, LAYER_PAD_FR );
 
     // Back footprints
-    m_view->SetRequired( LAYER_PAD_BK, B_Cu );
-    m_view->SetRequired( LAYER_MOD_TEXT_BK, LAYER_MOD_BK );
-    m_view->SetRequired( LAYER_PAD_BK_NETNAMES, LAYER_PAD_BK );
-
-    m_view->SetLayerTarget( LAYER_SELECT_OVERLAY, KIGFX::TARGET_OVERLAY );
-    m_view->SetLayerDisplayOnly( LAYER_SELECT_OVERLAY ) ;
-    m_view->SetLayerTarget( LAYER_GP_OVERLAY, KIGFX::TARGET_OVERLAY );
-    m_view->SetLayerDisplayOnly( LAYER_GP_OVERLAY ) ;
-    m_view->SetLayerTarget( LAYER_RATSNEST, KIGFX::TARGET_OVERLAY );
-    m_view->SetLayerDisplayOnly( LAYER_RATSNEST );
-
-    m_view->SetLayerTarget( LAYER_DRC_ERROR, KIGFX::TARGET_OVERLAY );
-    m_view->SetLayerDisplayOnly( LAYER_DRC_ERROR );
-    m_view->SetLayerTarget( LAYER_DRC_WARNING, KIGFX::TARGET_OVERLAY );
-    m_view->SetLayerDisplayOnly( LAYER_DRC_WARNING );
-    m_view->SetLayerTarget( LAYER_DRC_EXCLUSION, KIGFX::TARGET_OVERLAY );
-    m_view->SetLayerDisplayOnly( LAYER_DRC_EXCLUSION );
-    m_view->SetLayerTarget( LAYER_MARKER_SHADOWS, KIGFX::TARGET_OVERLAY );
-    m_view->SetLayerDisplayOnly( LAYER_MARKER_SHADOWS );
-
-    m_view->SetLayerTarget( LAYER_WORKSHEET, KIGFX::TARGET_NONCACHED );
-    m_view->SetLayerDisplayOnly( LAYER_WORKSHEET ) ;
-    m_view->SetLayerDisplayOnly( LAYER_GRID );
+    aView->SetRequired( LAYER_PAD_BK, B_Cu );
+    aView->SetRequired( LAYER_MOD_TEXT_BK, LAYER_MOD_BK );
+    aView->SetRequired( LAYER_PAD_BK_NETNAMES, LAYER_PAD_BK );
+
+    aView->SetLayerTarget( LAYER_SELECT_OVERLAY, KIGFX::TARGET_OVERLAY );
+    aView->SetLayerDisplayOnly( LAYER_SELECT_OVERLAY ) ;
+    aView->SetLayerTarget( LAYER_GP_OVERLAY, KIGFX::TARGET_OVERLAY );
+    aView->SetLayerDisplayOnly( LAYER_GP_OVERLAY ) ;
+    aView->SetLayerTarget( LAYER_RATSNEST, KIGFX::TARGET_OVERLAY );
+    aView->SetLayerDisplayOnly( LAYER_RATSNEST );
+
+    aView->SetLayerTarget( LAYER_DRC_ERROR, KIGFX::TARGET_OVERLAY );
+    aView->SetLayerDisplayOnly( LAYER_DRC_ERROR );
+    aView->SetLayerTarget( LAYER_DRC_WARNING, KIGFX::TARGET_OVERLAY );
+    aView->SetLayerDisplayOnly( LAYER_DRC_WARNING );
+    aView->SetLayerTarget( LAYER_DRC_EXCLUSION, KIGFX::TARGET_OVERLAY );
+    aView->SetLayerDisplayOnly( LAYER_DRC_EXCLUSION );
+    aView->SetLayerTarget( LAYER_MARKER_SHADOWS, KIGFX::TARGET_OVERLAY );
+    aView->SetLayerDisplayOnly( LAYER_MARKER_SHADOWS );
+
+    aView->SetLayerTarget( LAYER_WORKSHEET, KIGFX::TARGET_NONCACHED );
+    aView->SetLayerDisplayOnly( LAYER_WORKSHEET ) ;
+    aView->SetLayerDisplayOnly( LAYER_GRID );
 }
 
 
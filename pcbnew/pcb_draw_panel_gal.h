@@ -35,8 +35,11 @@ namespace KIGFX
 {
     class WS_PROXY_VIEW_ITEM;
     class RATSNEST_VIEWITEM;
+    class VIEW_PROFILE_OVERLAY;
 }
 
+class ZONE_FILL_TRIANGULATION;
+
 class PCB_DRAW_PANEL_GAL : public EDA_DRAW_PANEL_GAL
 {
 public:
@@ -49,10 +52,19 @@ public:
     /**
      * Add all items from the current board to the VIEW, so they can be displayed by GAL.
      *
+     * Zone fills that are not triangulated yet are triangulated in the background and drawn
+     * as they complete; see CancelZoneTriangulation().
+     *
      * @param aBoard is the PCB to be loaded.
      */
     void DisplayBoard( BOARD* aBoard );
 
+    /**
+     * Stop triangulating the zone fills of the board given to DisplayBoard().  Must be called
+     * before that board is deleted.  Returns once the zones being triangulated are finished.
+     */
+    void CancelZoneTriangulation();
+
     /**
      * Set (or updates) worksheet used by the draw panel.
      *
@@ -94,6 +106,15 @@ public:
      */
     void SyncLayersVisibility( const BOARD* aBoard );
 
+    ///< Apply the visibility settings of \a aBoard to the layers of any board view.
+    static void SyncLayersVisibility( KIGFX::VIEW* aView, const BOARD* aBoard );
+
+    ///< Set up the layer order of any board view the way the canvas does.
+    static void SetDefaultLayerOrder( KIGFX::VIEW* aView );
+
+    ///< Set up the rendering targets & dependencies of any board view the way the canvas does.
+    static void SetDefaultLayerDeps( KIGFX::VIEW* aView, GAL_TYPE aBackend );
+
     ///< @copydoc EDA_DRAW_PANEL_GAL::GetMsgPanelInfo()
     void GetMsgPanelInfo( EDA_DRAW_FRAME* aFrame, std::vector<MSG_PANEL_ITEM>& aList ) override;
 
@@ -105,6 +126,15 @@ public:
     ///< Force refresh of the ratsnest visual representation.
     void RedrawRatsnest();
 
+    /**
+     * Collect per layer and per item type draw statistics and show those of the last frame
+     * over the board.
+     */
+    void ShowDrawProfile( bool aShow );
+
+    ///< Name of a view layer in draw profile reports.
+    static wxString DrawProfileLayerName( int aLayer );
+
     ///< @copydoc EDA_DRAW_PANEL_GAL::GetDefaultViewBBox()
     BOX2I GetDefaultViewBBox() const override;
 
@@ -117,11 +147,20 @@ protected:
     ///< Set rendering targets & dependencies for layers.
     void setDefaultLayerDeps();
 
+    ///< Move the zone fills triangulated so far back into their zones and redraw them.
+    void applyZoneTriangulation( const std::shared_ptr<ZONE_FILL_TRIANGULATION>& aJob );
+
     ///< Currently used worksheet.
     std::unique_ptr<KIGFX::WS_PROXY_VIEW_ITEM> m_worksheet;
 
     ///< Ratsnest view item
     std::unique_ptr<KIGFX::RATSNEST_VIEWITEM> m_ratsnest;
+
+    ///< Draw statistics overlay, when profiling
+    std::unique_ptr<KIGFX::VIEW_PROFILE_OVERLAY> m_drawProfile;
+
+    ///< Zone fills being triangulated in the background, if any
+    std::shared_ptr<ZONE_FILL_TRIANGULATION> m_zoneTriangulation;
 };
 
 #endif /* PCB_DRAW_PANEL_GAL_H_ */
@@ -31,6 +31,7 @@
 #include <pcb_shape.h>
 #include <kicad_string.h>
 #include <zone.h>
+#include <zone_fill_triangulation.h>
 #include <pcb_text.h>
 #include <pcb_marker.h>
 #include <dimension.h>
@@ -52,6 +53,8 @@
 #include <geometry/shape_simple.h>
 #include <geometry/shape_circle.h>
 
+#include <typeinfo>
+
 using namespace KIGFX;
 
 PCB_RENDER_SETTINGS::PCB_RENDER_SETTINGS()
@@ -365,7 +368,8 @@ COLOR4D PCB_RENDER_SETTINGS::GetColor( const VIEW_ITEM* aItem, int aLayer ) cons
 
 
 PCB_PAINTER::PCB_PAINTER( GAL* aGal ) :
-    PAINTER( aGal )
+    PAINTER( aGal ),
+    m_zoneFillTriangulation( nullptr )
 {
 }
 
@@ -479,6 +483,80 @@ bool PCB_PAINTER::Draw( const VIEW_ITEM* aItem, int aLayer )
 }
 
 
+void PCB_PAINTER::Prepare( const VIEW_ITEM* aItem )
+{
+    const EDA_ITEM* item = dynamic_cast<const EDA_ITEM*>( aItem );
+
+    if( !item )
+        return;
+
+    switch( item->Type() )
+    {
+    case PCB_PAD_T:
+    {
+        // Both are built lazily on first use
+        const PAD* pad = static_cast<const PAD*>( item );
+
+        pad->GetEffectiveShape();
+        pad->GetEffectivePolygon();
+        break;
+    }
+
+    default:
+        break;
+    }
+}
+
+
+PAINTER* PCB_PAINTER::Clone( GAL* aGal ) const
+{
+    // Derived painters (e.g. the printout painter) would be sliced by the copy
+    if( typeid( *this ) != typeid( PCB_PAINTER ) )
+        return nullptr;
+
+    PCB_PAINTER* clone = new PCB_PAINTER( *this );
+    clone->SetGAL( aGal );
+
+    return clone;
+}
+
+
+bool PCB_PAINTER::CanDraw( const VIEW_ITEM* aItem ) const
+{
+    const EDA_ITEM* item = dynamic_cast<const EDA_ITEM*>( aItem );
+
+    if( !item )
+        return false;
+
+    // Must match the types handled by Draw()
+    switch( item->Type() )
+    {
+    case PCB_TRACE_T:
+    case PCB_ARC_T:
+    case PCB_VIA_T:
+    case PCB_PAD_T:
+    case PCB_SHAPE_T:
+    case PCB_FP_SHAPE_T:
+    case PCB_TEXT_T:
+    case PCB_FP_TEXT_T:
+    case PCB_FOOTPRINT_T:
+    case PCB_GROUP_T:
+    case PCB_ZONE_T:
+    case PCB_FP_ZONE_T:
+    case PCB_DIM_ALIGNED_T:
+    case PCB_DIM_CENTER_T:
+    case PCB_DIM_ORTHOGONAL_T:
+    case PCB_DIM_LEADER_T:
+    case PCB_TARGET_T:
+    case PCB_MARKER_T:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
 void PCB_PAINTER::draw( const TRACK* aTrack, int aLayer )
 {
     VECTOR2D start( aTrack->GetStart() );
@@ -1263,8 +1341,8 @@ void PCB_PAINTER::draw( const PCB_SHAPE* aShape, int aLayer )
 
     case S_POLYGON:
     {
-        SHAPE_POLY_SET& shape = const_cast<PCB_SHAPE*>( aShape )->GetPolyShape();
-        FOOTPRINT*      parentFootprint = aShape->GetParentFootprint();
+        const SHAPE_POLY_SET& shape = aShape->GetPolyShape();
+        FOOTPRINT*            parentFootprint = aShape->GetParentFootprint();
 
         if( shape.OutlineCount() == 0 )
             break;
@@ -1278,9 +1356,9 @@ void PCB_PAINTER::draw( const PCB_SHAPE* aShape, int aLayer )
 
         if( sketch )
         {
-            for( int ii = 0; ii < shape.Outline( 0 ).SegmentCount(); ++ii )
+            for( int ii = 0; ii < shape.COutline( 0 ).SegmentCount(); ++ii )
             {
-                SEG seg = shape.Outline( 0 ).Segment( ii );
+                SEG seg = shape.COutline( 0 ).CSegment( ii );
                 m_gal->DrawSegment( seg.A, seg.B, thickness );
             }
         }
@@ -1291,9 +1369,9 @@ void PCB_PAINTER::draw( const PCB_SHAPE* aShape, int aLayer )
 
             if( thickness > 0 )
             {
-                for( int ii = 0; ii < shape.Outline( 0 ).SegmentCount(); ++ii )
+                for( int ii = 0; ii < shape.COutline( 0 ).SegmentCount(); ++ii )
                 {
-                    SEG seg = shape.Outline( 0 ).Segment( ii );
+                    SEG seg = shape.COutline( 0 ).CSegment( ii );
                     m_gal->DrawSegment( seg.A, seg.B, thickness );
                 }
             }
@@ -1305,7 +1383,7 @@ void PCB_PAINTER::draw( const PCB_SHAPE* aShape, int aLayer )
                 // draw the polygon solid shape on Opengl.  GLU tesselation is much slower, so
                 // currently we are using our tesselation.
                 if( m_gal->IsOpenGlEngine() && !shape.IsTriangulationUpToDate() )
-                    shape.CacheTriangulation();
+                    const_cast<SHAPE_POLY_SET&>( shape ).CacheTriangulation();
 
                 m_gal->DrawPolygon( shape );
             }
@@ -1514,6 +1592,17 @@ void PCB_PAINTER::draw( const PCB_GROUP* aGroup, int aLayer )
 }
 
 
+int PCB_PAINTER::ZoneFillLOD( double aWorldScale )
+{
+    int pixelSize = KiROUND( 1.0 / aWorldScale );
+
+    if( pixelSize <= ARC_HIGH_DEF )
+        return 0;
+
+    return ZONE::FillLODTolerance( pixelSize );
+}
+
+
 void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
 {
     /**
@@ -1532,10 +1621,18 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
     std::deque<VECTOR2D> corners;
     ZONE_DISPLAY_MODE displayMode = m_pcbSettings.m_zoneDisplayMode;
 
+    bool showFill = displayMode == ZONE_DISPLAY_MODE::SHOW_FILLED
+                    || displayMode == ZONE_DISPLAY_MODE::SHOW_FILLED_OUTLINE;
+
+    // OpenGL would triangulate the fill on this thread while it is still being triangulated in
+    // the background (see PCB_DRAW_PANEL_GAL::DisplayBoard()), so show the outline until then.
+    bool fillPending = showFill && m_gal->IsOpenGlEngine() && m_zoneFillTriangulation
+                       && m_zoneFillTriangulation->IsPending( aZone );
+
     // Draw the outline
     const SHAPE_POLY_SET* outline = aZone->Outline();
 
-    if( m_pcbSettings.m_zoneOutlines && outline && outline->OutlineCount() > 0 )
+    if( ( m_pcbSettings.m_zoneOutlines || fillPending ) && outline && outline->OutlineCount() > 0 )
     {
         m_gal->SetStrokeColor( color );
         m_gal->SetIsFill( false );
@@ -1565,14 +1662,24 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
     }
 
     // Draw the filling
-    if( displayMode == ZONE_DISPLAY_MODE::SHOW_FILLED
-            || displayMode == ZONE_DISPLAY_MODE::SHOW_FILLED_OUTLINE )
+    if( showFill && !fillPending )
     {
-        const SHAPE_POLY_SET& polySet = aZone->GetFilledPolysList( layer );
+        const SHAPE_POLY_SET* polySet = &aZone->GetFilledPolysList( layer );
 
-        if( polySet.OutlineCount() == 0 )  // Nothing to draw
+        if( polySet->OutlineCount() == 0 )  // Nothing to draw
             return;
 
+        // When zoomed out draw a copy of the fill decimated to the pixel size.  OpenGL caches
+        // it in a group, which PCB_VIEW::SetScale() redraws when the level changes.  Printing
+        // needs the exact geometry.
+        if( !m_pcbSettings.IsPrinting() && polySet->TotalVertices() > ZONE_LOD_MIN_VERTICES )
+        {
+            int lod = ZoneFillLOD( m_gal->GetWorldScale() );
+
+            if( lod > 0 )
+                polySet = &aZone->GetFilledPolysLOD( layer, lod );
+        }
+
         // Set up drawing options
         int outline_thickness = 0;
 
@@ -1594,7 +1701,7 @@ void PCB_PAINTER::draw( const ZONE* aZone, int aLayer )
             m_gal->SetIsStroke( true );
         }
 
-        m_gal->DrawPolygon( polySet );
+        m_gal->DrawPolygon( *polySet );
     }
 }
 
@@ -53,6 +53,7 @@ class PCB_TARGET;
 class PCB_MARKER;
 class NET_SETTINGS;
 class NETINFO_LIST;
+class ZONE_FILL_TRIANGULATION;
 
 namespace KIGFX
 {
@@ -252,6 +253,34 @@ public:
     /// @copydoc PAINTER::Draw()
     virtual bool Draw( const VIEW_ITEM* aItem, int aLayer ) override;
 
+    /// @copydoc PAINTER::Prepare()
+    virtual void Prepare( const VIEW_ITEM* aItem ) override;
+
+    /// @copydoc PAINTER::Clone()
+    virtual PAINTER* Clone( GAL* aGal ) const override;
+
+    /// @copydoc PAINTER::CanDraw()
+    virtual bool CanDraw( const VIEW_ITEM* aItem ) const override;
+
+    /**
+     * Set the zone fills being triangulated in the background (see
+     * PCB_DRAW_PANEL_GAL::DisplayBoard()), or nullptr.  OpenGL draws only the outline of the
+     * zones still waiting for their fills.
+     */
+    void SetZoneFillTriangulation( const ZONE_FILL_TRIANGULATION* aJob )
+    {
+        m_zoneFillTriangulation = aJob;
+    }
+
+    ///< Zone fills with more vertices than this are drawn decimated when zoomed out
+    static constexpr int ZONE_LOD_MIN_VERTICES = 1000;
+
+    /**
+     * @return the maximum error of the decimated copy drawn for large zone fills at
+     *         \a aWorldScale (see ZONE::GetFilledPolysLOD()), or 0 to draw them as they are.
+     */
+    static int ZoneFillLOD( double aWorldScale );
+
 protected:
     // Drawing functions for various types of PCB-specific items
     void draw( const TRACK* aTrack, int aLayer );
@@ -293,6 +322,8 @@ protected:
 
 protected:
     PCB_RENDER_SETTINGS m_pcbSettings;
+
+    const ZONE_FILL_TRIANGULATION* m_zoneFillTriangulation;
 };
 } // namespace KIGFX
 
@@ -33,6 +33,7 @@ using namespace std::placeholders;
 
 #include <pcb_group.h>
 #include <footprint.h>
+#include <zone.h>
 
 namespace KIGFX {
 PCB_VIEW::PCB_VIEW( bool aIsDynamic ) :
@@ -73,6 +74,32 @@ void PCB_VIEW::Add( KIGFX::VIEW_ITEM* aItem, int aDrawPriority )
 }
 
 
+void PCB_VIEW::Add( const std::vector<KIGFX::VIEW_ITEM*>& aItems )
+{
+    std::vector<KIGFX::VIEW_ITEM*> items;
+
+    items.reserve( aItems.size() );
+
+    for( KIGFX::VIEW_ITEM* item : aItems )
+    {
+        BOARD_ITEM* boardItem = dynamic_cast<BOARD_ITEM*>( item );
+
+        if( boardItem && boardItem->Type() == PCB_FOOTPRINT_T )
+        {
+            FOOTPRINT* footprint = static_cast<FOOTPRINT*>( boardItem );
+            footprint->RunOnChildren( [&items]( BOARD_ITEM* aChild )
+                                      {
+                                          items.push_back( aChild );
+                                      } );
+        }
+
+        items.push_back( item );
+    }
+
+    VIEW::Add( items );
+}
+
+
 void PCB_VIEW::Remove( KIGFX::VIEW_ITEM* aItem )
 {
     BOARD_ITEM* boardItem = dynamic_cast<BOARD_ITEM*>( aItem );
@@ -123,6 +150,47 @@ void PCB_VIEW::Update( const KIGFX::VIEW_ITEM* aItem ) const
 }
 
 
+void PCB_VIEW::SetScale( double aScale, VECTOR2D aAnchor )
+{
+    int oldLOD = PCB_PAINTER::ZoneFillLOD( GetGAL()->GetWorldScale() );
+
+    VIEW::SetScale( aScale, aAnchor );
+
+    // Cairo draws everything again anyway
+    if( GetGAL()->IsCairoEngine()
+            || PCB_PAINTER::ZoneFillLOD( GetGAL()->GetWorldScale() ) == oldLOD )
+    {
+        return;
+    }
+
+    UpdateAllItemsConditionally( KIGFX::REPAINT,
+            []( KIGFX::VIEW_ITEM* aItem ) -> bool
+            {
+                BOARD_ITEM* boardItem = dynamic_cast<BOARD_ITEM*>( aItem );
+
+                if( !boardItem || ( boardItem->Type() != PCB_ZONE_T
+                                    && boardItem->Type() != PCB_FP_ZONE_T ) )
+                {
+                    return false;
+                }
+
+                ZONE* zone = static_cast<ZONE*>( boardItem );
+
+                for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+                {
+                    if( zone->HasFilledPolysForLayer( layer )
+                            && zone->GetFilledPolysList( layer ).TotalVertices()
+                                       > PCB_PAINTER::ZONE_LOD_MIN_VERTICES )
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            } );
+}
+
+
 void PCB_VIEW::UpdateDisplayOptions( const PCB_DISPLAY_OPTIONS& aOptions )
 {
     auto    painter     = static_cast<KIGFX::PCB_PAINTER*>( GetPainter() );
@@ -41,6 +41,9 @@ public:
 
     /// @copydoc VIEW::Add()
     virtual void Add( VIEW_ITEM* aItem, int aDrawPriority = -1 ) override;
+
+    /// @copydoc VIEW::Add()
+    virtual void Add( const std::vector<VIEW_ITEM*>& aItems ) override;
     /// @copydoc VIEW::Remove()
 
     virtual void Remove( VIEW_ITEM* aItem ) override;
@@ -51,6 +54,14 @@ public:
     /// @copydoc VIEW::Update()
     virtual void Update( const VIEW_ITEM* aItem ) const override;
 
+    /**
+     * @copydoc VIEW::SetScale()
+     *
+     * Also redraws the cached zone fills whose decimation level (see
+     * PCB_PAINTER::ZoneFillLOD()) changes with the scale.
+     */
+    virtual void SetScale( double aScale, VECTOR2D aAnchor = { 0, 0 } ) override;
+
     void UpdateDisplayOptions( const PCB_DISPLAY_OPTIONS& aOptions );
 };
 
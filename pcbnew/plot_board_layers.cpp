@@ -828,7 +828,7 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
         // Merge all polygons: After deflating, not merged (not overlapping) polygons
         // will have the initial shape (with perhaps small changes due to deflating transform)
         areas.Simplify( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
-        areas.Deflate( inflate, numSegs );
+        areas.Deflate( inflate, numSegs, SHAPE_POLY_SET::ROUND_ALL_CORNERS, 0 );
     }
 
 #if !NEW_ALGO
@@ -858,7 +858,7 @@ void PlotSolderMaskLayer( BOARD *aBoard, PLOTTER* aPlotter, LSET aLayerMask,
 
     // Slightly inflate polygons to avoid any gap between them and other shapes,
     // These gaps are created by arc to segments approximations
-    areas.Inflate( Millimeter2iu( 0.002 ),6 );
+    areas.Inflate( Millimeter2iu( 0.002 ), 6, SHAPE_POLY_SET::ROUND_ALL_CORNERS, 0 );
 
     // Now, only polygons with a too small thickness are stored in areas.
     areas.Fracture( SHAPE_POLY_SET::PM_STRICTLY_SIMPLE );
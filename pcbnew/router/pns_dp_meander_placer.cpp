@@ -41,6 +41,8 @@ DP_MEANDER_PLACER::DP_MEANDER_PLACER( ROUTER* aRouter ) :
 
     m_padToDieP = 0;
     m_padToDieN = 0;
+    m_tunedPathLengthP = 0;
+    m_tunedPathLengthN = 0;
 
     // Init temporary variables (do not leave uninitialized members)
     m_initialSegment = NULL;
@@ -102,6 +104,8 @@ bool DP_MEANDER_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
 
     m_tunedPathP = topo.AssembleTrivialPath( m_originPair.PLine().GetLink( 0 ) );
     m_tunedPathN = topo.AssembleTrivialPath( m_originPair.NLine().GetLink( 0 ) );
+    m_tunedPathLengthP = pathLength( m_tunedPathP );
+    m_tunedPathLengthN = pathLength( m_tunedPathN );
 
     m_padToDieP = GetTotalPadToDieLength( m_originPair.PLine() );
     m_padToDieN = GetTotalPadToDieLength( m_originPair.NLine() );
@@ -123,23 +127,7 @@ void DP_MEANDER_PLACER::release()
 
 long long int DP_MEANDER_PLACER::origPathLength() const
 {
-    long long int totalP = m_padToDieLenth;
-    long long int totalN = m_padToDieLenth;
-
-    for( const ITEM* item : m_tunedPathP.CItems() )
-    {
-        if( const LINE* l = dyn_cast<const LINE*>( item ) )
-            totalP += l->CLine().Length();
-
-    }
-
-    for( const ITEM* item : m_tunedPathN.CItems() )
-    {
-        if( const LINE* l = dyn_cast<const LINE*>( item ) )
-            totalN += l->CLine().Length();
-    }
-
-    return std::max( totalP, totalN );
+    return m_padToDieLenth + std::max( m_tunedPathLengthP, m_tunedPathLengthN );
 }
 
 
@@ -134,6 +134,9 @@ private:
     LINE m_currentTraceN, m_currentTraceP;
     ITEM_SET m_tunedPath, m_tunedPathP, m_tunedPathN;
 
+    ///< Lengths of the lines in m_tunedPathP and m_tunedPathN, excluding pad to die length.
+    long long int m_tunedPathLengthP, m_tunedPathLengthN;
+
     SHAPE_LINE_CHAIN m_finalShapeP, m_finalShapeN;
     MEANDERED_LINE m_result;
     LINKED_ITEM* m_initialSegment;
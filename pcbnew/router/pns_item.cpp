@@ -28,6 +28,13 @@ typedef VECTOR2I::extended_type ecoord;
 
 namespace PNS {
 
+bool& ITEM::HoleMarking()
+{
+    static thread_local bool enabled = true;
+    return enabled;
+}
+
+
 bool ITEM::collideSimple( const ITEM* aOther, const NODE* aNode, bool aDifferentNetsOnly ) const
 {
     const ROUTER_IFACE* iface = ROUTER::GetInstance()->GetInterface();
@@ -58,15 +65,21 @@ bool ITEM::collideSimple( const ITEM* aOther, const NODE* aNode, bool aDifferent
     {
         int holeClearance = aNode->GetHoleClearance( this, aOther );
 
+        bool markHoles = HoleMarking();
+
         if( holeA && holeA->Collide( shapeB, holeClearance + lineWidthB ) )
         {
-            Mark( Marker() | MK_HOLE );
+            if( markHoles )
+                Mark( Marker() | MK_HOLE );
+
             return true;
         }
 
         if( holeB && holeB->Collide( shapeA, holeClearance + lineWidthA ) )
         {
-            aOther->Mark( aOther->Marker() | MK_HOLE );
+            if( markHoles )
+                aOther->Mark( aOther->Marker() | MK_HOLE );
+
             return true;
         }
 
@@ -76,8 +89,12 @@ bool ITEM::collideSimple( const ITEM* aOther, const NODE* aNode, bool aDifferent
 
             if( holeA->Collide( holeB, holeToHoleClearance ) )
             {
-                Mark( Marker() | MK_HOLE );
-                aOther->Mark( aOther->Marker() | MK_HOLE );
+                if( markHoles )
+                {
+                    Mark( Marker() | MK_HOLE );
+                    aOther->Mark( aOther->Marker() | MK_HOLE );
+                }
+
                 return true;
             }
         }
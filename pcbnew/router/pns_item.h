@@ -207,6 +207,13 @@ public:
     virtual void Unmark( int aMarker = -1 ) const { m_marker &= ~aMarker; }
     virtual int Marker() const { return m_marker; }
 
+    /**
+     * @return the flag enabling the #MK_HOLE markers set by the collision queries of the
+     *         calling thread.  Searches sharing the items with another thread clear it; the
+     *         violation display repeats its queries, so it doesn't lose any markers.
+     */
+    static bool& HoleMarking();
+
     virtual void SetRank( int aRank ) { m_rank = aRank; }
     virtual int Rank() const { return m_rank; }
 
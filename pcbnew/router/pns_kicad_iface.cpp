@@ -47,6 +47,7 @@
 #include <drc/drc_engine.h>
 
 #include <memory>
+#include <mutex>
 
 #include <advanced_config.h>
 
@@ -67,6 +68,11 @@
 
 typedef VECTOR2I::extended_type ecoord;
 
+/// Serializes the board and DRC engine queries of the collision checks, which the walkaround
+/// makes from two threads at once.
+static std::recursive_mutex s_boardQueryLock;
+
+
 class PNS_PCBNEW_RULE_RESOLVER : public PNS::RULE_RESOLVER
 {
 public:
@@ -181,7 +187,8 @@ bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
                                                 const PNS::ITEM* aItemA, const PNS::ITEM* aItemB,
                                                 int aLayer, PNS::CONSTRAINT* aConstraint )
 {
-    std::shared_ptr<DRC_ENGINE> drcEngine = m_board->GetDesignSettings().m_DRCEngine;
+    std::lock_guard<std::recursive_mutex> lock( s_boardQueryLock );
+    std::shared_ptr<DRC_ENGINE>           drcEngine = m_board->GetDesignSettings().m_DRCEngine;
 
     if( !drcEngine )
         return false;
@@ -275,6 +282,7 @@ bool PNS_PCBNEW_RULE_RESOLVER::QueryConstraint( PNS::CONSTRAINT_TYPE aType,
 
 int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* aB )
 {
+    std::lock_guard<std::recursive_mutex>         lock( s_boardQueryLock );
     std::pair<const PNS::ITEM*, const PNS::ITEM*> key( aA, aB );
     auto it = m_clearanceCache.find( key );
 
@@ -311,6 +319,7 @@ int PNS_PCBNEW_RULE_RESOLVER::Clearance( const PNS::ITEM* aA, const PNS::ITEM* a
 
 int PNS_PCBNEW_RULE_RESOLVER::HoleClearance( const PNS::ITEM* aA, const PNS::ITEM* aB )
 {
+    std::lock_guard<std::recursive_mutex>         lock( s_boardQueryLock );
     std::pair<const PNS::ITEM*, const PNS::ITEM*> key( aA, aB );
     auto it = m_holeClearanceCache.find( key );
 
@@ -333,6 +342,7 @@ int PNS_PCBNEW_RULE_RESOLVER::HoleClearance( const PNS::ITEM* aA, const PNS::ITE
 
 int PNS_PCBNEW_RULE_RESOLVER::HoleToHoleClearance( const PNS::ITEM* aA, const PNS::ITEM* aB )
 {
+    std::lock_guard<std::recursive_mutex>         lock( s_boardQueryLock );
     std::pair<const PNS::ITEM*, const PNS::ITEM*> key( aA, aB );
     auto it = m_holeToHoleClearanceCache.find( key );
 
@@ -732,6 +742,8 @@ public:
         if( !m_view )
             return;
 
+        std::lock_guard<std::mutex> lock( m_lock );
+
         ROUTER_PREVIEW_ITEM* pitem = new ROUTER_PREVIEW_ITEM( NULL, m_view );
 
         pitem->Line( aLine, aWidth, aType );
@@ -743,6 +755,8 @@ public:
     {
         if( m_view && m_items )
         {
+            std::lock_guard<std::mutex> lock( m_lock );
+
             m_items->FreeItems();
             m_view->Update( m_items );
         }
@@ -751,6 +765,7 @@ public:
 private:
     KIGFX::VIEW* m_view;
     KIGFX::VIEW_GROUP* m_items;
+    std::mutex m_lock;       ///< The walkaround windings draw from two threads
 };
 
 
@@ -1156,6 +1171,9 @@ bool PNS_KICAD_IFACE::IsFlashedOnLayer( const PNS::ITEM* aItem, int aLayer ) con
 
     if( aItem->Parent() )
     {
+        // Unconnected layer removal looks the item up in the connectivity data
+        std::lock_guard<std::recursive_mutex> lock( s_boardQueryLock );
+
         switch( aItem->Parent()->Type() )
         {
         case PCB_VIA_T:
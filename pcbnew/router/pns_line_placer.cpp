@@ -191,8 +191,8 @@ bool LINE_PLACER::handlePullback()
 
     DIRECTION_45 first_head, last_tail;
 
-    const std::vector<ssize_t>& headShapes = head.CShapes();
-    const std::vector<ssize_t>& tailShapes = tail.CShapes();
+    const SHAPE_LINE_CHAIN::SHAPE_VECTOR& headShapes = head.CShapes();
+    const SHAPE_LINE_CHAIN::SHAPE_VECTOR& tailShapes = tail.CShapes();
 
     wxASSERT( tail.PointCount() >= 2 );
     if( headShapes[0] == -1 )
@@ -353,8 +353,8 @@ bool LINE_PLACER::mergeHead()
 
     DIRECTION_45 dir_tail, dir_head;
 
-    const std::vector<ssize_t>& headShapes = head.CShapes();
-    const std::vector<ssize_t>& tailShapes = tail.CShapes();
+    const SHAPE_LINE_CHAIN::SHAPE_VECTOR& headShapes = head.CShapes();
+    const SHAPE_LINE_CHAIN::SHAPE_VECTOR& tailShapes = tail.CShapes();
 
     if( headShapes[0] == -1 )
         dir_head = DIRECTION_45( head.CSegment( 0 ) );
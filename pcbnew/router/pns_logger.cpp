@@ -21,6 +21,8 @@
 
 #include "pns_logger.h"
 #include "pns_item.h"
+#include "pns_itemset.h"
+#include "pns_routing_settings.h"
 #include "pns_via.h"
 #include "pns_line.h"
 #include "pns_segment.h"
@@ -32,8 +34,85 @@
 #include <geometry/shape_circle.h>
 #include <geometry/shape_simple.h>
 
+#include <fstream>
+
 namespace PNS {
 
+/**
+ * The routing settings logged with route and drag starts.  Keys are the names written to the
+ * log, so they must not change.
+ */
+struct LOGGED_SETTING
+{
+    const char* key;
+    int  ( *get )( const ROUTING_SETTINGS& );
+    void ( *set )( ROUTING_SETTINGS&, int );
+};
+
+
+static const LOGGED_SETTING loggedSettings[] = {
+    { "routing_mode",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.Mode(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetMode( (PNS_MODE) v ); } },
+    { "optimizer_effort",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.OptimizerEffort(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetOptimizerEffort( (PNS_OPTIMIZATION_EFFORT) v ); } },
+    { "corner_mode",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.GetCornerMode(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetCornerMode( (CORNER_MODE) v ); } },
+    { "shove_vias",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.ShoveVias(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetShoveVias( v != 0 ); } },
+    { "remove_loops",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.RemoveLoops(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetRemoveLoops( v != 0 ); } },
+    { "smart_pads",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.SmartPads(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetSmartPads( v != 0 ); } },
+    { "follow_mouse",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.FollowMouse(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetFollowMouse( v != 0 ); } },
+    { "jump_over_obstacles",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.JumpOverObstacles(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetJumpOverObstacles( v != 0 ); } },
+    { "smooth_dragged_segments",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.SmoothDraggedSegments(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetSmoothDraggedSegments( v != 0 ); } },
+    { "can_violate_drc",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.CanViolateDRC(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetCanViolateDRC( v != 0 ); } },
+    { "free_angle_mode",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.GetFreeAngleMode(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetFreeAngleMode( v != 0 ); } },
+    { "optimize_dragged_track",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.GetOptimizeDraggedTrack(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetOptimizeDraggedTrack( v != 0 ); } },
+    { "auto_posture",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.GetAutoPosture(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetAutoPosture( v != 0 ); } },
+    { "fix_all_segments",
+      []( const ROUTING_SETTINGS& s ) { return (int) s.GetFixAllSegments(); },
+      []( ROUTING_SETTINGS& s, int v ) { s.SetFixAllSegments( v != 0 ); } },
+};
+
+
+static KIID parentUuid( const ITEM* aItem )
+{
+    return aItem && aItem->Parent() ? aItem->Parent()->m_Uuid : niluuid;
+}
+
+
+static wxString uuidString( const KIID& aUuid )
+{
+    return aUuid == niluuid ? wxString( "null" ) : aUuid.AsString();
+}
+
+
+static KIID parseUuid( const std::string& aText )
+{
+    return aText == "null" ? niluuid : KIID( wxString( aText ) );
+}
+
 LOGGER::LOGGER( )
 {
 }
@@ -56,20 +135,126 @@ void LOGGER::Save( const std::string& aFilename )
 
     wxLogTrace( "PNS", "Saving to '%s' [%p]", aFilename.c_str(), f );
 
-    for( const auto evt : m_events )
+    if( !f )
+        return;
+
+    for( const EVENT_ENTRY& evt : m_events )
     {
-        uint64_t id = 0;
-        if( evt.item && evt.item->Parent() )
+        // The router state follows as optional key=value fields
+        wxString line = wxString::Format( "event %d %d %d %s", evt.type, evt.p.x, evt.p.y,
+                                          uuidString( evt.uuid ) );
+
+        if( evt.layer >= 0 )
+            line << " layer=" << evt.layer;
+
+        if( evt.routerMode >= 0 )
+            line << " router_mode=" << evt.routerMode;
+
+        if( evt.dragMode >= 0 )
+            line << " drag_mode=" << evt.dragMode;
+
+        if( !evt.startItems.empty() )
+        {
+            line << " items=";
+
+            for( size_t i = 0; i < evt.startItems.size(); i++ )
+                line << ( i ? "," : "" ) << uuidString( evt.startItems[i] );
+        }
+
+        if( !evt.addedItems.empty() )
         {
-            const char* idString = evt.item->Parent()->m_Uuid.AsString().c_str();
-            fprintf( f, "event %d %d %d %s\n", evt.type, evt.p.x, evt.p.y, idString );
+            line << " added=";
+
+            for( size_t i = 0; i < evt.addedItems.size(); i++ )
+                line << ( i ? "," : "" ) << uuidString( evt.addedItems[i] );
         }
+
+        for( const std::pair<const std::string, int>& setting : evt.settings )
+            line << " " << setting.first << "=" << setting.second;
+
+        fprintf( f, "%s\n", (const char*) line.c_str() );
     }
 
     fclose( f );
 }
 
 
+bool LOGGER::Load( const std::string& aFilename )
+{
+    std::ifstream f( aFilename );
+
+    if( !f )
+        return false;
+
+    m_events.clear();
+
+    std::string line;
+
+    while( std::getline( f, line ) )
+    {
+        if( line.empty() || line[0] == '#' )
+            continue;
+
+        std::istringstream fields( line );
+        std::string        tag, id, field;
+        int                type, x, y;
+
+        if( !( fields >> tag >> type >> x >> y >> id ) || tag != "event"
+                || type < EVT_START_ROUTE || type > EVT_ABORT )
+        {
+            return false;
+        }
+
+        EVENT_ENTRY ent;
+
+        ent.type = static_cast<EVENT_TYPE>( type );
+        ent.p = VECTOR2I( x, y );
+        ent.item = nullptr;
+        ent.uuid = parseUuid( id );
+
+        while( fields >> field )
+        {
+            size_t sep = field.find( '=' );
+
+            if( sep == std::string::npos || sep == 0 )
+                return false;
+
+            std::string key = field.substr( 0, sep );
+            std::string value = field.substr( sep + 1 );
+
+            if( key == "items" || key == "added" )
+            {
+                std::vector<KIID>& uuids = key == "items" ? ent.startItems : ent.addedItems;
+                std::istringstream ids( value );
+
+                while( std::getline( ids, id, ',' ) )
+                    uuids.push_back( parseUuid( id ) );
+
+                continue;
+            }
+
+            int intValue;
+
+            if( !( std::istringstream( value ) >> intValue ) )
+                return false;
+
+            if( key == "layer" )
+                ent.layer = intValue;
+            else if( key == "router_mode" )
+                ent.routerMode = intValue;
+            else if( key == "drag_mode" )
+                ent.dragMode = intValue;
+            else
+                ent.settings[key] = intValue;
+        }
+
+        m_events.push_back( ent );
+    }
+
+    return true;
+}
+
+
 void LOGGER::Log( LOGGER::EVENT_TYPE evt, VECTOR2I pos, const ITEM* item )
 {
     LOGGER::EVENT_ENTRY ent;
@@ -77,9 +262,67 @@ void LOGGER::Log( LOGGER::EVENT_TYPE evt, VECTOR2I pos, const ITEM* item )
     ent.type = evt;
     ent.p = pos;
     ent.item = item;
+    ent.uuid = parentUuid( item );
 
     m_events.push_back( ent );
+}
+
+
+void LOGGER::LogStartRoute( const VECTOR2I& aPos, const ITEM* aStartItem, int aLayer,
+                            int aRouterMode, const ROUTING_SETTINGS& aSettings )
+{
+    Log( EVT_START_ROUTE, aPos, aStartItem );
+
+    EVENT_ENTRY& ent = m_events.back();
+
+    ent.layer = aLayer;
+    ent.routerMode = aRouterMode;
 
+    for( const LOGGED_SETTING& setting : loggedSettings )
+        ent.settings[setting.key] = setting.get( aSettings );
+}
+
+
+void LOGGER::LogStartDrag( const VECTOR2I& aPos, const ITEM_SET& aStartItems, int aDragMode,
+                           int aRouterMode, const ROUTING_SETTINGS& aSettings )
+{
+    Log( EVT_START_DRAG, aPos, aStartItems.Empty() ? nullptr : aStartItems[0] );
+
+    EVENT_ENTRY& ent = m_events.back();
+
+    ent.dragMode = aDragMode;
+    ent.routerMode = aRouterMode;
+
+    for( const ITEM_SET::ENTRY& entry : aStartItems.CItems() )
+        ent.startItems.push_back( parentUuid( entry.item ) );
+
+    for( const LOGGED_SETTING& setting : loggedSettings )
+        ent.settings[setting.key] = setting.get( aSettings );
+}
+
+
+void LOGGER::LogCommit( const std::vector<ITEM*>& aAdded )
+{
+    if( m_events.empty() )
+        return;
+
+    EVENT_ENTRY& ent = m_events.back();
+
+    for( const ITEM* item : aAdded )
+        ent.addedItems.push_back( parentUuid( item ) );
+}
+
+
+void LOGGER::ApplySettings( const std::map<std::string, int>& aValues,
+                            ROUTING_SETTINGS& aSettings )
+{
+    for( const LOGGED_SETTING& setting : loggedSettings )
+    {
+        auto it = aValues.find( setting.key );
+
+        if( it != aValues.end() )
+            setting.set( aSettings, it->second );
+    }
 }
 
 }
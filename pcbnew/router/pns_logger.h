@@ -23,11 +23,13 @@
 #define __PNS_LOGGER_H
 
 #include <cstdio>
+#include <map>
 #include <vector>
 #include <string>
 #include <sstream>
 
 #include <math/vector2d.h>
+#include <kiid.h>
 
 class SHAPE_LINE_CHAIN;
 class SHAPE;
@@ -35,6 +37,8 @@ class SHAPE;
 namespace PNS {
 
 class ITEM;
+class ITEM_SET;
+class ROUTING_SETTINGS;
 
 class LOGGER
 {
@@ -52,15 +56,62 @@ public:
         VECTOR2I p;
         EVENT_TYPE type;
         const ITEM* item;
+        KIID uuid;      ///< UUID of the item's parent board item, niluuid if there is none
+
+        // The router state below is only logged for EVT_START_ROUTE and EVT_START_DRAG
+
+        int layer = -1;                         ///< routing layer of a route start
+        int routerMode = -1;                    ///< ROUTER_MODE
+        int dragMode = -1;                      ///< DRAG_MODE flags of a drag start
+        std::vector<KIID> startItems;           ///< parents of every item a drag starts with
+        std::map<std::string, int> settings;    ///< ROUTING_SETTINGS values, by name
+
+        ///< Parents of the items committed while handling the event, in the order they were
+        ///< added.  Later events refer to the new board items by these UUIDs.
+        std::vector<KIID> addedItems;
     };
 
     LOGGER();
     ~LOGGER();
 
     void Save( const std::string& aFilename );
+
+    /**
+     * Read back an event log written by Save().  Loaded events refer to board items by
+     * UUID only; their item pointers are null.
+     *
+     * @return false if the file cannot be opened or contains a malformed line.
+     */
+    bool Load( const std::string& aFilename );
+
     void Clear();
     void Log( EVENT_TYPE evt, VECTOR2I pos, const ITEM* item = nullptr );
 
+    /**
+     * Log the start of a route together with the router state needed to replay it.
+     */
+    void LogStartRoute( const VECTOR2I& aPos, const ITEM* aStartItem, int aLayer,
+                        int aRouterMode, const ROUTING_SETTINGS& aSettings );
+
+    /**
+     * Log the start of a drag of \a aStartItems together with the router state needed to
+     * replay it.
+     */
+    void LogStartDrag( const VECTOR2I& aPos, const ITEM_SET& aStartItems, int aDragMode,
+                       int aRouterMode, const ROUTING_SETTINGS& aSettings );
+
+    /**
+     * Record the parents of the items committed while handling the last event logged.
+     */
+    void LogCommit( const std::vector<ITEM*>& aAdded );
+
+    /**
+     * Restore the routing settings logged with a route or drag start.  Settings missing from
+     * \a aValues are left unchanged.
+     */
+    static void ApplySettings( const std::map<std::string, int>& aValues,
+                               ROUTING_SETTINGS& aSettings );
+
     const std::vector<EVENT_ENTRY>& GetEvents()
     {
         return m_events;
@@ -40,6 +40,7 @@ MEANDER_PLACER::MEANDER_PLACER( ROUTER* aRouter ) :
     m_initialSegment = NULL;
     m_lastLength = 0;
     m_lastStatus = TOO_SHORT;
+    m_tunedPathLength = 0;
 }
 
 
@@ -76,6 +77,7 @@ bool MEANDER_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
 
     TOPOLOGY topo( m_world );
     m_tunedPath = topo.AssembleTrivialPath( m_initialSegment );
+    m_tunedPathLength = pathLength( m_tunedPath );
 
     m_world->Remove( m_originLine );
 
@@ -88,16 +90,7 @@ bool MEANDER_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
 
 long long int MEANDER_PLACER::origPathLength() const
 {
-    long long int total = m_padToDieLenth;
-    for( const ITEM* item : m_tunedPath.CItems() )
-    {
-        if( const LINE* l = dyn_cast<const LINE*>( item ) )
-        {
-            total += l->CLine().Length();
-        }
-    }
-
-    return total;
+    return m_padToDieLenth + m_tunedPathLength;
 }
 
 
@@ -122,7 +115,7 @@ bool MEANDER_PLACER::doMove( const VECTOR2I& aP, ITEM* aEndItem, long long int a
     m_result.SetWidth( m_originLine.Width() );
     m_result.SetBaselineOffset( 0 );
 
-    const std::vector<ssize_t>& tunedShapes = tuned.CShapes();
+    const SHAPE_LINE_CHAIN::SHAPE_VECTOR& tunedShapes = tuned.CShapes();
 
     for( int i = 0; i < tuned.SegmentCount(); i++ )
     {
@@ -113,6 +113,9 @@ protected:
     LINE     m_currentTrace;
     ITEM_SET m_tunedPath;
 
+    ///< Length of the lines in m_tunedPath, excluding pad to die length.
+    long long int m_tunedPathLength;
+
     SHAPE_LINE_CHAIN m_finalShape;
     MEANDERED_LINE   m_result;
     LINKED_ITEM*     m_initialSegment;
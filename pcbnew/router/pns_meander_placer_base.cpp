@@ -181,6 +181,20 @@ void MEANDER_PLACER_BASE::tuneLineLength( MEANDERED_LINE& aTuned, long long int
 }
 
 
+long long int MEANDER_PLACER_BASE::pathLength( const ITEM_SET& aPath ) const
+{
+    long long int total = 0;
+
+    for( const ITEM* item : aPath.CItems() )
+    {
+        if( const LINE* l = dyn_cast<const LINE*>( item ) )
+            total += l->CLine().Length();
+    }
+
+    return total;
+}
+
+
 int MEANDER_PLACER_BASE::GetTotalPadToDieLength( const LINE& aLine ) const
 {
     int   length = 0;
@@ -139,6 +139,14 @@ protected:
 
     VECTOR2I getSnappedStartPoint( LINKED_ITEM* aStartItem, VECTOR2I aStartPoint );
 
+    /**
+     * Sum the lengths of the lines in a path assembled by TOPOLOGY::AssembleTrivialPath().
+     *
+     * The tuned paths don't change while a placer is active, so placers compute this once
+     * in Start() instead of on every move.
+     */
+    long long int pathLength( const ITEM_SET& aPath ) const;
+
     ///< Pointer to world to search colliding items.
     NODE* m_world;
 
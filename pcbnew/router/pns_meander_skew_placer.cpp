@@ -63,6 +63,7 @@ bool MEANDER_SKEW_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
 
     TOPOLOGY topo( m_world );
     m_tunedPath = topo.AssembleTrivialPath( m_initialSegment );
+    m_tunedPathLength = pathLength( m_tunedPath );
 
     if( !topo.AssembleDiffPair ( m_initialSegment, m_originPair ) )
     {
@@ -104,24 +105,9 @@ bool MEANDER_SKEW_PLACER::Start( const VECTOR2I& aP, ITEM* aStartItem )
 }
 
 
-long long int MEANDER_SKEW_PLACER::origPathLength() const
-{
-    return itemsetLength ( m_tunedPath );
-}
-
-
 long long int MEANDER_SKEW_PLACER::itemsetLength( const ITEM_SET& aSet ) const
 {
-    long long int total = m_padToDieLenth;
-    for( const ITEM* item : aSet.CItems() )
-    {
-        if( const LINE* l = dyn_cast<const LINE*>( item ) )
-        {
-            total += l->CLine().Length();
-        }
-    }
-
-    return total;
+    return m_padToDieLenth + pathLength( aSet );
 }
 
 
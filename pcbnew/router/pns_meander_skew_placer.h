@@ -55,8 +55,6 @@ private:
     long long int currentSkew() const;
     long long int itemsetLength( const ITEM_SET& aSet ) const;
 
-    long long int origPathLength() const override;
-
     DIFF_PAIR m_originPair;
     ITEM_SET  m_tunedPath, m_tunedPathP, m_tunedPathN;
 
@@ -27,6 +27,7 @@
 #include <math/vector2d.h>
 
 #include <geometry/seg.h>
+#include <geometry/seg_batch.h>
 #include <geometry/shape_line_chain.h>
 
 #include "pns_arc.h"
@@ -54,7 +55,9 @@ NODE::NODE()
     m_parent = NULL;
     m_maxClearance = 800000;    // fixme: depends on how thick traces are.
     m_ruleResolver = NULL;
-    m_index = new INDEX;
+    m_joints = std::make_shared<JOINT_MAP>();
+    m_override = std::make_shared<std::unordered_set<ITEM*>>();
+    m_index = std::make_shared<INDEX>();
 
 #ifdef DEBUG
     allocNodes.insert( this );
@@ -64,11 +67,9 @@ NODE::NODE()
 
 NODE::~NODE()
 {
-    if( !m_children.empty() )
-    {
-        wxLogTrace( "PNS", "attempting to free a node that has kids." );
-        assert( false );
-    }
+    // The kids refer to items owned by this node, so they can't outlive it
+    wxCHECK2_MSG( m_children.empty(), releaseChildren(),
+                  wxT( "Attempting to free a node that has kids." ) );
 
 #ifdef DEBUG
     if( allocNodes.find( this ) == allocNodes.end() )
@@ -80,7 +81,7 @@ NODE::~NODE()
     allocNodes.erase( this );
 #endif
 
-    m_joints.clear();
+    m_joints.reset();
 
     for( ITEM* item : *m_index )
     {
@@ -90,8 +91,6 @@ NODE::~NODE()
 
     releaseGarbage();
     unlinkParent();
-
-    delete m_index;
 }
 
 int NODE::GetClearance( const ITEM* aA, const ITEM* aB ) const
@@ -133,15 +132,13 @@ NODE* NODE::Branch()
     child->m_root = isRoot() ? this : m_root;
     child->m_maxClearance = m_maxClearance;
 
-    // Immediate offspring of the root branch needs not copy anything. For the rest, deep-copy
-    // joints, overridden item maps and pointers to stored items.
+    // Immediate offspring of the root branch needs not copy anything. For the rest, share the
+    // joints, overridden item maps and pointers to stored items. The first modification of
+    // either this node or the child copies each shared container as a whole (see
+    // copyBranchDataOnWrite()); entries are not shared between the copies.
     if( !isRoot() )
     {
-        JOINT_MAP::iterator j;
-
-        for( ITEM* item : *m_index )
-            child->m_index->Add( item );
-
+        child->m_index = m_index;
         child->m_joints = m_joints;
         child->m_override = m_override;
     }
@@ -149,8 +146,8 @@ NODE* NODE::Branch()
 #if 0
     wxLogTrace( "PNS", "%d items, %d joints, %d overrides",
                 child->m_index->Size(),
-                (int) child->m_joints.size(),
-                (int) child->m_override.size() );
+                (int) child->m_joints->size(),
+                (int) child->m_override->size() );
 #endif
 
     return child;
@@ -166,6 +163,45 @@ void NODE::unlinkParent()
 }
 
 
+bool NODE::copyBranchDataOnWrite()
+{
+    if( m_index.use_count() == 1 && m_joints.use_count() == 1 && m_override.use_count() == 1 )
+        return true;
+
+    // The JOINT and ITEM pointers returned by lookups on this node point into the shared data,
+    // which would be left to the children only and freed with them.
+    wxCHECK_MSG( m_children.empty(), false,
+                 wxT( "Attempting to modify a node that shares its data with its kids." ) );
+
+    if( m_index.use_count() > 1 )
+    {
+        std::shared_ptr<INDEX> index = std::make_shared<INDEX>();
+
+        for( ITEM* item : *m_index )
+            index->Add( item );
+
+        m_index = index;
+    }
+
+    if( m_joints.use_count() > 1 )
+        m_joints = std::make_shared<JOINT_MAP>( *m_joints );
+
+    if( m_override.use_count() > 1 )
+        m_override = std::make_shared<std::unordered_set<ITEM*>>( *m_override );
+
+    return true;
+}
+
+
+void NODE::discardItem( ITEM* aItem )
+{
+    // Callers may still point to the item (e.g. through LINE links), so leave it to be freed
+    // with the rest of the garbage rather than deleting it now
+    aItem->SetOwner( NULL );
+    m_root->m_garbageItems.insert( aItem );
+}
+
+
 OBSTACLE_VISITOR::OBSTACLE_VISITOR( const ITEM* aItem ) :
     m_item( aItem ),
     m_node( NULL ),
@@ -237,6 +273,73 @@ struct NODE::DEFAULT_OBSTACLE_VISITOR : public OBSTACLE_VISITOR
         if( visit( aCandidate ) )
             return true;
 
+        // The index hits every segment whose box comes within the worst clearance of the head,
+        // so leave them for a batched distance check which spares most of them the clearance
+        // lookups of ITEM::Collide()
+        if( aCandidate->Kind() == ITEM::SEGMENT_T
+                && m_item->OfKind( ITEM::SEGMENT_T | ITEM::VIA_T ) )
+        {
+            SEGMENT* seg = static_cast<SEGMENT*>( aCandidate );
+
+            m_batchItems[m_batch.Size()] = seg;
+            m_batch.Add( seg->Seg() );
+
+            return !m_batch.Full() || Flush();
+        }
+
+        return check( aCandidate );
+    };
+
+    /**
+     * Check the segments left in the batch.  Must be called at the end of each query, before
+     * the world changes.
+     *
+     * @return false if the count limit has been reached.
+     */
+    bool Flush()
+    {
+        if( !m_batch.Size() )
+            return true;
+
+        const double* lowerBounds;
+        int           headReach;
+
+        if( m_item->Kind() == ITEM::VIA_T )
+        {
+            const VIA* via = static_cast<const VIA*>( m_item );
+
+            lowerBounds = m_batch.DistanceLowerBounds( via->Pos() );
+            headReach = ( via->Diameter() + 1 ) / 2;
+        }
+        else
+        {
+            const SEGMENT* seg = static_cast<const SEGMENT*>( m_item );
+
+            lowerBounds = m_batch.DistanceLowerBounds( seg->Seg() );
+            headReach = ( seg->Width() + 1 ) / 2;
+        }
+
+        headReach += m_node->GetMaxClearance();
+
+        bool more = true;
+
+        for( int i = 0; i < m_batch.Size() && more; i++ )
+        {
+            double reach = headReach + ( m_batchItems[i]->Width() + 1 ) / 2;
+
+            if( lowerBounds[i] >= reach * reach )
+                continue;
+
+            more = check( m_batchItems[i] );
+        }
+
+        m_batch.Clear();
+        return more;
+    }
+
+private:
+    bool check( ITEM* aCandidate )
+    {
         if( !aCandidate->Collide( m_item, m_node, m_differentNetsOnly ) )
             return true;
 
@@ -252,7 +355,10 @@ struct NODE::DEFAULT_OBSTACLE_VISITOR : public OBSTACLE_VISITOR
             return false;
 
         return true;
-    };
+    }
+
+    SEG_BATCH  m_batch;             ///< Segment candidates waiting for check()
+    SEGMENT*   m_batchItems[SEG_BATCH::BLOCK_SIZE];
 };
 
 
@@ -270,12 +376,14 @@ int NODE::QueryColliding( const ITEM* aItem, NODE::OBSTACLES& aObstacles, int aK
 
     // first, look for colliding items in the local index
     m_index->Query( aItem, m_maxClearance, visitor );
+    visitor.Flush();
 
     // if we haven't found enough items, look in the root branch as well.
     if( !isRoot() && ( visitor.m_matchCount < aLimitCount || aLimitCount < 0 ) )
     {
         visitor.SetWorld( m_root, this );
         m_root->m_index->Query( aItem, m_maxClearance, visitor );
+        visitor.Flush();
     }
 
     return aObstacles.size();
@@ -316,8 +424,11 @@ NODE::OPT_OBSTACLE NODE::NearestObstacle( const LINE* aLine, int aKindMask,
                     nearest.m_item = obstacle;
                     nearest.m_hull = hull;
 
-                    obstacle->Mark( isHole ? obstacle->Marker() | MK_HOLE
-                                           : obstacle->Marker() & ~MK_HOLE );
+                    if( ITEM::HoleMarking() )
+                    {
+                        obstacle->Mark( isHole ? obstacle->Marker() | MK_HOLE
+                                               : obstacle->Marker() & ~MK_HOLE );
+                    }
                 }
             };
 
@@ -522,6 +633,12 @@ const ITEM_SET NODE::HitTest( const VECTOR2I& aPoint ) const
 
 void NODE::addSolid( SOLID* aSolid )
 {
+    if( !copyBranchDataOnWrite() )
+    {
+        discardItem( aSolid );
+        return;
+    }
+
     if( aSolid->IsRoutable() )
         linkJoint( aSolid->Pos(), aSolid->Layers(), aSolid->Net(), aSolid );
 
@@ -538,6 +655,12 @@ void NODE::Add( std::unique_ptr< SOLID > aSolid )
 
 void NODE::addVia( VIA* aVia )
 {
+    if( !copyBranchDataOnWrite() )
+    {
+        discardItem( aVia );
+        return;
+    }
+
     linkJoint( aVia->Pos(), aVia->Layers(), aVia->Net(), aVia );
 
     m_index->Add( aVia );
@@ -605,6 +728,12 @@ void NODE::Add( LINE& aLine, bool aAllowRedundant )
 
 void NODE::addSegment( SEGMENT* aSeg )
 {
+    if( !copyBranchDataOnWrite() )
+    {
+        discardItem( aSeg );
+        return;
+    }
+
     linkJoint( aSeg->Seg().A, aSeg->Layers(), aSeg->Net(), aSeg );
     linkJoint( aSeg->Seg().B, aSeg->Layers(), aSeg->Net(), aSeg );
 
@@ -632,6 +761,12 @@ bool NODE::Add( std::unique_ptr< SEGMENT > aSegment, bool aAllowRedundant )
 
 void NODE::addArc( ARC* aArc )
 {
+    if( !copyBranchDataOnWrite() )
+    {
+        discardItem( aArc );
+        return;
+    }
+
     linkJoint( aArc->Anchor( 0 ), aArc->Layers(), aArc->Net(), aArc );
     linkJoint( aArc->Anchor( 1 ), aArc->Layers(), aArc->Net(), aArc );
 
@@ -671,7 +806,7 @@ void NODE::doRemove( ITEM* aItem )
     // case 1: removing an item that is stored in the root node from any branch:
     // mark it as overridden, but do not remove
     if( aItem->BelongsTo( m_root ) && !isRoot() )
-        m_override.insert( aItem );
+        m_override->insert( aItem );
 
     // case 2: the item belongs to this branch or a parent, non-root branch,
     // or the root itself and we are the root: remove from the index
@@ -719,9 +854,9 @@ void NODE::rebuildJoint( JOINT* aJoint, ITEM* aItem )
     do
     {
         split = false;
-        auto range = m_joints.equal_range( tag );
+        auto range = m_joints->equal_range( tag );
 
-        if( range.first == m_joints.end() )
+        if( range.first == m_joints->end() )
             break;
 
         // find and remove all joints containing the via to be removed
@@ -730,7 +865,7 @@ void NODE::rebuildJoint( JOINT* aJoint, ITEM* aItem )
         {
             if( aItem->LayersOverlap( &f->second ) )
             {
-                m_joints.erase( f );
+                m_joints->erase( f );
                 split = true;
                 break;
             }
@@ -782,6 +917,9 @@ void NODE::Replace( LINE& aOldLine, LINE& aNewLine )
 
 void NODE::Remove( SOLID* aSolid )
 {
+    if( !copyBranchDataOnWrite() )
+        return;
+
     removeSolidIndex( aSolid );
     doRemove( aSolid );
 }
@@ -789,6 +927,9 @@ void NODE::Remove( SOLID* aSolid )
 
 void NODE::Remove( VIA* aVia )
 {
+    if( !copyBranchDataOnWrite() )
+        return;
+
     removeViaIndex( aVia );
     doRemove( aVia );
 }
@@ -796,6 +937,9 @@ void NODE::Remove( VIA* aVia )
 
 void NODE::Remove( SEGMENT* aSegment )
 {
+    if( !copyBranchDataOnWrite() )
+        return;
+
     removeSegmentIndex( aSegment );
     doRemove( aSegment );
 }
@@ -803,6 +947,9 @@ void NODE::Remove( SEGMENT* aSegment )
 
 void NODE::Remove( ARC* aArc )
 {
+    if( !copyBranchDataOnWrite() )
+        return;
+
     removeArcIndex( aArc );
     doRemove( aArc );
 }
@@ -1031,12 +1178,12 @@ JOINT* NODE::FindJoint( const VECTOR2I& aPos, int aLayer, int aNet )
     tag.net = aNet;
     tag.pos = aPos;
 
-    JOINT_MAP::iterator f = m_joints.find( tag ), end = m_joints.end();
+    JOINT_MAP::iterator f = m_joints->find( tag ), end = m_joints->end();
 
     if( f == end && !isRoot() )
     {
-        end = m_root->m_joints.end();
-        f = m_root->m_joints.find( tag );    // m_root->FindJoint(aPos, aLayer, aNet);
+        end = m_root->m_joints->end();
+        f = m_root->m_joints->find( tag );    // m_root->FindJoint(aPos, aLayer, aNet);
     }
 
     if( f == end )
@@ -1056,6 +1203,9 @@ JOINT* NODE::FindJoint( const VECTOR2I& aPos, int aLayer, int aNet )
 
 void NODE::LockJoint( const VECTOR2I& aPos, const ITEM* aItem, bool aLock )
 {
+    if( !copyBranchDataOnWrite() )
+        return;
+
     JOINT& jt = touchJoint( aPos, aItem->Layers(), aItem->Net() );
     jt.Lock( aLock );
 }
@@ -1069,17 +1219,17 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, int a
     tag.net = aNet;
 
     // try to find the joint in this node.
-    JOINT_MAP::iterator f = m_joints.find( tag );
+    JOINT_MAP::iterator f = m_joints->find( tag );
 
     std::pair<JOINT_MAP::iterator, JOINT_MAP::iterator> range;
 
     // not found and we are not root? find in the root and copy results here.
-    if( f == m_joints.end() && !isRoot() )
+    if( f == m_joints->end() && !isRoot() )
     {
-        range = m_root->m_joints.equal_range( tag );
+        range = m_root->m_joints->equal_range( tag );
 
         for( f = range.first; f != range.second; ++f )
-            m_joints.insert( *f );
+            m_joints->insert( *f );
     }
 
     // now insert and combine overlapping joints
@@ -1090,9 +1240,9 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, int a
     do
     {
         merged  = false;
-        range   = m_joints.equal_range( tag );
+        range   = m_joints->equal_range( tag );
 
-        if( range.first == m_joints.end() )
+        if( range.first == m_joints->end() )
             break;
 
         for( f = range.first; f != range.second; ++f )
@@ -1100,7 +1250,7 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, int a
             if( aLayers.Overlaps( f->second.Layers() ) )
             {
                 jt.Merge( f->second );
-                m_joints.erase( f );
+                m_joints->erase( f );
                 merged = true;
                 break;
             }
@@ -1108,7 +1258,7 @@ JOINT& NODE::touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, int a
     }
     while( merged );
 
-    return m_joints.insert( TagJointPair( tag, jt ) )->second;
+    return m_joints->insert( TagJointPair( tag, jt ) )->second;
 }
 
 
@@ -1165,7 +1315,7 @@ void NODE::Dump( bool aLong )
 
     if( aLong )
     {
-        for( j = m_joints.begin(); j != m_joints.end(); ++j )
+        for( j = m_joints->begin(); j != m_joints->end(); ++j )
         {
             wxLogTrace( "PNS", "joint : %s, links : %d\n",
                         j->second.GetPos().Format().c_str(), j->second.LinkCount() );
@@ -1217,7 +1367,7 @@ void NODE::Dump( bool aLong )
         lines_count++;
     }
 
-    wxLogTrace( "PNS", "Local joints: %d, lines : %d \n", m_joints.size(), lines_count );
+    wxLogTrace( "PNS", "Local joints: %d, lines : %d \n", m_joints->size(), lines_count );
 #endif
 }
 
@@ -1227,13 +1377,13 @@ void NODE::GetUpdatedItems( ITEM_VECTOR& aRemoved, ITEM_VECTOR& aAdded )
     if( isRoot() )
         return;
 
-    if( m_override.size() )
-        aRemoved.reserve( m_override.size() );
+    if( m_override->size() )
+        aRemoved.reserve( m_override->size() );
 
     if( m_index->Size() )
         aAdded.reserve( m_index->Size() );
 
-    for( ITEM* item : m_override )
+    for( ITEM* item : *m_override )
         aRemoved.push_back( item );
 
     for( INDEX::ITEM_SET::iterator i = m_index->begin(); i != m_index->end(); ++i )
@@ -1274,7 +1424,7 @@ void NODE::Commit( NODE* aNode )
     if( aNode->isRoot() )
         return;
 
-    for( ITEM* item : aNode->m_override )
+    for( ITEM* item : *aNode->m_override )
         Remove( item );
 
     for( ITEM* item : *aNode->m_index )
@@ -1426,7 +1576,7 @@ int NODE::QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints, LAYER_RA
 
     aJoints.clear();
 
-    for( JOINT_MAP::value_type& j : m_joints )
+    for( JOINT_MAP::value_type& j : *m_joints )
     {
         if( !j.second.Layers().Overlaps( aLayerMask ) )
             continue;
@@ -1441,7 +1591,7 @@ int NODE::QueryJoints( const BOX2I& aBox, std::vector<JOINT*>& aJoints, LAYER_RA
     if( isRoot() )
         return n;
 
-    for( JOINT_MAP::value_type& j : m_root->m_joints )
+    for( JOINT_MAP::value_type& j : *m_root->m_joints )
     {
         if( !Overrides( &j.second ) && j.second.Layers().Overlaps( aLayerMask ) )
         {
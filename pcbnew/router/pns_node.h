@@ -25,6 +25,7 @@
 
 #include <vector>
 #include <list>
+#include <memory>
 #include <unordered_set>
 #include <unordered_map>
 
@@ -145,6 +146,8 @@ protected:
  * - collision search & clearance checking.
  * - assembly of lines connecting joints, finding loops and unique paths.
  * - lightweight cloning/branching (for recursive optimization and shove springback).
+ *   Branches share their parent's joint map, override set and index until either side is
+ *   modified, so creating a branch is O(1) regardless of the depth of the branch chain.
  **/
 class NODE
 {
@@ -187,7 +190,7 @@ public:
     ///< Return the number of joints.
     int JointCount() const
     {
-        return m_joints.size();
+        return m_joints->size();
     }
 
     ///< Return the number of nodes in the inheritance chain (wrs to the root node).
@@ -295,7 +298,9 @@ public:
      * Create a lightweight copy (called branch) of self that tracks the changes (added/removed
      * items) wrs to the root.
      *
-     * @note If there are any branches in use, their parents must **not** be deleted.
+     * @note If there are any branches in use, their parents must **not** be deleted.  The
+     *       branch shares its parent's data until either is modified, and a node must not be
+     *       modified while it has branches in use (apart from the root, which never shares).
      *
      * @return the new branch.
      */
@@ -382,7 +387,7 @@ public:
     ///< Check if this branch contains an updated version of the m_item from the root branch.
     bool Overrides( ITEM* aItem ) const
     {
-        return m_override.find( aItem ) != m_override.end();
+        return m_override->find( aItem ) != m_override->end();
     }
 
 private:
@@ -393,6 +398,7 @@ private:
     NODE& operator=( const NODE& aB );
 
     ///< Try to find matching joint and creates a new one if not found.
+    ///< The caller must have called copyBranchDataOnWrite() first.
     JOINT& touchJoint( const VECTOR2I& aPos, const LAYER_RANGE& aLayers, int aNet );
 
     ///< Touch a joint and links it to an m_item.
@@ -414,6 +420,18 @@ private:
 
     void doRemove( ITEM* aItem );
     void unlinkParent();
+
+    ///< Give this node private copies of any branch data still shared with its parent or
+    ///< children.  Must be called before modifying m_joints, m_override or m_index.
+    ///< Each shared container is copied as a whole: the copies hold all the changes made
+    ///< since the root, not just those of this level.
+    ///< @return false (and copies nothing) if the data is shared with live children, in which
+    ///< case the node must not be modified.
+    bool copyBranchDataOnWrite();
+
+    ///< Hand an item that could not be added over to the root's garbage
+    void discardItem( ITEM* aItem );
+
     void releaseChildren();
     void releaseGarbage();
     void rebuildJoint( JOINT* aJoint, ITEM* aItem );
@@ -440,19 +458,21 @@ private:
     typedef std::unordered_multimap<JOINT::HASH_TAG, JOINT, JOINT::JOINT_TAG_HASH> JOINT_MAP;
     typedef JOINT_MAP::value_type TagJointPair;
 
-    JOINT_MAP       m_joints;           ///< hash table with the joints, linking the items. Joints
-                                        ///< are hashed by their position, layer set and net.
+    std::shared_ptr<JOINT_MAP> m_joints;    ///< hash table with the joints, linking the items.
+                                            ///< Joints are hashed by their position, layer set
+                                            ///< and net. Shared with the parent branch until
+                                            ///< either is modified, then copied as a whole.
 
     NODE*           m_parent;           ///< node this node was branched from
     NODE*           m_root;             ///< root node of the whole hierarchy
     std::set<NODE*> m_children;         ///< list of nodes branched from this one
 
-    std::unordered_set<ITEM*> m_override;   ///< hash of root's items that have been changed
-                                            ///< in this node
+    std::shared_ptr<std::unordered_set<ITEM*>> m_override;   ///< hash of root's items that
+                                                             ///< have been changed in this node
 
     int             m_maxClearance;     ///< worst case item-item clearance
     RULE_RESOLVER*  m_ruleResolver;     ///< Design rules resolver
-    INDEX*          m_index;            ///< Geometric/Net index of the items
+    std::shared_ptr<INDEX> m_index;     ///< Geometric/Net index of the items
     int             m_depth;            ///< depth of the node (number of parent nodes in the
                                         ///< inheritance chain)
 
@@ -157,6 +157,9 @@ bool ROUTER::StartDragging( const VECTOR2I& aP, ITEM_SET aStartItems, int aDragM
     m_dragger->SetLogger( m_logger );
     m_dragger->SetDebugDecorator( m_iface->GetDebugDecorator() );
 
+    if( m_logger )
+        m_logger->LogStartDrag( aP, aStartItems, aDragMode, m_mode, Settings() );
+
     if( m_dragger->Start( aP, aStartItems ) )
     {
         m_state = DRAG_SEGMENT;
@@ -365,7 +368,7 @@ bool ROUTER::StartRouting( const VECTOR2I& aP, ITEM* aStartItem, int aLayer )
     m_placer->SetLogger( m_logger );
 
     if( m_logger )
-        m_logger->Log( LOGGER::EVT_START_ROUTE, aP, aStartItem );
+        m_logger->LogStartRoute( aP, aStartItem, aLayer, m_mode, Settings() );
 
     bool rv = m_placer->Start( aP, aStartItem );
 
@@ -568,6 +571,10 @@ void ROUTER::CommitRouting( NODE* aNode )
     for( ITEM* item : added )
         m_iface->AddItem( item );
 
+    // AddItem() gave the items their new parents
+    if( m_logger )
+        m_logger->LogCommit( added );
+
     m_iface->Commit();
     m_world->Commit( aNode );
 }
@@ -111,6 +111,8 @@ public:
         return m_followMouse && !( Mode() == RM_MarkObstacles );
     }
 
+    void SetFollowMouse( bool aFollowMouse ) { m_followMouse = aFollowMouse; }
+
     ///< Return true if smoothing segments during dragging is enabled.
     bool SmoothDraggedSegments() const { return m_smoothDraggedSegments; }
 
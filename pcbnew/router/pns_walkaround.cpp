@@ -19,7 +19,10 @@
  * with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <future>
+
 #include <core/optional.h>
+#include <scoped_set_reset.h>
 
 #include <geometry/shape_line_chain.h>
 
@@ -33,7 +36,6 @@ namespace PNS {
 
 void WALKAROUND::start( const LINE& aInitialPath )
 {
-    m_iteration = 0;
     m_iterationLimit = 50;
 }
 
@@ -52,49 +54,49 @@ NODE::OPT_OBSTACLE WALKAROUND::nearestObstacle( const LINE& aPath )
 }
 
 
-WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
-                                                              bool aWindingDirection )
+WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( SEARCH& aSearch )
 {
-    OPT<OBSTACLE>& current_obs =
-        aWindingDirection ? m_currentObstacle[0] : m_currentObstacle[1];
+    LINE&          path = aSearch.path;
+    bool           cw = aSearch.cw;
+    OPT<OBSTACLE>& current_obs = aSearch.currentObstacle;
 
     if( !current_obs )
         return DONE;
 
     SHAPE_LINE_CHAIN path_pre[2], path_walk[2], path_post[2];
 
-    if( aPath.PointCount() > 1 )
+    if( path.PointCount() > 1 )
     {
-        VECTOR2I last = aPath.CPoint( -1 );
+        VECTOR2I last = path.CPoint( -1 );
 
         if( ( current_obs->m_hull ).PointInside( last ) || ( current_obs->m_hull ).PointOnEdge( last ) )
         {
-            m_recursiveBlockageCount++;
+            aSearch.recursiveBlockageCount++;
 
-            if( m_recursiveBlockageCount < 3 )
-                aPath.Line().Append( current_obs->m_hull.NearestPoint( last ) );
+            if( aSearch.recursiveBlockageCount < 3 )
+                path.Line().Append( current_obs->m_hull.NearestPoint( last ) );
             else
             {
-                aPath = aPath.ClipToNearestObstacle( m_world );
+                path = path.ClipToNearestObstacle( m_world );
                 return DONE;
             }
         }
     }
 
-    aPath.Walkaround( current_obs->m_hull, path_pre[0], path_walk[0],
-                      path_post[0], aWindingDirection );
-    aPath.Walkaround( current_obs->m_hull, path_pre[1], path_walk[1],
-                      path_post[1], !aWindingDirection );
+    path.Walkaround( current_obs->m_hull, path_pre[0], path_walk[0],
+                     path_post[0], cw );
+    path.Walkaround( current_obs->m_hull, path_pre[1], path_walk[1],
+                     path_post[1], !cw );
 
-    if( !aPath.Walkaround( current_obs->m_hull, path_pre[1], path_walk[1],
-                      path_post[1], !aWindingDirection ) )
+    if( !path.Walkaround( current_obs->m_hull, path_pre[1], path_walk[1],
+                     path_post[1], !cw ) )
         return STUCK;
-    auto l =aPath.CLine();
+    auto l =path.CLine();
 
 #if 0
     if( m_logger )
     {
-        m_logger->NewGroup( aWindingDirection ? "walk-cw" : "walk-ccw", m_iteration );
+        m_logger->NewGroup( cw ? "walk-cw" : "walk-ccw", aSearch.iteration );
         m_logger->Log( &path_walk[0], 0, "path_walk" );
         m_logger->Log( &path_pre[0], 1, "path_pre" );
         m_logger->Log( &path_post[0], 4, "path_post" );
@@ -106,16 +108,18 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
     if ( Dbg() )
     {
         char name[128];
-        snprintf(name, sizeof(name), "hull-%s-%d", aWindingDirection ? "cw" : "ccw", m_iteration );
+        snprintf(name, sizeof(name), "hull-%s-%d", cw ? "cw" : "ccw",
+                 aSearch.iteration );
         Dbg()->AddLine( current_obs->m_hull, 0, 1, name);
-        snprintf(name, sizeof(name), "path-%s-%d", aWindingDirection ? "cw" : "ccw", m_iteration );
-        Dbg()->AddLine( aPath.CLine(), 1, 1, name );
+        snprintf(name, sizeof(name), "path-%s-%d", cw ? "cw" : "ccw",
+                 aSearch.iteration );
+        Dbg()->AddLine( path.CLine(), 1, 1, name );
     }
 
     int len_pre = path_walk[0].Length();
     int len_alt = path_walk[1].Length();
 
-    LINE walk_path( aPath, path_walk[1] );
+    LINE walk_path( path, path_walk[1] );
 
     bool alt_collides = static_cast<bool>( m_world->CheckColliding( &walk_path, m_itemMask ) );
 
@@ -128,9 +132,9 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
         pnew.Append( path_post[1] );
 
         if( !path_post[1].PointCount() || !path_walk[1].PointCount() )
-            current_obs = nearestObstacle( LINE( aPath, path_pre[1] ) );
+            current_obs = nearestObstacle( LINE( path, path_pre[1] ) );
         else
-            current_obs = nearestObstacle( LINE( aPath, path_post[1] ) );
+            current_obs = nearestObstacle( LINE( path, path_post[1] ) );
     }
     else*/
     {
@@ -139,18 +143,18 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::singleStep( LINE& aPath,
         pnew.Append( path_post[0] );
 
         if( path_post[0].PointCount() == 0 || path_walk[0].PointCount() == 0 )
-            current_obs = nearestObstacle( LINE( aPath, path_pre[0] ) );
+            current_obs = nearestObstacle( LINE( path, path_pre[0] ) );
         else
-            current_obs = nearestObstacle( LINE( aPath, path_walk[0] ) );
+            current_obs = nearestObstacle( LINE( path, path_walk[0] ) );
 
         if( !current_obs )
         {
-            current_obs = nearestObstacle( LINE( aPath, path_post[0] ) );
+            current_obs = nearestObstacle( LINE( path, path_post[0] ) );
         }
     }
 
     pnew.Simplify();
-    aPath.SetShape( pnew );
+    path.SetShape( pnew );
 
     return IN_PROGRESS;
 }
@@ -184,86 +188,105 @@ bool clipToLoopStart( SHAPE_LINE_CHAIN& l )
 
 
 
-const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
+void WALKAROUND::search( SEARCH& aSearch, bool aClipLoops, std::atomic<int>* aDoneAt )
 {
-    LINE path_cw( aInitialPath ), path_ccw( aInitialPath );
-    WALKAROUND_STATUS s_cw = IN_PROGRESS, s_ccw = IN_PROGRESS;
-    SHAPE_LINE_CHAIN best_path;
-    RESULT result;
+    // The searches share the world items, so they must not mark them
+    SCOPED_SET_RESET<bool> noHoleMarking( ITEM::HoleMarking(), false );
 
-    // special case for via-in-the-middle-of-track placement
-    if( aInitialPath.PointCount() <= 1 )
+    for( ; aSearch.iteration < m_iterationLimit; aSearch.iteration++ )
     {
-        if( aInitialPath.EndsWithVia() && m_world->CheckColliding( &aInitialPath.Via(), m_itemMask ) )
-            return RESULT( STUCK, STUCK );
+        // The other winding got there first, so this one can't be picked anymore
+        if( aDoneAt && aSearch.iteration > aDoneAt->load() )
+            return;
 
-        return RESULT( DONE, DONE, aInitialPath, aInitialPath );
-    }
+        aSearch.status = singleStep( aSearch );
 
-    start( aInitialPath );
+        if( aClipLoops && clipToLoopStart( aSearch.path.Line() ) )
+            aSearch.status = ALMOST_DONE;
 
-    m_currentObstacle[0] = m_currentObstacle[1] = nearestObstacle( aInitialPath );
-    m_recursiveBlockageCount = 0;
+        if( aSearch.status == IN_PROGRESS )
+            continue;
 
-    result.lineCw = aInitialPath;
-    result.lineCcw = aInitialPath;
+        if( aDoneAt && aSearch.status == DONE )
+        {
+            int doneAt = aDoneAt->load();
 
-    if( m_forceWinding )
-    {
-        s_cw = m_forceCw ? IN_PROGRESS : STUCK;
-        s_ccw = m_forceCw ? STUCK : IN_PROGRESS;
-        m_forceSingleDirection = true;
-    } else {
-        m_forceSingleDirection = false;
+            while( aSearch.iteration < doneAt
+                    && !aDoneAt->compare_exchange_weak( doneAt, aSearch.iteration ) )
+            {
+            }
+        }
+
+        return;
     }
+}
 
-    while( m_iteration < m_iterationLimit )
-    {
-        if( s_cw != STUCK )
-            s_cw = singleStep( path_cw, true );
 
-        if( s_ccw != STUCK )
-            s_ccw = singleStep( path_ccw, false );
+void WALKAROUND::searchBoth( SEARCH& aCw, SEARCH& aCcw, bool aClipLoops, bool aFirstWins )
+{
+    std::atomic<int> doneAt( m_iterationLimit );
+    std::atomic<int>* firstDone = aFirstWins ? &doneAt : nullptr;
 
-        auto old = path_cw.CLine();
+    if( aCw.status == STUCK || aCcw.status == STUCK || !aCw.currentObstacle )
+    {
+        if( aCw.status != STUCK )
+            search( aCw, aClipLoops, firstDone );
 
-        if( clipToLoopStart( path_cw.Line() ) )
-            s_cw = ALMOST_DONE;
+        if( aCcw.status != STUCK )
+            search( aCcw, aClipLoops, firstDone );
 
-        if( clipToLoopStart( path_ccw.Line() ) )
-            s_ccw = ALMOST_DONE;
+        return;
+    }
 
+    auto ccwSearch =
+            [&]()
+            {
+                search( aCcw, aClipLoops, firstDone );
+            };
 
-        if( s_cw != IN_PROGRESS )
-        {
-            result.lineCw = path_cw;
-            result.statusCw = s_cw;
-        }
+    // The windings don't depend on each other, so walk them concurrently
+    std::future<void> ccw = std::async( std::launch::async, ccwSearch );
 
-        if( s_ccw != IN_PROGRESS )
-        {
-            result.lineCcw = path_ccw;
-            result.statusCcw = s_ccw;
-        }
+    search( aCw, aClipLoops, firstDone );
+    ccw.get();
+}
 
-        if( s_cw != IN_PROGRESS && s_ccw != IN_PROGRESS )
-            break;
 
-        m_iteration++;
-    }
+const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
+{
+    RESULT result;
 
-    if( s_cw == IN_PROGRESS )
+    // special case for via-in-the-middle-of-track placement
+    if( aInitialPath.PointCount() <= 1 )
     {
-        result.lineCw = path_cw;
-        result.statusCw = ALMOST_DONE;
+        if( aInitialPath.EndsWithVia() && m_world->CheckColliding( &aInitialPath.Via(), m_itemMask ) )
+            return RESULT( STUCK, STUCK );
+
+        return RESULT( DONE, DONE, aInitialPath, aInitialPath );
     }
 
-    if( s_ccw == IN_PROGRESS )
+    start( aInitialPath );
+
+    SEARCH cw( aInitialPath, true, IN_PROGRESS ), ccw( aInitialPath, false, IN_PROGRESS );
+
+    cw.currentObstacle = ccw.currentObstacle = nearestObstacle( aInitialPath );
+
+    if( m_forceWinding )
     {
-        result.lineCcw = path_ccw;
-        result.statusCcw = ALMOST_DONE;
+        cw.status = m_forceCw ? IN_PROGRESS : STUCK;
+        ccw.status = m_forceCw ? STUCK : IN_PROGRESS;
+        m_forceSingleDirection = true;
+    } else {
+        m_forceSingleDirection = false;
     }
 
+    searchBoth( cw, ccw, true, false );
+
+    result.lineCw = cw.path;
+    result.statusCw = cw.status == IN_PROGRESS ? ALMOST_DONE : cw.status;
+    result.lineCcw = ccw.path;
+    result.statusCcw = ccw.status == IN_PROGRESS ? ALMOST_DONE : ccw.status;
+
     result.lineCw.Line().Simplify();
     result.lineCcw.Line().Simplify();
 
@@ -295,9 +318,7 @@ const WALKAROUND::RESULT WALKAROUND::Route( const LINE& aInitialPath )
 WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
         LINE& aWalkPath, bool aOptimize )
 {
-    LINE path_cw( aInitialPath ), path_ccw( aInitialPath );
     WALKAROUND_STATUS s_cw = IN_PROGRESS, s_ccw = IN_PROGRESS;
-    SHAPE_LINE_CHAIN best_path;
 
     // special case for via-in-the-middle-of-track placement
     if( aInitialPath.PointCount() <= 1 )
@@ -311,27 +332,32 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
 
     start( aInitialPath );
 
-    m_currentObstacle[0] = m_currentObstacle[1] = nearestObstacle( aInitialPath );
-    m_recursiveBlockageCount = 0;
+    SEARCH cw( aInitialPath, true, IN_PROGRESS ), ccw( aInitialPath, false, IN_PROGRESS );
+
+    cw.currentObstacle = ccw.currentObstacle = nearestObstacle( aInitialPath );
 
     aWalkPath = aInitialPath;
 
     if( m_forceWinding )
     {
-        s_cw = m_forceCw ? IN_PROGRESS : STUCK;
-        s_ccw = m_forceCw ? STUCK : IN_PROGRESS;
+        cw.status = m_forceCw ? IN_PROGRESS : STUCK;
+        ccw.status = m_forceCw ? STUCK : IN_PROGRESS;
         m_forceSingleDirection = true;
     } else {
         m_forceSingleDirection = false;
     }
 
-    while( m_iteration < m_iterationLimit )
-    {
-        if( s_cw != STUCK )
-            s_cw = singleStep( path_cw, true );
+    searchBoth( cw, ccw, false, !m_forceLongerPath );
 
-        if( s_ccw != STUCK )
-            s_ccw = singleStep( path_ccw, false );
+    const LINE& path_cw = cw.path;
+    const LINE& path_ccw = ccw.path;
+    int         iteration;
+
+    // Pick the path the windings would have settled on stepping in lockstep
+    for( iteration = 0; iteration < m_iterationLimit; iteration++ )
+    {
+        s_cw = iteration < cw.iteration ? IN_PROGRESS : cw.status;
+        s_ccw = iteration < ccw.iteration ? IN_PROGRESS : ccw.status;
 
         if( ( s_cw == DONE && s_ccw == DONE ) || ( s_cw == STUCK && s_ccw == STUCK ) )
         {
@@ -355,11 +381,9 @@ WALKAROUND::WALKAROUND_STATUS WALKAROUND::Route( const LINE& aInitialPath,
             aWalkPath = path_ccw;
             break;
         }
-
-        m_iteration++;
     }
 
-    if( m_iteration == m_iterationLimit )
+    if( iteration == m_iterationLimit )
     {
         int len_cw  = path_cw.CLine().Length();
         int len_ccw = path_ccw.CLine().Length();
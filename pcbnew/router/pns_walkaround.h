@@ -22,6 +22,7 @@
 #ifndef __PNS_WALKAROUND_H
 #define __PNS_WALKAROUND_H
 
+#include <atomic>
 #include <set>
 
 #include "pns_line.h"
@@ -49,9 +50,6 @@ public:
         m_itemMask = ITEM::ANY_T;
 
         // Initialize other members, to avoid uninitialized variables.
-        m_recursiveBlockageCount = 0;
-        m_recursiveCollision[0] = m_recursiveCollision[1] = false;
-        m_iteration = 0;
         m_forceCw = false;
         m_forceUniqueWindingDirection = false;
     }
@@ -140,15 +138,54 @@ public:
     const RESULT Route( const LINE& aInitialPath );
 
 private:
+    /**
+     * The search around the obstacles in one winding direction.  It holds all the state the
+     * search changes, so that the two directions can be searched concurrently.
+     */
+    struct SEARCH
+    {
+        SEARCH( const LINE& aPath, bool aCw, WALKAROUND_STATUS aStatus ) :
+                path( aPath ),
+                cw( aCw ),
+                status( aStatus ),
+                recursiveBlockageCount( 0 ),
+                iteration( 0 )
+        {
+        }
+
+        LINE               path;
+        bool               cw;
+        WALKAROUND_STATUS  status;
+        NODE::OPT_OBSTACLE currentObstacle;
+        int                recursiveBlockageCount;
+        int                iteration;   ///< Iteration the search ended at, or the limit
+    };
+
     void start( const LINE& aInitialPath );
 
-    WALKAROUND_STATUS singleStep( LINE& aPath, bool aWindingDirection );
+    /**
+     * Search both windings, the counter-clockwise one on a worker thread when both have an
+     * obstacle to walk around.
+     *
+     * @param aClipLoops cuts each path at its first self-intersection, ending its search.
+     * @param aFirstWins stops a search once the other one reaches DONE at an earlier
+     *                   iteration, as its result would not be picked anymore.
+     */
+    void searchBoth( SEARCH& aCw, SEARCH& aCcw, bool aClipLoops, bool aFirstWins );
+
+    /**
+     * Step \a aSearch until it reaches a status other than IN_PROGRESS or the iteration limit.
+     *
+     * @param aDoneAt is the earliest iteration at which a search reached DONE, shared by the
+     *                searches when the first one to get there wins.
+     */
+    void search( SEARCH& aSearch, bool aClipLoops, std::atomic<int>* aDoneAt );
+
+    WALKAROUND_STATUS singleStep( SEARCH& aSearch );
     NODE::OPT_OBSTACLE nearestObstacle( const LINE& aPath );
 
     NODE* m_world;
 
-    int m_recursiveBlockageCount;
-    int m_iteration;
     int m_iterationLimit;
     int m_itemMask;
     bool m_forceSingleDirection, m_forceLongerPath;
@@ -157,8 +194,6 @@ private:
     bool m_forceCw;
     bool m_forceUniqueWindingDirection;
     VECTOR2I m_cursorPos;
-    NODE::OPT_OBSTACLE m_currentObstacle[2];
-    bool m_recursiveCollision[2];
     std::set<ITEM*> m_restrictedSet;
 };
 
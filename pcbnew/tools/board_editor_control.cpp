@@ -1152,13 +1152,12 @@ int BOARD_EDITOR_CONTROL::PlaceTarget( const TOOL_EVENT& aEvent )
 static bool mergeZones( BOARD_COMMIT& aCommit, std::vector<ZONE*>& aOriginZones,
                         std::vector<ZONE*>& aMergedZones )
 {
-    for( unsigned int i = 1; i < aOriginZones.size(); i++ )
-    {
-        aOriginZones[0]->Outline()->BooleanAdd( *aOriginZones[i]->Outline(),
-                                                SHAPE_POLY_SET::PM_FAST );
-    }
+    SHAPE_POLY_SET::UNION_BATCH merged;
+
+    for( ZONE* zone : aOriginZones )
+        merged.Add( *zone->Outline() );
 
-    aOriginZones[0]->Outline()->Simplify( SHAPE_POLY_SET::PM_FAST );
+    merged.Execute( *aOriginZones[0]->Outline(), SHAPE_POLY_SET::PM_FAST );
 
     // We should have one polygon with hole
     // We can have 2 polygons with hole, if the 2 initial polygons have only one common corner
@@ -268,6 +268,8 @@ void TRACKS_CLEANER::cleanup( bool aDeleteDuplicateVias, bool aDeleteNullSegment
         rtree.Insert( track );
     }
 
+    rtree.Build();
+
     std::set<BOARD_ITEM*> toRemove;
 
     for( TRACK* track : m_brd->Tracks() )
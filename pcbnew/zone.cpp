@@ -174,6 +174,8 @@ void ZONE::InitDataFromSrcInCopyCtor( const ZONE& aZone )
 
     m_hv45                    = aZone.m_hv45;
     m_area                    = aZone.m_area;
+
+    clearFillLOD();
 }
 
 
@@ -201,6 +203,7 @@ bool ZONE::UnFill()
 
     m_isFilled = false;
     m_fillFlags.clear();
+    clearFillLOD();
 
     return change;
 }
@@ -262,6 +265,7 @@ void ZONE::SetLayerSet( LSET aLayerSet )
         m_RawPolysList.clear();
         m_filledPolysHash.clear();
         m_insulatedIslands.clear();
+        clearFillLOD();
 
         for( PCB_LAYER_ID layer : aLayerSet.Seq() )
         {
@@ -674,6 +678,8 @@ void ZONE::Move( const wxPoint& offset )
     for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
         pair.second.Move( offset );
 
+    clearFillLOD();
+
     for( std::pair<const PCB_LAYER_ID, ZONE_SEGMENT_FILL>& pair : m_FillSegmList )
     {
         for( SEG& seg : pair.second )
@@ -711,6 +717,8 @@ void ZONE::Rotate( const wxPoint& aCentre, double aAngle )
     for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
         pair.second.Rotate( aAngle, VECTOR2I( aCentre ) );
 
+    clearFillLOD();
+
     for( std::pair<const PCB_LAYER_ID, ZONE_SEGMENT_FILL>& pair : m_FillSegmList )
     {
         for( SEG& seg : pair.second )
@@ -748,6 +756,8 @@ void ZONE::Mirror( const wxPoint& aMirrorRef, bool aMirrorLeftRight )
     for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
         pair.second.Mirror( aMirrorLeftRight, !aMirrorLeftRight, VECTOR2I( aMirrorRef ) );
 
+    clearFillLOD();
+
     for( std::pair<const PCB_LAYER_ID, ZONE_SEGMENT_FILL>& pair : m_FillSegmList )
     {
         for( SEG& seg : pair.second )
@@ -1101,17 +1111,55 @@ void ZONE::SwapData( BOARD_ITEM* aImage )
 }
 
 
-void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer )
+int ZONE::FillLODTolerance( int aMaxError )
+{
+    // Round the resolution down to a power of two so that zooming in and out reuses a
+    // handful of cached levels instead of decimating again at every zoom step.
+    int tolerance = 1;
+
+    while( tolerance <= aMaxError / 2 )
+        tolerance *= 2;
+
+    return tolerance;
+}
+
+
+const SHAPE_POLY_SET& ZONE::GetFilledPolysLOD( PCB_LAYER_ID aLayer, int aMaxError ) const
+{
+    int tolerance = FillLODTolerance( aMaxError );
+
+    std::lock_guard<std::mutex> lock( m_fillLODLock );
+
+    auto it = m_fillLOD.find( { aLayer, tolerance } );
+
+    if( it == m_fillLOD.end() )
+    {
+        const SHAPE_POLY_SET& fill = GetFilledPolysList( aLayer );
+        SHAPE_POLY_SET        lod = fill.Decimated( tolerance );
+
+        // OpenGL draws the triangulation when there is one
+        if( fill.IsTriangulationUpToDate() )
+            lod.CacheTriangulation();
+
+        it = m_fillLOD.emplace( std::make_pair( aLayer, tolerance ), std::move( lod ) ).first;
+    }
+
+    // References to std::map elements stay valid until the cache is cleared
+    return it->second;
+}
+
+
+void ZONE::CacheTriangulation( PCB_LAYER_ID aLayer, size_t aMaxThreads )
 {
     if( aLayer == UNDEFINED_LAYER )
     {
         for( std::pair<const PCB_LAYER_ID, SHAPE_POLY_SET>& pair : m_FilledPolysList )
-            pair.second.CacheTriangulation();
+            pair.second.CacheTriangulation( true, aMaxThreads );
     }
     else
     {
         if( m_FilledPolysList.count( aLayer ) )
-            m_FilledPolysList[ aLayer ].CacheTriangulation();
+            m_FilledPolysList[ aLayer ].CacheTriangulation( true, aMaxThreads );
     }
 }
 
@@ -1233,8 +1281,18 @@ bool ZONE::BuildSmoothedPoly( SHAPE_POLY_SET& aSmoothedPoly, PCB_LAYER_ID aLayer
         maxExtents = &withFillets;
     }
 
-    for( ZONE* zone : interactingZones )
-        aSmoothedPoly.BooleanAdd( *zone->Outline(), SHAPE_POLY_SET::PM_FAST );
+    if( !interactingZones.empty() )
+    {
+        SHAPE_POLY_SET::UNION_BATCH merged;
+
+        merged.Add( aSmoothedPoly );
+
+        for( ZONE* zone : interactingZones )
+            merged.Add( *zone->Outline() );
+
+        // Also called from the zone filler's per-zone threads
+        merged.Execute( aSmoothedPoly, SHAPE_POLY_SET::PM_FAST, 1 );
+    }
 
     if( aBoardOutline )
     {
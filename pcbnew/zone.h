@@ -640,6 +640,8 @@ public:
             m_insulatedIslands[pair.first].clear();
             pair.second.RemoveAllContours();
         }
+
+        clearFillLOD();
     }
 
     bool HasFilledPolysForLayer( PCB_LAYER_ID aLayer ) const
@@ -658,10 +660,28 @@ public:
         return m_FilledPolysList.at( aLayer );
     }
 
+    /**
+     * Return the filled polygons of a layer decimated for display at a resolution of
+     * \a aMaxError (typically the size of a pixel), see SHAPE_POLY_SET::Decimated().
+     *
+     * The decimated polygons are built on first use, triangulated if the full fill is, and
+     * cached per FillLODTolerance() of \a aMaxError until the fill changes.  Safe to call from
+     * several threads.
+     */
+    const SHAPE_POLY_SET& GetFilledPolysLOD( PCB_LAYER_ID aLayer, int aMaxError ) const;
+
+    /**
+     * @return the tolerance GetFilledPolysLOD() decimates to for \a aMaxError: the largest
+     *         power of two not above it.
+     */
+    static int FillLODTolerance( int aMaxError );
+
     /** (re)create a list of triangles that "fill" the solid areas.
      * used for instance to draw these solid areas on opengl
+     * @param aMaxThreads is passed to SHAPE_POLY_SET::CacheTriangulation(); callers that are
+     *                    one of several workers should pass their share of the cores.
      */
-    void CacheTriangulation( PCB_LAYER_ID aLayer = UNDEFINED_LAYER );
+    void CacheTriangulation( PCB_LAYER_ID aLayer = UNDEFINED_LAYER, size_t aMaxThreads = 0 );
 
    /**
      * Function SetFilledPolysList
@@ -670,6 +690,7 @@ public:
     void SetFilledPolysList( PCB_LAYER_ID aLayer, const SHAPE_POLY_SET& aPolysList )
     {
         m_FilledPolysList[aLayer] = aPolysList;
+        clearFillLOD();
     }
 
     /**
@@ -843,6 +864,13 @@ public:
     virtual void SwapData( BOARD_ITEM* aImage ) override;
 
 protected:
+    /// Drop the decimated fills built by GetFilledPolysLOD(); called whenever the fill changes
+    void clearFillLOD() const
+    {
+        std::lock_guard<std::mutex> lock( m_fillLODLock );
+        m_fillLOD.clear();
+    }
+
     SHAPE_POLY_SET*       m_Poly;                ///< Outline of the zone.
     int                   m_cornerSmoothingType;
     unsigned int          m_cornerRadius;
@@ -956,6 +984,10 @@ protected:
 
     /// Lock used for multi-threaded filling on multi-layer zones
     std::mutex m_lock;
+
+    /// Decimated copies of m_FilledPolysList for low zoom display, per layer and resolution
+    mutable std::map<std::pair<PCB_LAYER_ID, int>, SHAPE_POLY_SET> m_fillLOD;
+    mutable std::mutex                                              m_fillLODLock;
 };
 
 
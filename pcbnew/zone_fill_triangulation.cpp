@@ -0,0 +1,158 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <zone_fill_triangulation.h>
+
+#include <board.h>
+#include <zone.h>
+
+#include <algorithm>
+#include <set>
+#include <thread>
+
+
+ZONE_FILL_TRIANGULATION::ZONE_FILL_TRIANGULATION( BOARD* aBoard ) :
+        m_board( aBoard ),
+        m_applied( 0 ),
+        m_next( 0 ),
+        m_cancelled( false )
+{
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            const SHAPE_POLY_SET& fill = zone->GetFilledPolysList( layer );
+
+            if( fill.OutlineCount() == 0 || fill.IsTriangulationUpToDate() )
+                continue;
+
+            m_tasks.push_back( { zone, layer, fill } );
+            m_remaining[zone]++;
+        }
+    }
+}
+
+
+ZONE_FILL_TRIANGULATION::~ZONE_FILL_TRIANGULATION()
+{
+    Cancel();
+}
+
+
+void ZONE_FILL_TRIANGULATION::Start( const std::function<void()>& aOnFinished )
+{
+    size_t cores = std::max<size_t>( std::thread::hardware_concurrency(), 2 );
+    size_t parallelThreadCount = std::min<size_t>( cores, m_tasks.size() );
+
+    for( size_t ii = 0; ii < parallelThreadCount; ++ii )
+    {
+        m_workers.push_back( std::async( std::launch::async,
+                [this, aOnFinished, cores, parallelThreadCount]()
+                {
+                    for( size_t i = m_next.fetch_add( 1 );
+                         i < m_tasks.size() && !m_cancelled;
+                         i = m_next.fetch_add( 1 ) )
+                    {
+                        // Share the cores among the fills still in progress, so that a lone large
+                        // fill is triangulated by all of them
+                        size_t active = std::min( parallelThreadCount, m_tasks.size() - i );
+
+                        m_tasks[i].m_fill.CacheTriangulation( true,
+                                                              std::max<size_t>( 1, cores / active ) );
+
+                        bool first;
+
+                        {
+                            std::lock_guard<std::mutex> lock( m_doneLock );
+                            first = m_done.empty();
+                            m_done.push_back( i );
+                        }
+
+                        // A single notification covers everything finished until it is handled
+                        if( first )
+                            aOnFinished();
+                    }
+                } ) );
+    }
+}
+
+
+void ZONE_FILL_TRIANGULATION::Cancel()
+{
+    m_cancelled = true;
+
+    for( std::future<void>& worker : m_workers )
+        worker.wait();
+
+    m_workers.clear();
+    m_remaining.clear();
+}
+
+
+std::vector<ZONE*> ZONE_FILL_TRIANGULATION::ApplyFinished()
+{
+    std::vector<size_t> done;
+    std::vector<ZONE*>  completed;
+
+    {
+        std::lock_guard<std::mutex> lock( m_doneLock );
+        done.swap( m_done );
+    }
+
+    // Zones may have been deleted while being triangulated; the undo list keeps them alive
+    // but they must not be changed
+    const ZONES&    boardZones = m_board->Zones();
+    std::set<ZONE*> zones( boardZones.begin(), boardZones.end() );
+
+    for( size_t idx : done )
+    {
+        TASK& task = m_tasks[idx];
+        ZONE* zone = task.m_zone;
+
+        // Keep the triangulation only if the fill is still the one that was triangulated
+        if( zones.count( zone ) && zone->HasFilledPolysForLayer( task.m_layer )
+                && zone->GetFilledPolysList( task.m_layer ).GetHash() == task.m_fill.GetHash() )
+        {
+            zone->SetFilledPolysList( task.m_layer, task.m_fill );
+        }
+
+        task.m_fill = SHAPE_POLY_SET();
+
+        auto it = m_remaining.find( zone );
+
+        if( it != m_remaining.end() && --it->second == 0 )
+        {
+            m_remaining.erase( it );
+
+            if( zones.count( zone ) )
+                completed.push_back( zone );
+        }
+    }
+
+    m_applied += done.size();
+
+    return completed;
+}
@@ -0,0 +1,117 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#ifndef ZONE_FILL_TRIANGULATION_H
+#define ZONE_FILL_TRIANGULATION_H
+
+#include <geometry/shape_poly_set.h>
+#include <layers_id_colors_and_visibility.h>
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <map>
+#include <mutex>
+#include <vector>
+
+class BOARD;
+class ZONE;
+
+/**
+ * Triangulates the zone fills of a board on worker threads, so that the board can be shown
+ * (with the zones drawn as outlines) before OpenGL can draw the fills.
+ *
+ * The workers triangulate copies of the fills, so the board can be edited in the meantime.
+ * ApplyFinished() moves the results back into the zones on the GUI thread, provided that the
+ * fills did not change since.
+ *
+ * Which zones are still waiting for their fills is kept here rather than in the zones, so a
+ * zone deleted meanwhile (and possibly restored by undo later) is never left marked.
+ */
+class ZONE_FILL_TRIANGULATION
+{
+public:
+    /**
+     * Collect the fills of \a aBoard that are not triangulated yet.  Nothing is started until
+     * Start() is called.
+     */
+    ZONE_FILL_TRIANGULATION( BOARD* aBoard );
+
+    ///< Cancels the triangulation and waits for the workers
+    ~ZONE_FILL_TRIANGULATION();
+
+    BOARD* GetBoard() const { return m_board; }
+
+    ///< Return true if no fill needs to be triangulated
+    bool Empty() const { return m_tasks.empty(); }
+
+    /**
+     * Start the workers.
+     *
+     * @param aOnFinished is called from a worker thread when results become available for
+     *                    ApplyFinished() and none were waiting to be applied already.
+     */
+    void Start( const std::function<void()>& aOnFinished );
+
+    /**
+     * Stop the workers and wait for the fills they are triangulating.  Results not applied
+     * yet are dropped and no zone is pending afterwards.
+     */
+    void Cancel();
+
+    /**
+     * Move the fills triangulated so far back into their zones.  Must be called on the thread
+     * that edits the board.  Zones no longer on the board are not touched.
+     *
+     * @return the zones on the board whose fills are all triangulated now.
+     */
+    std::vector<ZONE*> ApplyFinished();
+
+    ///< Return true once every fill was applied
+    bool IsFinished() const { return m_applied == m_tasks.size(); }
+
+    ///< Return true if some fills of \a aZone are still being triangulated
+    bool IsPending( const ZONE* aZone ) const { return m_remaining.count( aZone ) > 0; }
+
+private:
+    struct TASK
+    {
+        ZONE*          m_zone;
+        PCB_LAYER_ID   m_layer;
+        SHAPE_POLY_SET m_fill;
+    };
+
+    BOARD*                         m_board;
+    std::vector<TASK>              m_tasks;
+    std::map<const ZONE*, int>     m_remaining;     ///< tasks not applied yet, per zone
+    size_t                         m_applied;
+
+    std::atomic<size_t>            m_next;
+    std::atomic<bool>              m_cancelled;
+    std::vector<std::future<void>> m_workers;
+
+    std::mutex                     m_doneLock;
+    std::vector<size_t>            m_done;          ///< tasks finished but not applied yet
+};
+
+#endif // ZONE_FILL_TRIANGULATION_H
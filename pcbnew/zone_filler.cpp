@@ -437,6 +437,8 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 
     nextItem = 0;
 
+    size_t parallelThreadCount = std::min( cores, islandsList.size() );
+
     auto tri_lambda =
             [&]( PROGRESS_REPORTER* aReporter ) -> size_t
             {
@@ -444,7 +446,12 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
 
                 for( size_t i = nextItem++; i < islandsList.size(); i = nextItem++ )
                 {
-                    islandsList[i].m_zone->CacheTriangulation();
+                    // Share the cores among the zones still in progress, so the last (or only)
+                    // large zones are not left triangulating on a single thread
+                    size_t active = std::min( parallelThreadCount, islandsList.size() - i );
+
+                    islandsList[i].m_zone->CacheTriangulation( UNDEFINED_LAYER,
+                                                               std::max<size_t>( 1, cores / active ) );
                     num++;
 
                     if( m_progressReporter )
@@ -459,7 +466,6 @@ bool ZONE_FILLER::Fill( std::vector<ZONE*>& aZones, bool aCheck, wxWindow* aPare
                 return num;
             };
 
-    size_t parallelThreadCount = std::min( cores, islandsList.size() );
     std::vector<std::future<size_t>> returns( parallelThreadCount );
 
     if( parallelThreadCount <= 1 )
@@ -1075,9 +1081,10 @@ bool ZONE_FILLER::computeRawFilledArea( const ZONE* aZone,
     if( m_progressReporter && m_progressReporter->IsCancelled() )
         return false;
 
-    // Spoke-end-testing is hugely expensive so we generate cached bounding-boxes to speed
-    // things up a bit.
+    // Spoke-end-testing is hugely expensive so we generate cached bounding-boxes and an edge
+    // index to speed things up a bit.
     testAreas.BuildBBoxCaches();
+    testAreas.BuildEdgeIndex();
     int interval = 0;
 
     SHAPE_POLY_SET debugSpokes;
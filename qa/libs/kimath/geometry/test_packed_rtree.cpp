@@ -0,0 +1,138 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/packed_rtree.h>
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <array>
+#include <random>
+#include <set>
+
+BOOST_AUTO_TEST_SUITE( PackedRTree )
+
+
+/**
+ * Every query must return exactly the items whose boxes overlap the query box, for tree
+ * sizes around the node size boundaries.
+ */
+BOOST_AUTO_TEST_CASE( SearchMatchesBruteForce )
+{
+    std::mt19937                       rng( 1234 );
+    std::uniform_int_distribution<int> coord( -1000000, 1000000 );
+    std::uniform_int_distribution<int> extent( 0, 50000 );
+
+    for( int count : { 0, 1, 15, 16, 17, 255, 256, 257, 5000 } )
+    {
+        std::vector<std::pair<std::array<int, 2>, std::array<int, 2>>> boxes;
+        PACKED_RTREE<int>                                              tree;
+
+        for( int i = 0; i < count; i++ )
+        {
+            int x = coord( rng ), y = coord( rng );
+            std::array<int, 2> bmin = { x, y };
+            std::array<int, 2> bmax = { x + extent( rng ), y + extent( rng ) };
+
+            boxes.emplace_back( bmin, bmax );
+            tree.Insert( bmin.data(), bmax.data(), i );
+        }
+
+        tree.Build();
+
+        BOOST_CHECK_EQUAL( tree.size(), (size_t) count );
+
+        // Iterating visits every item once
+        std::set<int> all( tree.begin(), tree.end() );
+        BOOST_CHECK_EQUAL( all.size(), (size_t) count );
+
+        for( int q = 0; q < 50; q++ )
+        {
+            int x = coord( rng ), y = coord( rng );
+            int qmin[2] = { x, y };
+            int qmax[2] = { x + 10 * extent( rng ), y + 10 * extent( rng ) };
+
+            std::set<int> expected, actual;
+
+            for( int i = 0; i < count; i++ )
+            {
+                const auto& b = boxes[i];
+
+                if( b.first[0] <= qmax[0] && b.second[0] >= qmin[0] && b.first[1] <= qmax[1]
+                        && b.second[1] >= qmin[1] )
+                {
+                    expected.insert( i );
+                }
+            }
+
+            auto visitor =
+                    [&]( int aItem ) -> bool
+                    {
+                        BOOST_CHECK( actual.insert( aItem ).second );
+                        return true;
+                    };
+
+            BOOST_CHECK_EQUAL( tree.Search( qmin, qmax, visitor ), (int) expected.size() );
+            BOOST_CHECK( expected == actual );
+        }
+    }
+}
+
+
+/**
+ * A visitor returning false stops the search.
+ */
+BOOST_AUTO_TEST_CASE( SearchStops )
+{
+    PACKED_RTREE<int> tree;
+
+    for( int i = 0; i < 100; i++ )
+    {
+        int bmin[2] = { i, i };
+        int bmax[2] = { i + 10, i + 10 };
+        tree.Insert( bmin, bmax, i );
+    }
+
+    tree.Build();
+
+    int qmin[2] = { 0, 0 };
+    int qmax[2] = { 200, 200 };
+    int visits = 0;
+
+    auto visitor =
+            [&]( int ) -> bool
+            {
+                return ++visits < 5;
+            };
+
+    BOOST_CHECK_EQUAL( tree.Search( qmin, qmax, visitor ), 4 );
+    BOOST_CHECK_EQUAL( visits, 5 );
+
+    tree.RemoveAll();
+    tree.Build();
+
+    BOOST_CHECK( tree.empty() );
+    BOOST_CHECK_EQUAL( tree.Search( qmin, qmax, visitor ), 0 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
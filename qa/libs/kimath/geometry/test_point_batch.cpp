@@ -0,0 +1,114 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/point_batch.h>
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE( PointBatch )
+
+
+static std::vector<VECTOR2I> randomPoints( std::mt19937& aRng, int aCount, int aRange )
+{
+    std::uniform_int_distribution<int> coord( -aRange, aRange );
+    std::vector<VECTOR2I>              points;
+
+    for( int i = 0; i < aCount; i++ )
+        points.emplace_back( coord( aRng ), coord( aRng ) );
+
+    return points;
+}
+
+
+/**
+ * Batched rotations must give the same points as VECTOR2I::Rotate(), including for angles
+ * that are multiples of 90 degrees and for results that do not fit in an int.
+ */
+BOOST_AUTO_TEST_CASE( RotateMatchesVector )
+{
+    std::mt19937 rng( 31337 );
+
+    const double angles[] = { 0.0, M_PI_2, M_PI, 3 * M_PI_2, 2 * M_PI, -M_PI_2, 0.1, -2.5,
+                              1.0e-3, M_PI / 6, 7.0 };
+
+    for( double angle : angles )
+    {
+        BOOST_TEST_CONTEXT( "Angle " << angle )
+        {
+            // 200 points, so that several blocks are used with a partial last one
+            std::vector<VECTOR2I> points = randomPoints( rng, 200, 100000000 );
+            std::vector<VECTOR2I> batch = points;
+            VECTOR2I              center( 12345, -6789 );
+
+            RotatePoints( batch.data(), batch.size(), angle, center );
+
+            for( size_t i = 0; i < points.size(); i++ )
+            {
+                VECTOR2I expected = ( points[i] - center ).Rotate( angle ) + center;
+                BOOST_CHECK_EQUAL( batch[i], expected );
+            }
+        }
+    }
+
+    // Near the limits of the int range the rotated points overflow and take the KiROUND path
+    std::vector<VECTOR2I> big = randomPoints( rng, 100, std::numeric_limits<int>::max() - 10 );
+    std::vector<VECTOR2I> bigBatch = big;
+
+    RotatePoints( bigBatch.data(), bigBatch.size(), M_PI / 4, VECTOR2I( 0, 0 ) );
+
+    for( size_t i = 0; i < big.size(); i++ )
+        BOOST_CHECK_EQUAL( bigBatch[i], big[i].Rotate( M_PI / 4 ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( MoveAndMirror )
+{
+    std::mt19937          rng( 4711 );
+    std::vector<VECTOR2I> points = randomPoints( rng, 100, 100000000 );
+    std::vector<VECTOR2I> batch = points;
+    VECTOR2I              offset( -1000, 2500 );
+    VECTOR2I              ref( 300, -400 );
+
+    MovePoints( batch.data(), batch.size(), offset );
+
+    for( size_t i = 0; i < points.size(); i++ )
+        BOOST_CHECK_EQUAL( batch[i], points[i] + offset );
+
+    batch = points;
+    MirrorPoints( batch.data(), batch.size(), true, false, ref );
+
+    for( size_t i = 0; i < points.size(); i++ )
+        BOOST_CHECK_EQUAL( batch[i], VECTOR2I( 2 * ref.x - points[i].x, points[i].y ) );
+
+    batch = points;
+    MirrorPoints( batch.data(), batch.size(), true, true, ref );
+
+    for( size_t i = 0; i < points.size(); i++ )
+        BOOST_CHECK_EQUAL( batch[i], 2 * ref - points[i] );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,205 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/seg_batch.h>
+#include <geometry/shape_line_chain.h>
+
+#include <unit_test_utils/geometry.h>
+#include <unit_test_utils/numeric.h>
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <random>
+
+BOOST_AUTO_TEST_SUITE( SegBatch )
+
+
+/**
+ * The segment lower bound must never exceed the exact distance, whatever the scale of the
+ * coordinates and including touching, crossing, collinear and degenerate segments, and it
+ * must stay close to the exact distance for segments that are far apart.
+ */
+BOOST_AUTO_TEST_CASE( DistanceLowerBoundIsConservative )
+{
+    std::mt19937 rng( 777 );
+
+    auto check =
+            [&]( SEG_BATCH& aBatch, const SEG& aQuery )
+            {
+                const double* bounds = aBatch.DistanceLowerBounds( aQuery );
+
+                for( int i = 0; i < aBatch.Size(); i++ )
+                {
+                    double exact = (double) aBatch.Get( i ).SquaredDistance( aQuery );
+
+                    BOOST_CHECK( bounds[i] < exact || bounds[i] <= 0.0 );
+
+                    if( exact > 1e8 )
+                        BOOST_CHECK_GT( bounds[i], exact * 0.99 );
+                }
+            };
+
+    // SEG itself overflows beyond about 1e9 between end points
+    for( int range : { 10, 100000, 100000000, 500000000 } )
+    {
+        std::uniform_int_distribution<int> coord( -range, range );
+        std::uniform_int_distribution<int> step( -3, 3 );
+
+        for( int trial = 0; trial < 200; trial++ )
+        {
+            SEG       query( coord( rng ), coord( rng ), coord( rng ), coord( rng ) );
+            SEG_BATCH batch;
+
+            // Random segments, plus some that touch, cross or extend the query, lie on its
+            // line, or are single points
+            batch.Add( SEG( query.B, VECTOR2I( coord( rng ), coord( rng ) ) ) );
+            batch.Add( SEG( query.A + VECTOR2I( step( rng ), step( rng ) ),
+                            query.B + VECTOR2I( step( rng ), step( rng ) ) ) );
+            batch.Add( SEG( query.B, query.B + ( query.B - query.A ) / 2 ) );
+            batch.Add( SEG( query.A, query.A ) );
+            batch.Add( SEG( query.Center(), VECTOR2I( coord( rng ), coord( rng ) ) ) );
+
+            while( !batch.Full() )
+            {
+                VECTOR2I a( coord( rng ), coord( rng ) );
+                batch.Add( SEG( a, a + VECTOR2I( coord( rng ), coord( rng ) ) / 4 ) );
+            }
+
+            check( batch, query );
+            check( batch, SEG( query.A, query.A ) );
+        }
+    }
+
+    // Collinear and far apart: no orientation test can tell, but the bound must still be tight
+    SEG_BATCH collinear;
+
+    collinear.Add( SEG( VECTOR2I( 1000000, 0 ), VECTOR2I( 2000000, 0 ) ) );
+    collinear.Add( SEG( VECTOR2I( -2000000, -2000000 ), VECTOR2I( -1000000, -1000000 ) ) );
+
+    check( collinear, SEG( VECTOR2I( 0, 0 ), VECTOR2I( 10, 0 ) ) );
+    check( collinear, SEG( VECTOR2I( 0, 0 ), VECTOR2I( 10, 10 ) ) );
+}
+
+
+/**
+ * The box lower bound must never exceed the exact distance, including for coordinates near
+ * the limits of the int range.
+ */
+BOOST_AUTO_TEST_CASE( LowerBoundIsConservative )
+{
+    std::mt19937                       rng( 12345 );
+    std::uniform_int_distribution<int> coord( -100000, 100000 );
+
+    for( int trial = 0; trial < 200; trial++ )
+    {
+        SEG_BATCH batch;
+
+        while( !batch.Full() )
+            batch.Add( SEG( coord( rng ), coord( rng ), coord( rng ), coord( rng ) ) );
+
+        SEG query( coord( rng ), coord( rng ), coord( rng ), coord( rng ) );
+
+        const double* bounds =
+                batch.BoxDistanceLowerBounds( BOX2I( query.A, query.B - query.A ).Normalize() );
+
+        for( int i = 0; i < batch.Size(); i++ )
+        {
+            double exact = (double) batch.Get( i ).SquaredDistance( query );
+
+            // Strictly below, so that the bound never proves a threshold equal to the distance
+            BOOST_CHECK( bounds[i] < exact || bounds[i] == 0.0 );
+        }
+    }
+
+    SEG_BATCH farBatch;
+
+    farBatch.Add( SEG( VECTOR2I( INT_MAX - 10, INT_MAX - 10 ), VECTOR2I( INT_MAX, INT_MAX ) ) );
+
+    const double* bound = farBatch.BoxDistanceLowerBounds(
+            BOX2I( VECTOR2I( INT_MIN + 10, INT_MIN + 10 ), VECTOR2I( 10, 10 ) ) );
+
+    BOOST_CHECK_GT( bound[0], 0.0 );
+
+    // Axis-aligned segments one unit apart: the exact distance equals the box gap, and the
+    // bound must stay below any threshold it cannot prove
+    SEG_BATCH gapBatch;
+
+    gapBatch.Add( SEG( VECTOR2I( 0, 1000000000 ), VECTOR2I( 100, 1000000000 ) ) );
+
+    bound = gapBatch.BoxDistanceLowerBounds( BOX2I( VECTOR2I( 0, 0 ), VECTOR2I( 100, 0 ) ) );
+
+    BOOST_CHECK_LT( bound[0], (double) SEG::Square( 1000000000 ) );
+    BOOST_CHECK_GT( bound[0], (double) SEG::Square( 999999999 ) );
+}
+
+
+/**
+ * Batched SHAPE_LINE_CHAIN collisions must give the same answers as a plain loop over the
+ * chain's segments.
+ */
+BOOST_AUTO_TEST_CASE( ChainCollideMatchesBruteForce )
+{
+    std::mt19937                       rng( 4242 );
+    std::uniform_int_distribution<int> coord( -50000, 50000 );
+    std::uniform_int_distribution<int> clearance( 0, 5000 );
+
+    for( int trial = 0; trial < 100; trial++ )
+    {
+        SHAPE_LINE_CHAIN chain;
+
+        for( int i = 0; i < 40; i++ )
+            chain.Append( coord( rng ), coord( rng ) );
+
+        SEG query( coord( rng ), coord( rng ), coord( rng ), coord( rng ) );
+        int clr = clearance( rng );
+
+        SEG::ecoord expected = VECTOR2I::ECOORD_MAX;
+
+        for( int i = 0; i < chain.SegmentCount(); i++ )
+            expected = std::min( expected, chain.CSegment( i ).SquaredDistance( query ) );
+
+        int  actual = -1;
+        bool expectCollide = expected == 0 || expected < SEG::Square( clr );
+
+        BOOST_CHECK_EQUAL( chain.Collide( query, clr, &actual ), expectCollide );
+        BOOST_CHECK_EQUAL( chain.Collide( query, clr ), expectCollide );
+
+        if( expectCollide )
+            BOOST_CHECK_EQUAL( actual, (int) sqrt( expected ) );
+
+        SEG::ecoord expectedPt = VECTOR2I::ECOORD_MAX;
+
+        for( int i = 0; i < chain.SegmentCount(); i++ )
+            expectedPt = std::min( expectedPt, chain.CSegment( i ).SquaredDistance( query.A ) );
+
+        expectCollide = expectedPt == 0 || expectedPt < SEG::Square( clr );
+
+        BOOST_CHECK_EQUAL( chain.Collide( query.A, clr, &actual ), expectCollide );
+        BOOST_CHECK_EQUAL( chain.Collide( query.A, clr ), expectCollide );
+
+        if( expectCollide )
+            BOOST_CHECK_EQUAL( actual, (int) sqrt( expectedPt ) );
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
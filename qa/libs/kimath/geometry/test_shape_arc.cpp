@@ -23,6 +23,7 @@
 
 #include <geometry/shape_arc.h>
 
+#include <geometry/shape_circle.h>
 #include <geometry/shape_line_chain.h>
 
 #include <unit_test_utils/geometry.h>
@@ -31,6 +32,8 @@
 
 #include "geom_test_utils.h"
 
+#include <random>
+
 BOOST_AUTO_TEST_SUITE( ShapeArc )
 
 /**
@@ -612,4 +615,117 @@ BOOST_AUTO_TEST_CASE( ArcToPolyline )
 }
 
 
+/**
+ * Exact arc distances must agree with the distances to a fine polyline approximation of the
+ * arcs, within the approximation error.
+ */
+BOOST_AUTO_TEST_CASE( ExactDistances )
+{
+    std::mt19937                          rng( 777 );
+    std::uniform_int_distribution<int>    coord( -200000, 200000 );
+    std::uniform_int_distribution<int>    radius( 1000, 150000 );
+    std::uniform_real_distribution<double> angle( -350.0, 350.0 );
+
+    const int accuracy = 10;
+    const int tolerance = accuracy + 2;
+
+    auto randomArc =
+            [&]()
+            {
+                VECTOR2I center( coord( rng ), coord( rng ) );
+                VECTOR2I start = center + VECTOR2I( radius( rng ), 0 );
+                SHAPE_ARC arc( center, start, 0.0 );
+
+                // Rotate the start point around the center so arcs begin at any angle
+                arc.Rotate( angle( rng ) * M_PI / 180.0, center );
+
+                // Arcs of almost no angle have no polyline approximation to compare with
+                double sweep = angle( rng );
+
+                if( std::abs( sweep ) < 1.0 )
+                    sweep = 1.0;
+
+                return SHAPE_ARC( center, arc.GetP0(), sweep );
+            };
+
+    auto chainDistance =
+            []( const SHAPE_LINE_CHAIN& aA, const SHAPE_LINE_CHAIN& aB )
+            {
+                SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+
+                for( int i = 0; i < aA.SegmentCount(); i++ )
+                {
+                    for( int j = 0; j < aB.SegmentCount(); j++ )
+                        best = std::min( best, aA.CSegment( i ).SquaredDistance( aB.CSegment( j ) ) );
+                }
+
+                return sqrt( best );
+            };
+
+    for( int trial = 0; trial < 100; trial++ )
+    {
+        SHAPE_ARC        arc = randomArc();
+        SHAPE_LINE_CHAIN arcPoly = arc.ConvertToPolyline( accuracy );
+
+        SEG              seg( coord( rng ), coord( rng ), coord( rng ), coord( rng ) );
+        SHAPE_LINE_CHAIN segChain( { seg.A, seg.B } );
+        VECTOR2I         nearest;
+
+        double exact = sqrt( arc.SquaredDistance( seg, &nearest ) );
+
+        BOOST_CHECK_LE( std::abs( exact - chainDistance( arcPoly, segChain ) ), tolerance );
+        BOOST_CHECK_LE( std::abs( seg.Distance( nearest ) - exact ), 2 );
+
+        VECTOR2I pt( coord( rng ), coord( rng ) );
+        double   ptDist = ( arc.NearestPoint( pt ) - pt ).EuclideanNorm();
+        double   polyDist = sqrt( arcPoly.SquaredDistance( pt ) );
+
+        BOOST_CHECK_LE( std::abs( ptDist - polyDist ), tolerance );
+
+        SHAPE_ARC other = randomArc();
+
+        exact = sqrt( arc.SquaredDistance( other, &nearest ) );
+
+        BOOST_CHECK_LE( std::abs( exact - chainDistance( arcPoly,
+                                                         other.ConvertToPolyline( accuracy ) ) ),
+                        tolerance );
+    }
+}
+
+
+/**
+ * Collisions between arcs and other shapes take the widths into account.
+ */
+BOOST_AUTO_TEST_CASE( CollideWithWidth )
+{
+    // Quarter circle of radius 1000 around the origin, from (1000, 0) to (0, 1000)
+    SHAPE_ARC arc( VECTOR2I( 0, 0 ), VECTOR2I( 1000, 0 ), 90.0, 100 );
+    int       actual = 0;
+
+    // Distances are within a unit of the exact values, the nearest points being rounded
+
+    // Segment parallel to the chord, beyond the arc
+    SEG seg( VECTOR2I( 2000, 0 ), VECTOR2I( 0, 2000 ) );
+
+    BOOST_CHECK( !arc.Collide( seg, 0 ) );
+    BOOST_CHECK( arc.Collide( seg, 400, &actual ) );
+    BOOST_CHECK_LE( std::abs( actual - ( 414 - 50 ) ), 1 );
+
+    // Point on the other side of the center sees only the arc ends
+    BOOST_CHECK( !arc.Collide( VECTOR2I( -1000, -1000 ), 1500 ) );
+    BOOST_CHECK( arc.Collide( VECTOR2I( 700, 700 ), 20, &actual ) );
+    BOOST_CHECK_EQUAL( actual, 0 );
+
+    SHAPE_ARC    other( VECTOR2I( 0, 0 ), VECTOR2I( 1300, 0 ), 90.0, 100 );
+    SHAPE_CIRCLE circle( VECTOR2I( 3000, 0 ), 1800 );
+    const SHAPE* arcShape = &arc;
+
+    BOOST_CHECK( !arcShape->Collide( &other, 190 ) );
+    BOOST_CHECK( arcShape->Collide( &other, 210, &actual ) );
+    BOOST_CHECK_LE( std::abs( actual - 200 ), 1 );
+    BOOST_CHECK( arcShape->Collide( &circle, 160, &actual ) );
+    BOOST_CHECK_LE( std::abs( actual - 150 ), 1 );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -23,6 +23,8 @@
 
 #include <geometry/shape_arc.h>
 #include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+#include <math/util.h>
 
 #include <unit_test_utils/geometry.h>
 #include <unit_test_utils/numeric.h>
@@ -59,4 +61,97 @@ BOOST_AUTO_TEST_CASE( ArcToPolyline )
 }
 
 
+/**
+ * Decimating must keep every original vertex within the allowed error of the result, and
+ * must remove the vertices of straight runs.
+ */
+BOOST_AUTO_TEST_CASE( Decimated )
+{
+    SHAPE_LINE_CHAIN circle;
+
+    for( int i = 0; i < 3600; i++ )
+    {
+        double angle = i * M_PI / 1800.0;
+        circle.Append( KiROUND( 1000000 * cos( angle ) ), KiROUND( 1000000 * sin( angle ) ) );
+    }
+
+    circle.SetClosed( true );
+
+    for( int maxError : { 100, 1000, 10000 } )
+    {
+        SHAPE_LINE_CHAIN decimated = circle.Decimated( maxError );
+
+        BOOST_CHECK( decimated.IsClosed() );
+        BOOST_CHECK_LT( decimated.PointCount(), circle.PointCount() );
+
+        for( const VECTOR2I& pt : circle.CPoints() )
+            BOOST_CHECK_LE( decimated.Distance( pt, true ), maxError );
+    }
+
+    SHAPE_LINE_CHAIN square;
+
+    for( int i = 0; i < 100; i++ )
+        square.Append( i * 100, 0 );
+
+    for( int i = 0; i < 100; i++ )
+        square.Append( 10000, i * 100 );
+
+    square.Append( 10000, 10000 );
+    square.Append( 0, 10000 );
+    square.SetClosed( true );
+
+    BOOST_CHECK_EQUAL( square.Decimated( 1 ).PointCount(), 4 );
+
+    SHAPE_POLY_SET polys;
+
+    polys.AddOutline( square );
+    polys.AddHole( SHAPE_LINE_CHAIN( { VECTOR2I( 10, 10 ), VECTOR2I( 20, 10 ),
+                                       VECTOR2I( 20, 20 ) }, true ) );
+    polys.AddOutline( SHAPE_LINE_CHAIN( { VECTOR2I( 20000, 0 ), VECTOR2I( 20050, 0 ),
+                                          VECTOR2I( 20050, 50 ) }, true ) );
+
+    // The hole and the second outline are smaller than the error and must be dropped
+    SHAPE_POLY_SET decimated = polys.Decimated( 100 );
+
+    BOOST_CHECK_EQUAL( decimated.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( decimated.HoleCount( 0 ), 0 );
+    BOOST_CHECK_EQUAL( decimated.COutline( 0 ).PointCount(), 4 );
+}
+
+
+/**
+ * A moved chain must keep its points, arcs and closure.  Move construction takes over the
+ * storage of the source, leaving it without points or arcs.
+ */
+BOOST_AUTO_TEST_CASE( Move )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    chain.Reserve( 8 );
+    chain.Append( 0, 0 );
+    chain.Append( SHAPE_ARC( VECTOR2I( 1000, 0 ), VECTOR2I( 2000, 1000 ), VECTOR2I( 1000, 2000 ),
+                             0 ) );
+    chain.SetClosed( true );
+
+    const SHAPE_LINE_CHAIN copy( chain );
+    SHAPE_LINE_CHAIN       moved( std::move( chain ) );
+
+    BOOST_CHECK_EQUAL( moved.PointCount(), copy.PointCount() );
+    BOOST_CHECK_EQUAL( moved.CShapes().size(), moved.CPoints().size() );
+    BOOST_CHECK_EQUAL( moved.ArcCount(), copy.ArcCount() );
+    BOOST_CHECK( moved.IsClosed() );
+    BOOST_CHECK( moved.BBox() == copy.BBox() );
+
+    BOOST_CHECK_EQUAL( chain.PointCount(), 0 );
+    BOOST_CHECK_EQUAL( chain.ArcCount(), 0u );
+    BOOST_CHECK( chain.CShapes().empty() );
+
+    SHAPE_LINE_CHAIN assigned;
+    assigned = std::move( moved );
+
+    BOOST_CHECK( assigned.CPoints() == copy.CPoints() );
+    BOOST_CHECK_EQUAL( assigned.ArcCount(), copy.ArcCount() );
+}
+
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,245 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_poly_set.h>
+
+#include <unit_test_utils/geometry.h>
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <cmath>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE( SPSEdgeIndex )
+
+
+/**
+ * A star-shaped contour with \a aCount vertices at random radii around \a aCenter.
+ */
+static SHAPE_LINE_CHAIN randomStar( std::mt19937& aRng, const VECTOR2I& aCenter, int aCount,
+                                    int aMinRadius, int aMaxRadius )
+{
+    std::uniform_int_distribution<int> radius( aMinRadius, aMaxRadius );
+    SHAPE_LINE_CHAIN                   chain;
+
+    for( int i = 0; i < aCount; i++ )
+    {
+        double angle = 2.0 * M_PI * i / aCount;
+        int    r = radius( aRng );
+
+        chain.Append( aCenter.x + KiROUND( r * cos( angle ) ),
+                      aCenter.y + KiROUND( r * sin( angle ) ) );
+    }
+
+    chain.SetClosed( true );
+    return chain;
+}
+
+
+/**
+ * A set large enough to be indexed: one big polygon with holes and a small polygon.
+ */
+static SHAPE_POLY_SET buildSet( std::mt19937& aRng )
+{
+    SHAPE_POLY_SET set;
+
+    set.AddOutline( randomStar( aRng, VECTOR2I( 0, 0 ), 2000, 600000, 1000000 ) );
+
+    for( int i = 0; i < 4; i++ )
+    {
+        VECTOR2I center( i % 2 ? 250000 : -250000, i / 2 ? 250000 : -250000 );
+        set.AddHole( randomStar( aRng, center, 100, 50000, 150000 ), 0 );
+    }
+
+    set.AddOutline( randomStar( aRng, VECTOR2I( 2000000, 0 ), 8, 100000, 200000 ) );
+
+    return set;
+}
+
+
+static bool refContainsSingle( const SHAPE_POLY_SET& aSet, int aIndex, const VECTOR2I& aP,
+                               int aAccuracy )
+{
+    if( !aSet.COutline( aIndex ).PointInside( aP, aAccuracy ) )
+        return false;
+
+    for( int jj = 0; jj < aSet.HoleCount( aIndex ); jj++ )
+    {
+        if( aSet.CHole( aIndex, jj ).PointInside( aP, 1 ) )
+            return false;
+    }
+
+    return true;
+}
+
+
+static bool refContains( const SHAPE_POLY_SET& aSet, const VECTOR2I& aP, int aAccuracy )
+{
+    for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
+    {
+        if( refContainsSingle( aSet, ii, aP, aAccuracy ) )
+            return true;
+    }
+
+    return false;
+}
+
+
+template <class QUERY>
+static SEG::ecoord refDistance( const SHAPE_POLY_SET& aSet, const QUERY& aQuery,
+                                const VECTOR2I& aInsidePoint )
+{
+    SEG::ecoord best = VECTOR2I::ECOORD_MAX;
+
+    for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
+    {
+        if( refContainsSingle( aSet, ii, aInsidePoint, 1 ) )
+            return 0;
+
+        for( auto it = aSet.CIterateSegmentsWithHoles( ii ); it; it++ )
+            best = std::min( best, ( *it ).SquaredDistance( aQuery ) );
+    }
+
+    return best;
+}
+
+
+static void checkQueries( const SHAPE_POLY_SET& aSet, std::mt19937& aRng, int aCount )
+{
+    std::uniform_int_distribution<int> coord( -1200000, 2300000 );
+    std::uniform_int_distribution<int> offset( -50000, 50000 );
+    std::uniform_int_distribution<int> accuracy( 0, 20000 );
+
+    for( int i = 0; i < aCount; i++ )
+    {
+        VECTOR2I p( coord( aRng ), coord( aRng ) );
+        SEG      seg( p, p + VECTOR2I( offset( aRng ), offset( aRng ) ) );
+        int      acc = accuracy( aRng );
+
+        BOOST_CHECK_EQUAL( aSet.Contains( p ), refContains( aSet, p, 0 ) );
+        BOOST_CHECK_EQUAL( aSet.Contains( p, -1, acc ), refContains( aSet, p, acc ) );
+        BOOST_CHECK_EQUAL( aSet.SquaredDistance( p ), refDistance( aSet, p, p ) );
+        BOOST_CHECK_EQUAL( aSet.SquaredDistance( seg ), refDistance( aSet, seg, seg.A ) );
+
+        VECTOR2I nearest;
+        SEG::ecoord dist = aSet.SquaredDistance( p, &nearest );
+
+        if( dist > 0 )
+            BOOST_CHECK_EQUAL( ( nearest - p ).SquaredEuclideanNorm(), dist );
+    }
+}
+
+
+/**
+ * Queries of a large set answered through the edge index must give the same results as a
+ * linear scan of the edges.
+ */
+BOOST_AUTO_TEST_CASE( MatchesLinearScan )
+{
+    std::mt19937   rng( 1234 );
+    SHAPE_POLY_SET set = buildSet( rng );
+
+    set.BuildEdgeIndex();
+    checkQueries( set, rng, 2000 );
+
+    // Points on the contours and on the rays through vertices are the degenerate cases
+    for( int ii = 0; ii < set.TotalVertices(); ii += 7 )
+    {
+        VECTOR2I v = set.CVertex( ii );
+
+        for( const VECTOR2I& p : { v, v + VECTOR2I( -1, 0 ), v + VECTOR2I( -1000, 0 ) } )
+        {
+            BOOST_CHECK_EQUAL( set.Contains( p ), refContains( set, p, 0 ) );
+            BOOST_CHECK_EQUAL( set.SquaredDistance( p ), refDistance( set, p, p ) );
+        }
+    }
+
+    // Copies share the index and must stay correct when modified independently
+    SHAPE_POLY_SET copy( set );
+
+    checkQueries( copy, rng, 100 );
+}
+
+
+/**
+ * Modifying the set must drop the index.
+ */
+BOOST_AUTO_TEST_CASE( Invalidation )
+{
+    std::mt19937   rng( 5678 );
+    SHAPE_POLY_SET set = buildSet( rng );
+
+    set.BuildEdgeIndex();
+    checkQueries( set, rng, 50 );
+
+    SHAPE_POLY_SET copy( set );
+
+    set.Move( VECTOR2I( 300000, -100000 ) );
+    checkQueries( set, rng, 200 );
+    checkQueries( copy, rng, 50 );
+
+    set.BuildEdgeIndex();
+    set.Outline( 0 ).SetPoint( 0, VECTOR2I( 0, 0 ) );
+    checkQueries( set, rng, 200 );
+
+    set.BuildEdgeIndex();
+
+    for( int ii = 0; ii < set.TotalVertices(); ii += 3 )
+        set.SetVertex( ii, set.CVertex( ii ) / 2 );
+
+    checkQueries( set, rng, 200 );
+
+    set.BuildEdgeIndex();
+    set.RemoveAllContours();
+    set.Append( copy );
+    checkQueries( set, rng, 200 );
+}
+
+
+/**
+ * Contours edited through the references returned by the non-const accessors must not be
+ * looked up through edges they no longer have.
+ */
+BOOST_AUTO_TEST_CASE( ContourReferenceEdits )
+{
+    std::mt19937   rng( 9012 );
+    SHAPE_POLY_SET set = buildSet( rng );
+
+    set.BuildEdgeIndex();
+
+    SHAPE_LINE_CHAIN& outline = set.Outline( 0 );
+
+    for( int ii = 0; ii < 500; ii++ )
+        outline.Remove( outline.PointCount() - 1 );
+
+    checkQueries( set, rng, 200 );
+
+    set.BuildEdgeIndex();
+
+    SHAPE_POLY_SET::POLYGON& poly = set.Polygon( 0 );
+
+    poly[0].Append( poly[0].CPoint( 0 ) + VECTOR2I( 1000, 1000 ) );
+    checkQueries( set, rng, 200 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,319 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_poly_set.h>
+#include <math/util.h>
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <limits>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE( SPSFracture )
+
+
+/**
+ * The original hole bridging of SHAPE_POLY_SET::fractureSingle(), which scans all the edges
+ * for every hole.  The indexed version must give exactly the same polygons.
+ */
+namespace REFERENCE
+{
+
+struct EDGE
+{
+    EDGE( bool aConnected, const VECTOR2I& aP1, const VECTOR2I& aP2 ) :
+            m_connected( aConnected ),
+            m_p1( aP1 ),
+            m_p2( aP2 ),
+            m_next( nullptr )
+    {
+    }
+
+    bool matches( int y ) const
+    {
+        return ( y >= m_p1.y || y >= m_p2.y ) && ( y <= m_p1.y || y <= m_p2.y );
+    }
+
+    bool     m_connected;
+    VECTOR2I m_p1, m_p2;
+    EDGE*    m_next;
+};
+
+
+static int processEdge( std::vector<EDGE*>& edges, EDGE* edge )
+{
+    int x = edge->m_p1.x;
+    int y = edge->m_p1.y;
+    int min_dist = std::numeric_limits<int>::max();
+    int x_nearest = 0;
+
+    EDGE* e_nearest = nullptr;
+
+    for( EDGE* e : edges )
+    {
+        if( !e->matches( y ) )
+            continue;
+
+        int x_intersect;
+
+        if( e->m_p1.y == e->m_p2.y )
+            x_intersect = std::max( e->m_p1.x, e->m_p2.x );
+        else
+            x_intersect = e->m_p1.x + rescale( e->m_p2.x - e->m_p1.x, y - e->m_p1.y,
+                                               e->m_p2.y - e->m_p1.y );
+
+        int dist = ( x - x_intersect );
+
+        if( dist >= 0 && dist < min_dist && e->m_connected )
+        {
+            min_dist = dist;
+            x_nearest = x_intersect;
+            e_nearest = e;
+        }
+    }
+
+    if( !e_nearest )
+        return 0;
+
+    int count = 0;
+
+    EDGE* lead1 = new EDGE( true, VECTOR2I( x_nearest, y ), VECTOR2I( x, y ) );
+    EDGE* lead2 = new EDGE( true, VECTOR2I( x, y ), VECTOR2I( x_nearest, y ) );
+    EDGE* split_2 = new EDGE( true, VECTOR2I( x_nearest, y ), e_nearest->m_p2 );
+
+    edges.push_back( split_2 );
+    edges.push_back( lead1 );
+    edges.push_back( lead2 );
+
+    EDGE* link = e_nearest->m_next;
+
+    e_nearest->m_p2 = VECTOR2I( x_nearest, y );
+    e_nearest->m_next = lead1;
+    lead1->m_next = edge;
+
+    EDGE* last;
+
+    for( last = edge; last->m_next != edge; last = last->m_next )
+    {
+        last->m_connected = true;
+        count++;
+    }
+
+    last->m_connected = true;
+    last->m_next = lead2;
+    lead2->m_next = split_2;
+    split_2->m_next = link;
+
+    return count + 1;
+}
+
+
+static SHAPE_LINE_CHAIN fracture( const SHAPE_POLY_SET::POLYGON& paths )
+{
+    std::vector<EDGE*> edges;
+    std::vector<EDGE*> border_edges;
+    EDGE*              root = nullptr;
+    bool               first = true;
+    int                num_unconnected = 0;
+
+    for( const SHAPE_LINE_CHAIN& path : paths )
+    {
+        const SHAPE_LINE_CHAIN::POINT_VECTOR& points = path.CPoints();
+        int                          pointCount = points.size();
+        EDGE*                        prev = nullptr;
+        EDGE*                        first_edge = nullptr;
+        int                          x_min = std::numeric_limits<int>::max();
+
+        for( const VECTOR2I& p : points )
+            x_min = std::min( x_min, p.x );
+
+        for( int i = 0; i < pointCount; i++ )
+        {
+            EDGE* fe = new EDGE( first, points[i], points[i + 1 == pointCount ? 0 : i + 1] );
+
+            if( !root )
+                root = fe;
+
+            if( !first_edge )
+                first_edge = fe;
+
+            if( prev )
+                prev->m_next = fe;
+
+            if( i == pointCount - 1 )
+                fe->m_next = first_edge;
+
+            prev = fe;
+            edges.push_back( fe );
+
+            if( !first && fe->m_p1.x == x_min )
+                border_edges.push_back( fe );
+
+            if( !fe->m_connected )
+                num_unconnected++;
+        }
+
+        first = false;
+    }
+
+    while( num_unconnected > 0 )
+    {
+        int   x_min = std::numeric_limits<int>::max();
+        EDGE* smallestX = nullptr;
+
+        for( EDGE* border_edge : border_edges )
+        {
+            if( border_edge->m_p1.x < x_min && !border_edge->m_connected )
+            {
+                x_min = border_edge->m_p1.x;
+                smallestX = border_edge;
+            }
+        }
+
+        int connected = processEdge( edges, smallestX );
+
+        BOOST_REQUIRE( connected > 0 );
+        num_unconnected -= connected;
+    }
+
+    SHAPE_LINE_CHAIN newPath;
+    EDGE*            e;
+
+    newPath.SetClosed( true );
+
+    for( e = root; e->m_next != root; e = e->m_next )
+        newPath.Append( e->m_p1 );
+
+    newPath.Append( e->m_p1 );
+
+    for( EDGE* edge : edges )
+        delete edge;
+
+    return newPath;
+}
+
+} // namespace REFERENCE
+
+
+/**
+ * A large jagged outline with many small holes, some of them sharing their left-most x or
+ * their y with others so that ties are exercised.
+ */
+static SHAPE_POLY_SET randomHoledPolygon( std::mt19937& aRng, int aGrid )
+{
+    const int pitch = 10000;
+    const int extent = aGrid * pitch;
+
+    std::uniform_int_distribution<int> jitter( 0, 3 );
+    std::uniform_int_distribution<int> corners( 3, 12 );
+    std::uniform_int_distribution<int> radius( 1000, 4000 );
+    std::uniform_int_distribution<int> skip( 0, 9 );
+
+    SHAPE_POLY_SET   poly;
+    SHAPE_LINE_CHAIN outline;
+
+    for( int i = 0; i <= aGrid; i++ )
+        outline.Append( i * pitch, -pitch - jitter( aRng ) * 1000 );
+
+    for( int i = aGrid; i >= 0; i-- )
+        outline.Append( i * pitch, extent + pitch + jitter( aRng ) * 1000 );
+
+    outline.SetClosed( true );
+    poly.AddOutline( outline );
+
+    for( int gx = 0; gx < aGrid; gx++ )
+    {
+        for( int gy = 0; gy < aGrid; gy++ )
+        {
+            if( skip( aRng ) == 0 )
+                continue;
+
+            // Coarse jitter so that holes often line up
+            VECTOR2I         center( gx * pitch + 5000 + jitter( aRng ) * 500,
+                                     gy * pitch + 5000 + jitter( aRng ) * 500 );
+            int              n = corners( aRng );
+            int              r = radius( aRng );
+            SHAPE_LINE_CHAIN hole;
+
+            for( int i = 0; i < n; i++ )
+            {
+                double angle = 2.0 * M_PI * i / n;
+                hole.Append( center.x + KiROUND( r * cos( angle ) ),
+                             center.y + KiROUND( r * sin( angle ) ) );
+            }
+
+            hole.SetClosed( true );
+            poly.AddHole( hole );
+        }
+    }
+
+    return poly;
+}
+
+
+BOOST_AUTO_TEST_CASE( MatchesReference )
+{
+    std::mt19937 rng( 2468 );
+
+    for( int trial = 0; trial < 20; trial++ )
+    {
+        SHAPE_POLY_SET poly = randomHoledPolygon( rng, 5 + trial );
+
+        poly.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+        SHAPE_POLY_SET fractured = poly;
+        fractured.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+        BOOST_REQUIRE_EQUAL( fractured.OutlineCount(), poly.OutlineCount() );
+
+        for( int i = 0; i < poly.OutlineCount(); i++ )
+        {
+            SHAPE_LINE_CHAIN expected = REFERENCE::fracture( poly.CPolygon( i ) );
+
+            BOOST_CHECK_EQUAL( fractured.HoleCount( i ), 0 );
+            BOOST_CHECK( fractured.COutline( i ).CPoints() == expected.CPoints() );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE( ManyHoles )
+{
+    std::mt19937   rng( 1357 );
+    SHAPE_POLY_SET poly = randomHoledPolygon( rng, 60 );
+
+    poly.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_LINE_CHAIN expected = REFERENCE::fracture( poly.CPolygon( 0 ) );
+
+    BOOST_CHECK_GT( poly.HoleCount( 0 ), 1000 );
+
+    poly.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_EQUAL( poly.OutlineCount(), 1 );
+    BOOST_CHECK_EQUAL( poly.HoleCount( 0 ), 0 );
+    BOOST_CHECK( poly.COutline( 0 ).CPoints() == expected.CPoints() );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,187 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_poly_set.h>
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <cmath>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE( SPSInflate )
+
+
+static SHAPE_LINE_CHAIN circle( const VECTOR2I& aCenter, int aRadius, int aSegments )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int ii = 0; ii < aSegments; ii++ )
+    {
+        double angle = 2.0 * M_PI * ii / aSegments;
+        chain.Append( aCenter.x + KiROUND( aRadius * cos( angle ) ),
+                      aCenter.y + KiROUND( aRadius * sin( angle ) ) );
+    }
+
+    chain.SetClosed( true );
+    return chain;
+}
+
+
+static double area( const SHAPE_POLY_SET& aSet )
+{
+    double area = 0.0;
+
+    for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
+    {
+        area += std::abs( aSet.COutline( ii ).Area() );
+
+        for( int jj = 0; jj < aSet.HoleCount( ii ); jj++ )
+            area -= std::abs( aSet.CHole( ii, jj ).Area() );
+    }
+
+    return area;
+}
+
+
+static int holeCount( const SHAPE_POLY_SET& aSet )
+{
+    int count = 0;
+
+    for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
+        count += aSet.HoleCount( ii );
+
+    return count;
+}
+
+
+/**
+ * Check that two sets cover the same area, give or take \a aTolerance (relative to the area
+ * of \a aExpected).
+ */
+static void checkSameArea( const SHAPE_POLY_SET& aExpected, const SHAPE_POLY_SET& aActual,
+                           double aTolerance )
+{
+    SHAPE_POLY_SET missing = aExpected;
+    missing.BooleanSubtract( aActual, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET extra = aActual;
+    extra.BooleanSubtract( aExpected, SHAPE_POLY_SET::PM_FAST );
+
+    double expectedArea = area( aExpected );
+
+    BOOST_CHECK_GT( expectedArea, 0.0 );
+    BOOST_CHECK_LE( area( missing ), expectedArea * aTolerance );
+    BOOST_CHECK_LE( area( extra ), expectedArea * aTolerance );
+}
+
+
+/**
+ * Many small overlapping polygons are inflated in groups by several threads; the result must
+ * be the same as when inflating on one thread.
+ *
+ * The set has just over 20000 vertices, the smallest set Inflate() splits between threads.
+ */
+BOOST_AUTO_TEST_CASE( ManyPolygons )
+{
+    std::mt19937                       rng( 2468 );
+    std::uniform_int_distribution<int> coord( 0, 4000000 );
+    std::uniform_int_distribution<int> radius( 10000, 60000 );
+    SHAPE_POLY_SET                     set;
+
+    for( int ii = 0; ii < 360; ii++ )
+        set.AddOutline( circle( VECTOR2I( coord( rng ), coord( rng ) ), radius( rng ), 64 ) );
+
+    // Deflating overlapping polygons removes their overlaps, so like the callers of Deflate()
+    // the test merges them first
+    SHAPE_POLY_SET merged = set;
+    merged.Simplify( SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_REQUIRE_GE( merged.TotalVertices(), 20000 );
+
+    for( int amount : { 20000, -5000 } )
+    {
+        const SHAPE_POLY_SET& input = amount > 0 ? set : merged;
+        const size_t          threads = amount > 0 ? 4 : 2;
+        SHAPE_POLY_SET        expected = input;
+        expected.Inflate( amount, 32 );
+
+        BOOST_TEST_CONTEXT( "Amount " << amount << ", " << threads << " threads" )
+        {
+            SHAPE_POLY_SET result = input;
+            result.Inflate( amount, 32, SHAPE_POLY_SET::ROUND_ALL_CORNERS, threads );
+
+            // Clipper rounds the crossings of the offset edges differently when other
+            // polygons are offset alongside, hence a small tolerance
+            checkSameArea( expected, result, 1e-6 );
+        }
+    }
+}
+
+
+/**
+ * A single polygon with many holes is inflated in tiles, and deflated whole.
+ *
+ * The polygon has just over 20000 vertices, enough to be split into 3 x 3 tiles.
+ */
+BOOST_AUTO_TEST_CASE( LargePolygon )
+{
+    const int      pitch = 100000;
+    const int      count = 10;
+    SHAPE_POLY_SET set;
+
+    set.AddOutline( SHAPE_LINE_CHAIN( { VECTOR2I( 0, 0 ), VECTOR2I( pitch * count, 0 ),
+                                        VECTOR2I( pitch * count, pitch * count ),
+                                        VECTOR2I( 0, pitch * count ) },
+                                      true ) );
+
+    for( int row = 0; row < count; row++ )
+    {
+        for( int col = 0; col < count; col++ )
+        {
+            VECTOR2I center( col * pitch + pitch / 2, row * pitch + pitch / 2 );
+            set.AddHole( circle( center, pitch / 3, 200 ) );
+        }
+    }
+
+    BOOST_REQUIRE_GE( set.TotalVertices(), 20000 );
+
+    for( int amount : { 10000, -10000 } )
+    {
+        BOOST_TEST_CONTEXT( "Amount " << amount )
+        {
+            SHAPE_POLY_SET expected = set;
+            expected.Inflate( amount, 32 );
+
+            SHAPE_POLY_SET result = set;
+            result.Inflate( amount, 32, SHAPE_POLY_SET::ROUND_ALL_CORNERS, 4 );
+
+            // Tiles approximate the arcs around the corners of their cut edges differently
+            checkSameArea( expected, result, 1e-6 );
+            BOOST_CHECK_EQUAL( result.OutlineCount(), expected.OutlineCount() );
+            BOOST_CHECK_EQUAL( holeCount( result ), holeCount( expected ) );
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
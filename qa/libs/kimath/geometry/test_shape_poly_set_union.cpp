@@ -0,0 +1,157 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+#include <geometry/shape_poly_set.h>
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <cmath>
+#include <random>
+
+BOOST_AUTO_TEST_SUITE( SPSUnionBatch )
+
+
+/**
+ * Random squares, some of them with a square hole, overlapping each other in clusters.
+ */
+static std::vector<SHAPE_POLY_SET> randomShapes( int aCount )
+{
+    std::mt19937                       rng( 9876 );
+    std::uniform_int_distribution<int> coord( 0, 2000000 );
+    std::uniform_int_distribution<int> size( 10000, 100000 );
+
+    std::vector<SHAPE_POLY_SET> shapes( aCount );
+
+    for( SHAPE_POLY_SET& shape : shapes )
+    {
+        int x = coord( rng );
+        int y = coord( rng );
+        int s = size( rng );
+
+        SHAPE_LINE_CHAIN outline( { VECTOR2I( x, y ), VECTOR2I( x + s, y ),
+                                    VECTOR2I( x + s, y + s ), VECTOR2I( x, y + s ) },
+                                  true );
+        shape.AddOutline( outline );
+
+        if( s > 50000 )
+        {
+            int h = s / 4;
+            SHAPE_LINE_CHAIN hole( { VECTOR2I( x + h, y + h ), VECTOR2I( x + h, y + 3 * h ),
+                                     VECTOR2I( x + 3 * h, y + 3 * h ),
+                                     VECTOR2I( x + 3 * h, y + h ) },
+                                   true );
+            shape.AddHole( hole );
+        }
+    }
+
+    return shapes;
+}
+
+
+static double area( const SHAPE_POLY_SET& aSet )
+{
+    double area = 0.0;
+
+    for( int ii = 0; ii < aSet.OutlineCount(); ii++ )
+    {
+        area += std::abs( aSet.COutline( ii ).Area() );
+
+        for( int jj = 0; jj < aSet.HoleCount( ii ); jj++ )
+            area -= std::abs( aSet.CHole( ii, jj ).Area() );
+    }
+
+    return area;
+}
+
+
+static void checkSameArea( const SHAPE_POLY_SET& aExpected, const SHAPE_POLY_SET& aActual )
+{
+    SHAPE_POLY_SET missing = aExpected;
+    missing.BooleanSubtract( aActual, SHAPE_POLY_SET::PM_FAST );
+
+    SHAPE_POLY_SET extra = aActual;
+    extra.BooleanSubtract( aExpected, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_CLOSE( area( aActual ), area( aExpected ), 1e-9 );
+    BOOST_CHECK_EQUAL( missing.OutlineCount(), 0 );
+    BOOST_CHECK_EQUAL( extra.OutlineCount(), 0 );
+}
+
+
+/**
+ * The batch union must cover the same area as BooleanAdd() applied in turn to every shape,
+ * whether it is merged in one pass or in parallel chunks.
+ */
+BOOST_AUTO_TEST_CASE( MatchesBooleanAdd )
+{
+    std::vector<SHAPE_POLY_SET> shapes = randomShapes( 1200 );
+    SHAPE_POLY_SET              expected;
+
+    for( const SHAPE_POLY_SET& shape : shapes )
+        expected.BooleanAdd( shape, SHAPE_POLY_SET::PM_FAST );
+
+    for( size_t threads : { 1, 3, 8 } )
+    {
+        BOOST_TEST_CONTEXT( threads << " threads" )
+        {
+            SHAPE_POLY_SET::UNION_BATCH batch;
+            SHAPE_POLY_SET              result;
+
+            for( const SHAPE_POLY_SET& shape : shapes )
+                batch.Add( shape );
+
+            batch.Execute( result, SHAPE_POLY_SET::PM_STRICTLY_SIMPLE, threads );
+
+            BOOST_CHECK( batch.Empty() );
+            checkSameArea( expected, result );
+        }
+    }
+}
+
+
+/**
+ * The result set may be one of the inputs, and outlines can be added on their own.
+ */
+BOOST_AUTO_TEST_CASE( ResultIsInput )
+{
+    std::vector<SHAPE_POLY_SET> shapes = randomShapes( 20 );
+    SHAPE_POLY_SET              expected = shapes[0];
+    SHAPE_POLY_SET              result = shapes[0];
+    SHAPE_POLY_SET::UNION_BATCH batch;
+
+    batch.Add( result );
+
+    for( size_t ii = 1; ii < shapes.size(); ii++ )
+    {
+        // Outlines are added without their holes
+        expected.BooleanAdd( SHAPE_POLY_SET( shapes[ii].COutline( 0 ) ), SHAPE_POLY_SET::PM_FAST );
+        batch.Add( shapes[ii].COutline( 0 ) );
+    }
+
+    batch.Execute( result, SHAPE_POLY_SET::PM_FAST );
+
+    BOOST_CHECK_CLOSE( area( result ), area( expected ), 1e-9 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
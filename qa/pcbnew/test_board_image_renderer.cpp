@@ -0,0 +1,104 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Tests for the offscreen board renderer: the same board must give the same pixels every time
+ * it is drawn, whichever renderer draws it.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <board.h>
+#include <board_image_renderer.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+
+#ifndef QA_PCBNEW_DEMO_BOARD
+    #define QA_PCBNEW_DEMO_BOARD "???"
+#endif
+
+
+struct BOARD_IMAGE_RENDERER_FIXTURE
+{
+    BOARD_IMAGE_RENDERER_FIXTURE() :
+            m_board( KI_TEST::ReadBoardFromFileOrStream( QA_PCBNEW_DEMO_BOARD ) )
+    {
+    }
+
+    ///< Copy of the pixels of the last image drawn by \a aRenderer
+    static std::vector<unsigned char> Pixels( const BOARD_IMAGE_RENDERER& aRenderer )
+    {
+        cairo_surface_t* surface = aRenderer.GetSurface();
+        unsigned char*   data = cairo_image_surface_get_data( surface );
+        int              stride = cairo_image_surface_get_stride( surface );
+
+        return std::vector<unsigned char>( data, data + stride * aRenderer.GetHeight() );
+    }
+
+    static const int IMAGE_SIZE = 256;
+
+    std::unique_ptr<BOARD> m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( BoardImageRenderer, BOARD_IMAGE_RENDERER_FIXTURE )
+
+
+/**
+ * Drawing the board again, with the same or with another renderer, gives the same image.
+ * The second renderer also checks that the first one let go of the board items.
+ */
+BOOST_AUTO_TEST_CASE( SamePixelsEachTime )
+{
+    BOOST_REQUIRE( m_board );
+
+    BOARD_IMAGE_RENDERER renderer( IMAGE_SIZE, IMAGE_SIZE );
+
+    BOOST_REQUIRE( renderer.Render( m_board.get() ) );
+    std::vector<unsigned char> first = Pixels( renderer );
+
+    // Something was drawn over the background
+    BOOST_CHECK( std::any_of( first.begin(), first.end(),
+                              [&]( unsigned char aByte )
+                              {
+                                  return aByte != first[0];
+                              } ) );
+
+    BOOST_REQUIRE( renderer.Render( m_board.get() ) );
+    std::vector<unsigned char> second = Pixels( renderer );
+
+    BOOST_CHECK( first == second );
+
+    BOARD_IMAGE_RENDERER other( IMAGE_SIZE, IMAGE_SIZE );
+
+    BOOST_REQUIRE( other.Render( m_board.get() ) );
+    std::vector<unsigned char> third = Pixels( other );
+
+    BOOST_CHECK( first == third );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
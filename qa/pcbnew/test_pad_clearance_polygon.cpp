@@ -0,0 +1,148 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Tests that the clearance polygons cached by PAD::TransformShapeWithClearanceToPolygon()
+ * follow changes to the pad.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <board.h>
+#include <board_design_settings.h>
+#include <convert_basic_shapes_to_polygon.h>
+#include <footprint.h>
+#include <pad.h>
+
+
+struct PAD_CLEARANCE_FIXTURE
+{
+    PAD_CLEARANCE_FIXTURE() :
+            m_board(),
+            m_footprint( &m_board )
+    {
+    }
+
+    PAD MakeSmd( PAD_SHAPE_T aShape, const wxSize& aSize )
+    {
+        PAD pad( &m_footprint );
+
+        pad.SetAttribute( PAD_ATTRIB_SMD );
+        pad.SetLayerSet( PAD::SMDMask() );
+        pad.SetShape( aShape );
+        pad.SetSize( aSize );
+
+        return pad;
+    }
+
+    static SHAPE_POLY_SET ClearancePoly( const PAD& aPad )
+    {
+        SHAPE_POLY_SET poly;
+
+        aPad.TransformShapeWithClearanceToPolygon( poly, F_Cu, 0, ARC_HIGH_DEF, ERROR_INSIDE );
+
+        return poly;
+    }
+
+    BOARD     m_board;
+    FOOTPRINT m_footprint;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( PadClearancePolygon, PAD_CLEARANCE_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( RepeatedCallsMatch )
+{
+    PAD pad = MakeSmd( PAD_SHAPE_RECT, wxSize( 1000000, 2000000 ) );
+
+    SHAPE_POLY_SET first = ClearancePoly( pad );
+    SHAPE_POLY_SET second = ClearancePoly( pad );
+
+    BOOST_CHECK_EQUAL( first.TotalVertices(), second.TotalVertices() );
+    BOOST_CHECK_EQUAL( first.Area(), second.Area() );
+}
+
+
+BOOST_AUTO_TEST_CASE( SetSizeInvalidates )
+{
+    PAD pad = MakeSmd( PAD_SHAPE_RECT, wxSize( 1000000, 1000000 ) );
+
+    BOOST_CHECK_EQUAL( ClearancePoly( pad ).BBox().GetWidth(), 1000000 );
+
+    pad.SetSize( wxSize( 2000000, 1000000 ) );
+
+    BOOST_CHECK_EQUAL( ClearancePoly( pad ).BBox().GetWidth(), 2000000 );
+}
+
+
+BOOST_AUTO_TEST_CASE( SetOrientationInvalidates )
+{
+    PAD pad = MakeSmd( PAD_SHAPE_RECT, wxSize( 2000000, 1000000 ) );
+
+    BOOST_CHECK_EQUAL( ClearancePoly( pad ).BBox().GetWidth(), 2000000 );
+
+    pad.SetOrientation( 900 );
+
+    BOOST_CHECK_EQUAL( ClearancePoly( pad ).BBox().GetWidth(), 1000000 );
+}
+
+
+BOOST_AUTO_TEST_CASE( SetChamferPositionsInvalidates )
+{
+    PAD pad = MakeSmd( PAD_SHAPE_CHAMFERED_RECT, wxSize( 1000000, 1000000 ) );
+
+    pad.SetChamferRectRatio( 0.25 );
+    pad.SetChamferPositions( RECT_CHAMFER_TOP_LEFT );
+
+    double oneChamfer = ClearancePoly( pad ).Area();
+
+    pad.SetChamferPositions( RECT_CHAMFER_ALL );
+
+    BOOST_CHECK_LT( ClearancePoly( pad ).Area(), oneChamfer );
+}
+
+
+/**
+ * Custom pads merge their primitives with the board's max error, not the one passed in.
+ */
+BOOST_AUTO_TEST_CASE( BoardMaxErrorInvalidatesCustomPads )
+{
+    PAD pad = MakeSmd( PAD_SHAPE_CUSTOM, wxSize( 500000, 500000 ) );
+
+    pad.SetAnchorPadShape( PAD_SHAPE_CIRCLE );
+    pad.AddPrimitiveCircle( wxPoint( 0, 0 ), 2000000, 0, true );
+
+    BOARD_DESIGN_SETTINGS& bds = m_board.GetDesignSettings();
+
+    bds.m_MaxError = ARC_HIGH_DEF;
+    int fine = ClearancePoly( pad ).TotalVertices();
+
+    bds.m_MaxError = ARC_HIGH_DEF * 50;
+    int coarse = ClearancePoly( pad ).TotalVertices();
+
+    BOOST_CHECK_LT( coarse, fine );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,159 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Tests that PNS::NODE branches, which share their data with their parent until either side
+ * is modified, stay isolated from each other.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <router/pns_joint.h>
+#include <router/pns_node.h>
+#include <router/pns_segment.h>
+
+#include <memory>
+#include <set>
+
+
+static const int TEST_NET = 1;
+static const int TEST_LAYER = 0;
+
+
+struct PNS_NODE_FIXTURE
+{
+    PNS_NODE_FIXTURE() :
+            m_root( new PNS::NODE )
+    {
+        m_root->Add( MakeSegment( { 0, 0 }, { 1000, 0 } ) );
+    }
+
+    ~PNS_NODE_FIXTURE()
+    {
+        m_root->KillChildren();
+        delete m_root;
+    }
+
+    static std::unique_ptr<PNS::SEGMENT> MakeSegment( const VECTOR2I& aA, const VECTOR2I& aB )
+    {
+        std::unique_ptr<PNS::SEGMENT> seg = std::make_unique<PNS::SEGMENT>( SEG( aA, aB ),
+                                                                            TEST_NET );
+        seg->SetLayer( TEST_LAYER );
+        seg->SetWidth( 100 );
+
+        return seg;
+    }
+
+    static std::set<PNS::ITEM*> Items( PNS::NODE* aNode )
+    {
+        std::set<PNS::ITEM*> items;
+        aNode->AllItemsInNet( TEST_NET, items );
+
+        return items;
+    }
+
+    static int LinkCount( PNS::NODE* aNode, const VECTOR2I& aPos )
+    {
+        PNS::JOINT* joint = aNode->FindJoint( aPos, TEST_LAYER, TEST_NET );
+
+        return joint ? joint->LinkCount() : 0;
+    }
+
+    PNS::NODE* m_root;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( PnsNode, PNS_NODE_FIXTURE )
+
+
+/**
+ * Writes to a branch must not show in its parent, which shares the branch data until then.
+ */
+BOOST_AUTO_TEST_CASE( ChildWritesStayInChild )
+{
+    PNS::NODE* parent = m_root->Branch();
+    parent->Add( MakeSegment( { 1000, 0 }, { 2000, 0 } ) );
+
+    PNS::NODE* child = parent->Branch();
+    child->Add( MakeSegment( { 2000, 0 }, { 3000, 0 } ) );
+
+    BOOST_CHECK_EQUAL( Items( parent ).size(), 2u );
+    BOOST_CHECK_EQUAL( Items( child ).size(), 3u );
+
+    BOOST_CHECK_EQUAL( LinkCount( parent, { 2000, 0 } ), 1 );
+    BOOST_CHECK_EQUAL( LinkCount( child, { 2000, 0 } ), 2 );
+}
+
+
+/**
+ * Removing items in a branch, both the parent's own items and the root's, must not affect the
+ * parent or the other branches of the same parent.
+ */
+BOOST_AUTO_TEST_CASE( RemovalsAreIsolated )
+{
+    PNS::NODE* parent = m_root->Branch();
+    parent->Add( MakeSegment( { 1000, 0 }, { 2000, 0 } ) );
+
+    std::set<PNS::ITEM*> parentItems = Items( parent );
+
+    PNS::NODE* child = parent->Branch();
+    PNS::NODE* sibling = parent->Branch();
+
+    for( PNS::ITEM* item : Items( child ) )
+        child->Remove( item );
+
+    BOOST_CHECK( Items( child ).empty() );
+    BOOST_CHECK( Items( parent ) == parentItems );
+    BOOST_CHECK( Items( sibling ) == parentItems );
+    BOOST_CHECK_EQUAL( LinkCount( parent, { 1000, 0 } ), 2 );
+    BOOST_CHECK_EQUAL( LinkCount( sibling, { 1000, 0 } ), 2 );
+
+    sibling->Add( MakeSegment( { 2000, 0 }, { 3000, 0 } ) );
+
+    BOOST_CHECK_EQUAL( Items( sibling ).size(), 3u );
+    BOOST_CHECK( Items( parent ) == parentItems );
+    BOOST_CHECK( Items( child ).empty() );
+}
+
+
+/**
+ * A parent may be modified again once its branches are gone.
+ */
+BOOST_AUTO_TEST_CASE( ParentWritesAfterKillingChildren )
+{
+    PNS::NODE* parent = m_root->Branch();
+    parent->Add( MakeSegment( { 1000, 0 }, { 2000, 0 } ) );
+
+    PNS::NODE* child = parent->Branch();
+    child->Add( MakeSegment( { 2000, 0 }, { 3000, 0 } ) );
+
+    parent->KillChildren();
+    parent->Add( MakeSegment( { 1000, 0 }, { 1000, 1000 } ) );
+
+    BOOST_CHECK_EQUAL( Items( parent ).size(), 3u );
+    BOOST_CHECK_EQUAL( LinkCount( parent, { 2000, 0 } ), 1 );
+    BOOST_CHECK_EQUAL( LinkCount( parent, { 1000, 0 } ), 3 );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,148 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Tests for the background triangulation of zone fills, in particular for zones deleted and
+ * restored by undo while their fills are being triangulated.
+ */
+
+#include <unit_test_utils/unit_test_utils.h>
+
+#include <board.h>
+#include <zone.h>
+#include <zone_fill_triangulation.h>
+
+#include <chrono>
+#include <thread>
+
+
+struct ZONE_FILL_TRIANGULATION_FIXTURE
+{
+    ZONE* AddFilledZone()
+    {
+        ZONE*          zone = new ZONE( &m_board );
+        SHAPE_POLY_SET fill;
+
+        fill.NewOutline();
+        fill.Append( 0, 0 );
+        fill.Append( 1000000, 0 );
+        fill.Append( 1000000, 1000000 );
+        fill.Append( 0, 1000000 );
+
+        zone->SetLayer( F_Cu );
+        zone->SetFilledPolysList( F_Cu, fill );
+        m_board.Add( zone );
+
+        return zone;
+    }
+
+    ///< Apply results as the panel does, until every fill was applied
+    static void RunToCompletion( ZONE_FILL_TRIANGULATION& aJob )
+    {
+        aJob.Start( []() {} );
+
+        for( int i = 0; i < 10000 && !aJob.IsFinished(); i++ )
+        {
+            aJob.ApplyFinished();
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+
+        BOOST_REQUIRE( aJob.IsFinished() );
+    }
+
+    BOARD m_board;
+};
+
+
+BOOST_FIXTURE_TEST_SUITE( ZoneFillTriangulation, ZONE_FILL_TRIANGULATION_FIXTURE )
+
+
+BOOST_AUTO_TEST_CASE( Completes )
+{
+    ZONE*                   zone = AddFilledZone();
+    ZONE_FILL_TRIANGULATION job( &m_board );
+
+    BOOST_REQUIRE( !job.Empty() );
+    BOOST_CHECK( job.IsPending( zone ) );
+
+    RunToCompletion( job );
+
+    BOOST_CHECK( !job.IsPending( zone ) );
+    BOOST_CHECK( zone->GetFilledPolysList( F_Cu ).IsTriangulationUpToDate() );
+}
+
+
+/**
+ * A zone deleted while being triangulated is kept alive by the undo list.  Once the job is
+ * done it must not be left pending, or it would be drawn as an outline after undo.
+ */
+BOOST_AUTO_TEST_CASE( DeleteThenUndoAfterCompletion )
+{
+    ZONE*                   zone = AddFilledZone();
+    ZONE_FILL_TRIANGULATION job( &m_board );
+
+    m_board.Remove( zone );
+
+    RunToCompletion( job );
+
+    // The deleted zone is not touched
+    BOOST_CHECK( !zone->GetFilledPolysList( F_Cu ).IsTriangulationUpToDate() );
+
+    m_board.Add( zone );
+
+    BOOST_CHECK( !job.IsPending( zone ) );
+}
+
+
+BOOST_AUTO_TEST_CASE( DeleteThenUndoBeforeCompletion )
+{
+    ZONE*                   zone = AddFilledZone();
+    ZONE_FILL_TRIANGULATION job( &m_board );
+
+    m_board.Remove( zone );
+    m_board.Add( zone );
+
+    RunToCompletion( job );
+
+    BOOST_CHECK( !job.IsPending( zone ) );
+    BOOST_CHECK( zone->GetFilledPolysList( F_Cu ).IsTriangulationUpToDate() );
+}
+
+
+BOOST_AUTO_TEST_CASE( CancelClearsPending )
+{
+    ZONE*                   zone = AddFilledZone();
+    ZONE_FILL_TRIANGULATION job( &m_board );
+
+    m_board.Remove( zone );
+
+    job.Start( []() {} );
+    job.Cancel();
+
+    BOOST_CHECK( !job.IsPending( zone ) );
+
+    m_board.Add( zone );
+}
+
+
+BOOST_AUTO_TEST_SUITE_END()
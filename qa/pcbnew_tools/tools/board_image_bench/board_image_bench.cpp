@@ -0,0 +1,176 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Renders boards to images offscreen (BOARD_IMAGE_RENDERER) and reports the throughput in
+ * images per second, e.g. to track the cost of generating board thumbnails.
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <board_image_renderer.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+#include <wx/filename.h>
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+
+using BENCH_DURATION = std::chrono::microseconds;
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_OPTION, "W", "width", _( "image width in pixels (default 512)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "H", "height", _( "image height in pixels (default 512)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "r", "repeats", _( "times each board is rendered (default 10)" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_OPTION, "o", "output", _( "directory to write the images to" ).mb_str(),
+            wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "board file" ).mb_str(), wxCMD_LINE_VAL_STRING,
+            wxCMD_LINE_PARAM_MULTIPLE },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum BOARD_IMAGE_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    SAVE_FAILED,
+};
+
+
+int board_image_bench_main( int argc, char* argv[] )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText( _( "This program renders boards to images without any window and "
+                               "reports how many images are rendered per second." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    long width = 512;
+    long height = 512;
+    long repeats = 10;
+    wxString outputDir;
+
+    cl_parser.Found( "width", &width );
+    cl_parser.Found( "height", &height );
+    cl_parser.Found( "repeats", &repeats );
+    cl_parser.Found( "output", &outputDir );
+
+    width = std::max( 16L, width );
+    height = std::max( 16L, height );
+    repeats = std::max( 1L, repeats );
+
+    std::vector<std::unique_ptr<BOARD>> boards;
+    std::vector<wxString>               names;
+    PROF_COUNTER                        loadTimer;
+
+    for( size_t i = 0; i < cl_parser.GetParamCount(); i++ )
+    {
+        const wxString filename = cl_parser.GetParam( i );
+
+        std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( filename.ToStdString() );
+
+        if( !brd )
+        {
+            std::cerr << "Could not load " << filename.ToStdString() << std::endl;
+            return BOARD_IMAGE_BENCH_RET_CODES::LOAD_FAILED;
+        }
+
+        boards.push_back( std::move( brd ) );
+        names.push_back( wxFileName( filename ).GetName() );
+    }
+
+    double loadMs = loadTimer.SinceStart<BENCH_DURATION>().count() / 1000.0;
+
+    BOARD_IMAGE_RENDERER renderer( (int) width, (int) height );
+    std::vector<double>  boardMs( boards.size(), 0.0 );
+    PROF_COUNTER         totalTimer;
+
+    for( long r = 0; r < repeats; r++ )
+    {
+        for( size_t i = 0; i < boards.size(); i++ )
+        {
+            PROF_COUNTER timer;
+            renderer.Render( boards[i].get() );
+            boardMs[i] += timer.SinceStart<BENCH_DURATION>().count() / 1000.0;
+        }
+    }
+
+    double totalMs = totalTimer.SinceStart<BENCH_DURATION>().count() / 1000.0;
+    size_t images = boards.size() * repeats;
+
+    std::cout << "Loaded " << boards.size() << " boards in " << loadMs << " ms" << std::endl;
+
+    for( size_t i = 0; i < boards.size(); i++ )
+    {
+        std::cout << "  " << names[i].ToStdString() << ": " << boardMs[i] / repeats
+                  << " ms/image" << std::endl;
+    }
+
+    std::cout << "Rendered " << images << " images of " << width << "x" << height << " in "
+              << totalMs << " ms: " << images * 1000.0 / totalMs << " images/s" << std::endl;
+
+    if( !outputDir.IsEmpty() )
+    {
+        for( size_t i = 0; i < boards.size(); i++ )
+        {
+            wxFileName fn( outputDir, names[i], wxT( "png" ) );
+
+            renderer.Render( boards[i].get() );
+
+            if( !renderer.SavePNG( fn.GetFullPath() ) )
+            {
+                std::cerr << "Could not write " << fn.GetFullPath().ToStdString() << std::endl;
+                return BOARD_IMAGE_BENCH_RET_CODES::SAVE_FAILED;
+            }
+        }
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "board_image_bench",
+        "Benchmark offscreen rendering of boards to images",
+        board_image_bench_main,
+} );
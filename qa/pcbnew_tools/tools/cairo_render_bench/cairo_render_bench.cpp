@@ -0,0 +1,193 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Renders a board offscreen with the Cairo GAL, drawing the view on a single thread and in
+ * parallel tiles (VIEW::SetTiledRendering()), and compares the frame times and the images.
+ * Finally prints the draw profile (VIEW_PROFILE) of a single threaded frame.
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <track.h>
+#include <zone.h>
+#include <pcb_draw_panel_gal.h>
+#include <pcb_painter.h>
+#include <pcb_view.h>
+#include <profile.h>
+#include <settings/color_settings.h>
+
+#include <gal/cairo/cairo_gal.h>
+#include <gal/gal_display_options.h>
+#include <view/view_profile.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+using BENCH_DURATION = std::chrono::microseconds;
+
+
+enum CAIRO_RENDER_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+/**
+ * Redraw the whole view aRepeats times and return the mean frame time in ms.
+ */
+static double renderFrames( KIGFX::VIEW& aView, KIGFX::GAL& aGal, int aRepeats )
+{
+    PROF_COUNTER timer;
+
+    for( int i = 0; i < aRepeats; i++ )
+    {
+        KIGFX::GAL_DRAWING_CONTEXT ctx( &aGal );
+
+        aView.MarkDirty();
+        aView.Redraw();
+    }
+
+    return timer.SinceStart<BENCH_DURATION>().count() / 1000.0 / aRepeats;
+}
+
+
+int cairo_render_bench_main( int argc, char* argv[] )
+{
+    if( argc < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <board file> [width] [height] [repeats]"
+                  << std::endl;
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+
+    if( !brd )
+        return CAIRO_RENDER_BENCH_RET_CODES::LOAD_FAILED;
+
+    int width = argc > 2 ? std::max( 16, atoi( argv[2] ) ) : 1920;
+    int height = argc > 3 ? std::max( 16, atoi( argv[3] ) ) : 1080;
+    int repeats = argc > 4 ? std::max( 1, atoi( argv[4] ) ) : 10;
+
+    cairo_surface_t* surface = cairo_image_surface_create( CAIRO_FORMAT_ARGB32, width, height );
+
+    KIGFX::GAL_DISPLAY_OPTIONS   options;
+    KIGFX::CAIRO_IMAGE_GAL       gal( options, surface );
+    KIGFX::PCB_PAINTER           painter( &gal );
+    KIGFX::PCB_VIEW              view( true );
+    COLOR_SETTINGS               colors;
+
+    colors.ResetToDefaults();
+    painter.GetSettings()->LoadColors( &colors );
+
+    view.SetGAL( &gal );
+    view.SetPainter( &painter );
+
+    // Cairo canvases draw everything in immediate mode
+    for( int layer = 0; layer < KIGFX::VIEW::VIEW_MAX_LAYERS; layer++ )
+        view.SetLayerTarget( layer, KIGFX::TARGET_NONCACHED );
+
+    std::vector<KIGFX::VIEW_ITEM*> items;
+
+    for( TRACK* track : brd->Tracks() )
+        items.push_back( track );
+
+    for( FOOTPRINT* footprint : brd->Footprints() )
+        items.push_back( footprint );
+
+    for( BOARD_ITEM* drawing : brd->Drawings() )
+        items.push_back( drawing );
+
+    for( ZONE* zone : brd->Zones() )
+        items.push_back( zone );
+
+    view.Add( items );
+    view.SetViewport( BOX2D( brd->GetBoundingBox().GetPosition(),
+                             brd->GetBoundingBox().GetSize() ) );
+    view.UpdateItems();
+
+    std::cout << "Rendering " << items.size() << " items at " << width << "x" << height
+              << ", " << repeats << " frames" << std::endl;
+
+    const int    stride = cairo_image_surface_get_stride( surface );
+    const size_t bytes = (size_t) stride * height;
+
+    view.SetTiledRendering( false );
+    double serialMs = renderFrames( view, gal, repeats );
+
+    cairo_surface_flush( surface );
+    std::vector<unsigned char> serialImage( cairo_image_surface_get_data( surface ),
+                                            cairo_image_surface_get_data( surface ) + bytes );
+
+    view.SetTiledRendering( true );
+    double tiledMs = renderFrames( view, gal, repeats );
+
+    cairo_surface_flush( surface );
+    const uint32_t* tiled =
+            reinterpret_cast<const uint32_t*>( cairo_image_surface_get_data( surface ) );
+    const uint32_t* serial = reinterpret_cast<const uint32_t*>( serialImage.data() );
+    int             differing = 0;
+
+    // Antialiasing along the tile edges may differ slightly from the single threaded image
+    for( int y = 0; y < height; y++ )
+    {
+        for( int x = 0; x < width; x++ )
+        {
+            if( tiled[y * stride / 4 + x] != serial[y * stride / 4 + x] )
+                differing++;
+        }
+    }
+
+    std::cout << "Serial: " << serialMs << " ms/frame" << std::endl;
+    std::cout << "Tiled:  " << tiledMs << " ms/frame (speedup " << serialMs / tiledMs << "x)"
+              << std::endl;
+    std::cout << "Differing pixels: " << differing << " of " << width * height << std::endl;
+
+    // Where the single threaded frame time goes
+    view.SetTiledRendering( false );
+    view.SetProfiling( true );
+    renderFrames( view, gal, 1 );
+
+    std::cout << view.GetProfile()->Format( PCB_DRAW_PANEL_GAL::DrawProfileLayerName ).ToStdString()
+              << std::endl;
+
+    view.Clear();
+    cairo_surface_destroy( surface );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "cairo_render_bench",
+        "Benchmark single threaded vs tiled offscreen Cairo rendering of a board",
+        cairo_render_bench_main,
+} );
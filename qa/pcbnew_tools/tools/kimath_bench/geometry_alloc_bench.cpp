@@ -0,0 +1,147 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * @file geometry_alloc_bench.cpp
+ *
+ * Counts the heap allocations made while converting simple shapes to polygons, the way the
+ * zone filler and the plotters do for every pad and track.
+ */
+
+#include "alloc_counter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <convert_basic_shapes_to_polygon.h>
+#include <geometry/shape_line_chain.h>
+#include <geometry/shape_poly_set.h>
+
+#include <qa_utils/utility_registry.h>
+
+
+struct ALLOC_BENCH
+{
+    std::string           name;
+    std::function<void()> func;
+};
+
+
+static void runBench( const ALLOC_BENCH& aBench, int aReps )
+{
+    using CLOCK = std::chrono::steady_clock;
+
+    size_t            startCount = GetAllocCount();
+    CLOCK::time_point start = CLOCK::now();
+
+    for( int i = 0; i < aReps; i++ )
+        aBench.func();
+
+    std::chrono::duration<double, std::micro> elapsed = CLOCK::now() - start;
+    size_t allocs = GetAllocCount() - startCount;
+
+    std::cout << std::left << std::setw( 32 ) << aBench.name << std::right << std::fixed
+              << std::setprecision( 2 ) << std::setw( 8 ) << (double) allocs / aReps
+              << " allocs/call " << std::setprecision( 3 ) << std::setw( 10 )
+              << elapsed.count() / aReps << " us/call" << std::endl;
+}
+
+
+int geometry_alloc_bench_main_func( int argc, char** argv )
+{
+    int reps = 10000;
+
+    if( argc > 1 )
+        reps = std::max( 1, std::atoi( argv[1] ) );
+
+    const int maxError = 5000;  // 5 microns, the default board max error
+
+    std::vector<ALLOC_BENCH> benches = {
+        { "circle to chain",
+          [&]()
+          {
+              SHAPE_LINE_CHAIN chain;
+              TransformCircleToPolygon( chain, wxPoint( 1000, 2000 ), 400000, maxError,
+                                        ERROR_INSIDE );
+          } },
+        { "circle to poly set",
+          [&]()
+          {
+              SHAPE_POLY_SET poly;
+              TransformCircleToPolygon( poly, wxPoint( 1000, 2000 ), 400000, maxError,
+                                        ERROR_INSIDE );
+          } },
+        { "oval to poly set",
+          [&]()
+          {
+              SHAPE_POLY_SET poly;
+              TransformOvalToPolygon( poly, wxPoint( 0, 0 ), wxPoint( 1000000, 300000 ),
+                                      250000, maxError, ERROR_INSIDE );
+          } },
+        { "rectangle outline added",
+          [&]()
+          {
+              SHAPE_POLY_SET   poly;
+              SHAPE_LINE_CHAIN rect;
+
+              rect.Reserve( 4 );
+              rect.Append( 0, 0 );
+              rect.Append( 1000, 0 );
+              rect.Append( 1000, 1000 );
+              rect.Append( 0, 1000 );
+              rect.SetClosed( true );
+
+              poly.AddOutline( rect );
+          } },
+        { "segment chain copied",
+          [&]()
+          {
+              SHAPE_LINE_CHAIN line;
+
+              line.Append( 0, 0 );
+              line.Append( 1000, 500 );
+
+              SHAPE_LINE_CHAIN copy( line );
+          } },
+    };
+
+    std::cout << reps << " repetitions" << std::endl;
+
+    for( const ALLOC_BENCH& bench : benches )
+        runBench( bench, reps );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "geometry_alloc",
+        "Count the heap allocations of basic shape to polygon conversions",
+        geometry_alloc_bench_main_func,
+} );
@@ -0,0 +1,544 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Measures the throughput and the heap allocations of the SHAPE_POLY_SET and collision
+ * operations the board editor relies on, using geometry taken from real boards: zone fills,
+ * custom pads and the board outline.
+ */
+
+#include "alloc_counter.h"
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <track.h>
+#include <zone.h>
+#include <profile.h>
+
+#include <geometry/shape.h>
+#include <geometry/shape_poly_set.h>
+#include <math/util.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+
+using BENCH_DURATION = std::chrono::microseconds;
+
+
+enum KIMATH_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+};
+
+
+/**
+ * The polygons of one kind taken from a board, e.g. all its zone fills.
+ */
+struct POLY_FIXTURE
+{
+    std::string                 name;
+    std::vector<SHAPE_POLY_SET> polys;
+};
+
+
+/**
+ * A zone outline and the clearance polygons of the pads and tracks it has to avoid.
+ */
+struct KNOCKOUT_FIXTURE
+{
+    SHAPE_POLY_SET outline;
+    SHAPE_POLY_SET items;
+};
+
+
+struct BENCH_FIXTURES
+{
+    std::vector<POLY_FIXTURE>           polys;
+    std::vector<KNOCKOUT_FIXTURE>       knockouts;
+    std::vector<std::shared_ptr<SHAPE>> shapes;
+};
+
+
+/**
+ * A benchmarked operation.  setup() prepares the inputs of one run and is not measured;
+ * run() returns the number of operations it performed.
+ */
+struct BENCH
+{
+    std::string             name;
+    std::function<void()>   setup;
+    std::function<size_t()> run;
+};
+
+
+static void collectFixtures( BOARD* aBoard, BENCH_FIXTURES& aFixtures )
+{
+    const int maxError = aBoard->GetDesignSettings().m_MaxError;
+    const int clearance = aBoard->GetDesignSettings().GetBiggestClearanceValue();
+
+    POLY_FIXTURE zoneFills{ "zone_fill", {} };
+    POLY_FIXTURE customPads{ "custom_pad", {} };
+    POLY_FIXTURE boardOutline{ "board_outline", {} };
+
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            if( !zone->HasFilledPolysForLayer( layer ) )
+                continue;
+
+            SHAPE_POLY_SET fill = zone->GetFilledPolysList( layer );
+
+            if( fill.OutlineCount() )
+                zoneFills.polys.push_back( fill );
+
+            if( !IsCopperLayer( layer ) )
+                continue;
+
+            KNOCKOUT_FIXTURE knockout;
+            knockout.outline = *zone->Outline();
+
+            for( FOOTPRINT* footprint : aBoard->Footprints() )
+            {
+                for( PAD* pad : footprint->Pads() )
+                {
+                    if( pad->IsOnLayer( layer ) && pad->GetNetCode() != zone->GetNetCode() )
+                    {
+                        pad->TransformShapeWithClearanceToPolygon( knockout.items, layer,
+                                                                   clearance, maxError,
+                                                                   ERROR_OUTSIDE );
+                    }
+                }
+            }
+
+            for( TRACK* track : aBoard->Tracks() )
+            {
+                if( track->IsOnLayer( layer ) && track->GetNetCode() != zone->GetNetCode() )
+                {
+                    track->TransformShapeWithClearanceToPolygon( knockout.items, layer, clearance,
+                                                                 maxError, ERROR_OUTSIDE );
+                }
+            }
+
+            aFixtures.knockouts.push_back( std::move( knockout ) );
+        }
+    }
+
+    for( FOOTPRINT* footprint : aBoard->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+        {
+            if( pad->GetShape() == PAD_SHAPE_CUSTOM )
+            {
+                SHAPE_POLY_SET padPoly;
+                pad->TransformShapeWithClearanceToPolygon( padPoly, UNDEFINED_LAYER, 0, maxError,
+                                                           ERROR_INSIDE );
+                customPads.polys.push_back( padPoly );
+            }
+
+            aFixtures.shapes.push_back( pad->GetEffectiveShape() );
+        }
+    }
+
+    for( TRACK* track : aBoard->Tracks() )
+        aFixtures.shapes.push_back( track->GetEffectiveShape() );
+
+    SHAPE_POLY_SET outline;
+
+    if( aBoard->GetBoardPolygonOutlines( outline ) && outline.OutlineCount() )
+        boardOutline.polys.push_back( outline );
+
+    for( POLY_FIXTURE* fixture : { &zoneFills, &customPads, &boardOutline } )
+    {
+        if( !fixture->polys.empty() )
+            aFixtures.polys.push_back( std::move( *fixture ) );
+    }
+
+    // Neighbouring shapes are compared with each other by the collision benchmark
+    std::sort( aFixtures.shapes.begin(), aFixtures.shapes.end(),
+               []( const std::shared_ptr<SHAPE>& a, const std::shared_ptr<SHAPE>& b )
+               {
+                   return a->BBox().GetX() < b->BBox().GetX();
+               } );
+}
+
+
+/**
+ * Test random points within the bounding box of each polygon set for containment.
+ *
+ * @return the number of queries made.
+ */
+static size_t containsQueries( const std::vector<SHAPE_POLY_SET>& aPolys )
+{
+    const int    pointsPerPoly = 1000;
+    std::mt19937 rng( 1 );
+    size_t       inside = 0;
+
+    for( const SHAPE_POLY_SET& poly : aPolys )
+    {
+        BOX2I                              bbox = poly.BBox();
+        std::uniform_int_distribution<int> x( bbox.GetLeft(), bbox.GetRight() );
+        std::uniform_int_distribution<int> y( bbox.GetTop(), bbox.GetBottom() );
+
+        for( int i = 0; i < pointsPerPoly; i++ )
+            inside += poly.Contains( VECTOR2I( x( rng ), y( rng ) ) );
+    }
+
+    // Keep the result alive
+    if( inside == SIZE_MAX )
+        std::cout << inside;
+
+    return aPolys.size() * pointsPerPoly;
+}
+
+
+static std::vector<BENCH> makeBenches( const BENCH_FIXTURES& aFixtures, int aClearance )
+{
+    std::vector<BENCH> benches;
+
+    // Scratch copies made by the setup functions and consumed by the runs
+    auto work = std::make_shared<std::vector<SHAPE_POLY_SET>>();
+
+    auto copyOf =
+            [work]( const std::vector<SHAPE_POLY_SET>& aPolys )
+            {
+                return [work, &aPolys]()
+                       {
+                           *work = aPolys;
+                       };
+            };
+
+    for( const POLY_FIXTURE& fixture : aFixtures.polys )
+    {
+        const std::vector<SHAPE_POLY_SET>& polys = fixture.polys;
+
+        benches.push_back( { "fracture/" + fixture.name,
+                             [work, &polys]()
+                             {
+                                 *work = polys;
+
+                                 for( SHAPE_POLY_SET& poly : *work )
+                                     poly.Unfracture( SHAPE_POLY_SET::PM_FAST );
+                             },
+                             [work]()
+                             {
+                                 for( SHAPE_POLY_SET& poly : *work )
+                                     poly.Fracture( SHAPE_POLY_SET::PM_FAST );
+
+                                 return work->size();
+                             } } );
+
+        benches.push_back( { "inflate/" + fixture.name, copyOf( polys ),
+                             [work, aClearance]()
+                             {
+                                 for( SHAPE_POLY_SET& poly : *work )
+                                     poly.Inflate( aClearance, 16 );
+
+                                 return work->size();
+                             } } );
+
+        benches.push_back( { "triangulate/" + fixture.name, copyOf( polys ),
+                             [work]()
+                             {
+                                 for( SHAPE_POLY_SET& poly : *work )
+                                     poly.CacheTriangulation();
+
+                                 return work->size();
+                             } } );
+
+        benches.push_back( { "contains/" + fixture.name, nullptr,
+                             [&polys]()
+                             {
+                                 return containsQueries( polys );
+                             } } );
+
+        benches.push_back( { "contains_indexed/" + fixture.name,
+                             [work, &polys]()
+                             {
+                                 *work = polys;
+
+                                 for( SHAPE_POLY_SET& poly : *work )
+                                     poly.BuildEdgeIndex();
+                             },
+                             [work]()
+                             {
+                                 return containsQueries( *work );
+                             } } );
+    }
+
+    if( !aFixtures.knockouts.empty() )
+    {
+        const std::vector<KNOCKOUT_FIXTURE>& knockouts = aFixtures.knockouts;
+
+        benches.push_back( { "boolean_add/zone_items", nullptr,
+                             [&knockouts]()
+                             {
+                                 for( const KNOCKOUT_FIXTURE& knockout : knockouts )
+                                 {
+                                     SHAPE_POLY_SET merged;
+                                     merged.BooleanAdd( knockout.items, SHAPE_POLY_SET::PM_FAST );
+                                 }
+
+                                 return knockouts.size();
+                             } } );
+
+        benches.push_back( { "boolean_subtract/zone_items", nullptr,
+                             [&knockouts]()
+                             {
+                                 for( const KNOCKOUT_FIXTURE& knockout : knockouts )
+                                 {
+                                     SHAPE_POLY_SET result = knockout.outline;
+                                     result.BooleanSubtract( knockout.items,
+                                                             SHAPE_POLY_SET::PM_FAST );
+                                 }
+
+                                 return knockouts.size();
+                             } } );
+    }
+
+    if( !aFixtures.shapes.empty() )
+    {
+        const std::vector<std::shared_ptr<SHAPE>>& shapes = aFixtures.shapes;
+
+        benches.push_back( { "collide/pads_tracks", nullptr,
+                             [&shapes, aClearance]()
+                             {
+                                 const size_t neighbours = 8;
+                                 size_t       pairs = 0;
+                                 size_t       hits = 0;
+
+                                 for( size_t i = 0; i < shapes.size(); i++ )
+                                 {
+                                     size_t last = std::min( shapes.size(), i + 1 + neighbours );
+
+                                     for( size_t j = i + 1; j < last; j++ )
+                                     {
+                                         int actual;
+                                         hits += shapes[i]->Collide( shapes[j].get(), aClearance,
+                                                                     &actual );
+                                         pairs++;
+                                     }
+                                 }
+
+                                 // Keep the result alive
+                                 if( hits == SIZE_MAX )
+                                     std::cout << hits;
+
+                                 return pairs;
+                             } } );
+    }
+
+    return benches;
+}
+
+
+static SHAPE_LINE_CHAIN makeCircle( const VECTOR2I& aCenter, int aRadius, int aSegments )
+{
+    SHAPE_LINE_CHAIN chain;
+
+    for( int ii = 0; ii < aSegments; ii++ )
+    {
+        double angle = 2.0 * M_PI * ii / aSegments;
+        chain.Append( aCenter.x + KiROUND( aRadius * cos( angle ) ),
+                      aCenter.y + KiROUND( aRadius * sin( angle ) ) );
+    }
+
+    chain.SetClosed( true );
+    return chain;
+}
+
+
+/**
+ * Whole-layer sized sets for the multithreaded SHAPE_POLY_SET::Inflate(), too slow for the
+ * unit tests: many separate pad-like polygons, and a plane with a grid of anti-pads.
+ */
+static std::vector<BENCH> makeSyntheticBenches()
+{
+    auto circles = std::make_shared<SHAPE_POLY_SET>();
+    auto plane = std::make_shared<SHAPE_POLY_SET>();
+
+    std::mt19937                       rng( 2468 );
+    std::uniform_int_distribution<int> coord( 0, 20000000 );
+    std::uniform_int_distribution<int> radius( 10000, 60000 );
+
+    for( int ii = 0; ii < 20000; ii++ )
+    {
+        VECTOR2I center( coord( rng ), coord( rng ) );
+        circles->AddOutline( makeCircle( center, radius( rng ), 32 ) );
+    }
+
+    const int pitch = 100000;
+    const int count = 80;
+
+    plane->AddOutline( SHAPE_LINE_CHAIN( { VECTOR2I( 0, 0 ), VECTOR2I( pitch * count, 0 ),
+                                           VECTOR2I( pitch * count, pitch * count ),
+                                           VECTOR2I( 0, pitch * count ) },
+                                         true ) );
+
+    for( int row = 0; row < count; row++ )
+    {
+        for( int col = 0; col < count; col++ )
+        {
+            VECTOR2I center( col * pitch + pitch / 2, row * pitch + pitch / 2 );
+            plane->AddHole( makeCircle( center, pitch / 3, 64 ) );
+        }
+    }
+
+    std::vector<BENCH> benches;
+    auto               work = std::make_shared<SHAPE_POLY_SET>();
+
+    for( const std::pair<const char*, std::shared_ptr<SHAPE_POLY_SET>>& input :
+         { std::make_pair( "circles", circles ), std::make_pair( "plane", plane ) } )
+    {
+        std::shared_ptr<SHAPE_POLY_SET> poly = input.second;
+
+        // 1 thread, then one per core
+        for( size_t threads : { 1, 0 } )
+        {
+            benches.push_back( { std::string( "inflate/synthetic_" ) + input.first
+                                         + ( threads ? "_1_thread" : "_all_threads" ),
+                                 [work, poly]()
+                                 {
+                                     *work = *poly;
+                                 },
+                                 [work, threads]()
+                                 {
+                                     work->Inflate( 10000, 32,
+                                                    SHAPE_POLY_SET::ROUND_ALL_CORNERS,
+                                                    threads );
+                                     return (size_t) 1;
+                                 } } );
+        }
+    }
+
+    return benches;
+}
+
+
+static void runBench( const BENCH& aBench, int aRepeats )
+{
+    double time = 0.0;
+    size_t ops = 0;
+    size_t allocs = 0;
+
+    for( int r = 0; r < aRepeats; r++ )
+    {
+        if( aBench.setup )
+            aBench.setup();
+
+        size_t       startAllocs = GetAllocCount();
+        PROF_COUNTER timer;
+
+        ops += aBench.run();
+
+        time += timer.SinceStart<BENCH_DURATION>().count();
+        allocs += GetAllocCount() - startAllocs;
+    }
+
+    if( !ops )
+        return;
+
+    std::cout << std::left << std::setw( 32 ) << aBench.name << std::right << std::fixed
+              << std::setprecision( 1 ) << std::setw( 10 ) << ops << " ops "
+              << std::setw( 12 ) << time / 1000.0 << " ms "
+              << std::setw( 14 ) << ( time > 0.0 ? ops * 1e6 / time : 0.0 ) << " ops/s "
+              << std::setw( 12 ) << (double) allocs / ops << " allocs/op" << std::endl;
+}
+
+
+int kimath_bench_main( int argc, char* argv[] )
+{
+    int                      repeats = 5;
+    bool                     synthetic = false;
+    std::vector<std::string> boards;
+
+    for( int i = 1; i < argc; i++ )
+    {
+        if( !strcmp( argv[i], "-r" ) && i + 1 < argc )
+            repeats = std::max( 1, atoi( argv[++i] ) );
+        else if( !strcmp( argv[i], "-s" ) )
+            synthetic = true;
+        else
+            boards.push_back( argv[i] );
+    }
+
+    if( boards.empty() && !synthetic )
+    {
+        std::cerr << "Usage: " << argv[0] << " [-r repeats] [-s] <board file>..." << std::endl;
+        std::cerr << "  -s also runs the benchmarks on large generated polygon sets"
+                  << std::endl;
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    if( synthetic )
+    {
+        std::cout << "Generated polygon sets, " << repeats << " repeats" << std::endl;
+
+        for( const BENCH& bench : makeSyntheticBenches() )
+            runBench( bench, repeats );
+    }
+
+    for( const std::string& filename : boards )
+    {
+        std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( filename );
+
+        if( !brd )
+            return KIMATH_BENCH_RET_CODES::LOAD_FAILED;
+
+        BENCH_FIXTURES fixtures;
+        collectFixtures( brd.get(), fixtures );
+
+        int clearance = brd->GetDesignSettings().GetBiggestClearanceValue();
+
+        std::cout << "Board: " << filename << ", " << repeats << " repeats" << std::endl;
+
+        for( const BENCH& bench : makeBenches( fixtures, clearance ) )
+            runBench( bench, repeats );
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "kimath_bench",
+        "Measure the throughput and allocations of geometry operations on PCBs",
+        kimath_bench_main,
+} );
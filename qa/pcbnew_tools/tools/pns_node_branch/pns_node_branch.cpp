@@ -0,0 +1,222 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Micro-benchmarks for PNS::NODE branching: branch creation along deep chains, the cost of
+ * the first modification of a branch and joint/collision lookups at depth.
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <track.h>
+#include <profile.h>
+
+#include <router/pns_debug_decorator.h>
+#include <router/pns_kicad_iface.h>
+#include <router/pns_node.h>
+#include <router/pns_router.h>
+#include <router/pns_segment.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+using BENCH_DURATION = std::chrono::microseconds;
+
+
+enum PNS_NODE_BRANCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    NO_TRACKS,
+};
+
+
+static void report( const std::string& aName, int aOps, const BENCH_DURATION& aDuration )
+{
+    double us = aDuration.count();
+
+    std::cout << aName << ": " << aOps << " ops, " << us / 1000.0 << " ms";
+
+    if( aOps > 0 )
+        std::cout << " (" << us / aOps << " us/op)";
+
+    std::cout << std::endl;
+}
+
+
+/**
+ * Build a chain of aDepth branches, optionally moving one segment in each branch so that
+ * every level carries a private change (as shove does).
+ */
+static PNS::NODE* buildChain( PNS::NODE* aWorld, const std::vector<PNS::SEGMENT*>& aSegs,
+                              int aDepth, bool aModify )
+{
+    PNS::NODE* node = aWorld;
+
+    for( int i = 0; i < aDepth; i++ )
+    {
+        node = node->Branch();
+
+        if( aModify && i < (int) aSegs.size() )
+        {
+            PNS::SEGMENT*                 seg = aSegs[i];
+            std::unique_ptr<PNS::SEGMENT> moved = PNS::Clone( *seg );
+            const SEG                     s = seg->Seg();
+
+            moved->SetEnds( s.A + VECTOR2I( 0, 10 ), s.B + VECTOR2I( 0, 10 ) );
+
+            node->Remove( seg );
+            node->Add( std::move( moved ) );
+        }
+    }
+
+    return node;
+}
+
+
+int pns_node_branch_main( int argc, char* argv[] )
+{
+    if( argc < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <board file> [depth] [repeats]" << std::endl;
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+
+    if( !brd )
+        return PNS_NODE_BRANCH_RET_CODES::LOAD_FAILED;
+
+    int depth = argc > 2 ? std::max( 1, atoi( argv[2] ) ) : 64;
+    int repeats = argc > 3 ? std::max( 1, atoi( argv[3] ) ) : 100;
+
+    PNS::ROUTER          router;
+    PNS_KICAD_IFACE_BASE iface;
+    PNS::DEBUG_DECORATOR decorator;
+
+    iface.SetBoard( brd.get() );
+    iface.SetDebugDecorator( &decorator );
+    router.SetInterface( &iface );
+    router.SyncWorld();
+
+    PNS::NODE* world = router.GetWorld();
+    std::vector<PNS::SEGMENT*> segs;
+
+    for( TRACK* track : brd->Tracks() )
+    {
+        if( track->Type() != PCB_TRACE_T )
+            continue;
+
+        if( PNS::ITEM* item = world->FindItemByParent( track ) )
+            segs.push_back( static_cast<PNS::SEGMENT*>( item ) );
+    }
+
+    if( segs.empty() )
+    {
+        std::cerr << "Board has no tracks to branch." << std::endl;
+        return PNS_NODE_BRANCH_RET_CODES::NO_TRACKS;
+    }
+
+    std::cout << "Board: " << argv[1] << ", " << segs.size() << " segments, " << depth
+              << " levels, " << repeats << " repeats" << std::endl;
+
+    // Branch creation alone, no modifications at any level
+    {
+        PROF_COUNTER timer;
+
+        for( int r = 0; r < repeats; r++ )
+        {
+            buildChain( world, segs, depth, false );
+            world->KillChildren();
+        }
+
+        report( "branch (unmodified chain)", repeats * depth,
+                timer.SinceStart<BENCH_DURATION>() );
+    }
+
+    // Branch creation plus one remove/add per level
+    {
+        PROF_COUNTER timer;
+
+        for( int r = 0; r < repeats; r++ )
+        {
+            buildChain( world, segs, depth, true );
+            world->KillChildren();
+        }
+
+        report( "branch + modify (shove-like chain)", repeats * depth,
+                timer.SinceStart<BENCH_DURATION>() );
+    }
+
+    // Lookups on the deepest node of a modified chain
+    PNS::NODE* deepest = buildChain( world, segs, depth, true );
+
+    {
+        PROF_COUNTER timer;
+        int          found = 0;
+
+        for( int r = 0; r < repeats; r++ )
+        {
+            for( PNS::SEGMENT* seg : segs )
+            {
+                if( deepest->FindJoint( seg->Seg().A, seg ) )
+                    found++;
+            }
+        }
+
+        report( "FindJoint at depth", repeats * (int) segs.size(),
+                timer.SinceStart<BENCH_DURATION>() );
+        (void) found;
+    }
+
+    {
+        PROF_COUNTER timer;
+        int          ops = 0;
+
+        for( int r = 0; r < std::max( 1, repeats / 10 ); r++ )
+        {
+            for( PNS::SEGMENT* seg : segs )
+            {
+                PNS::NODE::OBSTACLES obstacles;
+                deepest->QueryColliding( seg, obstacles );
+                ops++;
+            }
+        }
+
+        report( "QueryColliding at depth", ops, timer.SinceStart<BENCH_DURATION>() );
+    }
+
+    world->KillChildren();
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "pns_node_branch",
+        "Benchmark PNS::NODE branching and lookups on a PCB",
+        pns_node_branch_main,
+} );
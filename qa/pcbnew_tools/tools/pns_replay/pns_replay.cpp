@@ -0,0 +1,516 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Headless replay of PNS router event logs.
+ *
+ * Loads a board together with an event log written by PNS::LOGGER::Save() (in pcbnew, the
+ * router's debug "save log" key writes /tmp/pns.log and /tmp/pns.dump), drives a PNS::ROUTER
+ * through the events without any view and reports per-event latency and the resulting
+ * routed topology.
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <common.h>
+#include <profile.h>
+
+#include <wx/cmdline.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <track.h>
+
+#include <router/pns_arc.h>
+#include <router/pns_debug_decorator.h>
+#include <router/pns_kicad_iface.h>
+#include <router/pns_logger.h>
+#include <router/pns_node.h>
+#include <router/pns_router.h>
+#include <router/pns_routing_settings.h>
+#include <router/pns_segment.h>
+#include <router/pns_sizes_settings.h>
+
+#include <algorithm>
+#include <iostream>
+#include <map>
+#include <set>
+
+
+using REPLAY_DURATION = std::chrono::microseconds;
+
+
+static const wxCmdLineEntryDesc g_cmdLineDesc[] = {
+    { wxCMD_LINE_SWITCH, "h", "help", _( "displays help on the command line parameters" ).mb_str(),
+            wxCMD_LINE_VAL_NONE, wxCMD_LINE_OPTION_HELP },
+    { wxCMD_LINE_SWITCH, "v", "verbose", _( "print the latency of every event" ).mb_str() },
+    { wxCMD_LINE_SWITCH, "n", "nets", _( "print the routed topology of every net" ).mb_str() },
+    { wxCMD_LINE_OPTION, "i", "iterations", _( "router iteration limit" ).mb_str(),
+            wxCMD_LINE_VAL_NUMBER },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "board file" ).mb_str(), wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_PARAM, nullptr, nullptr, _( "event log" ).mb_str(), wxCMD_LINE_VAL_STRING },
+    { wxCMD_LINE_NONE }
+};
+
+
+enum PNS_REPLAY_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    LOG_LOAD_FAILED,
+};
+
+
+static const char* eventName( PNS::LOGGER::EVENT_TYPE aType )
+{
+    switch( aType )
+    {
+    case PNS::LOGGER::EVT_START_ROUTE: return "start-route";
+    case PNS::LOGGER::EVT_START_DRAG:  return "start-drag";
+    case PNS::LOGGER::EVT_FIX:         return "fix";
+    case PNS::LOGGER::EVT_MOVE:        return "move";
+    case PNS::LOGGER::EVT_ABORT:       return "abort";
+    default:                           return "unknown";
+    }
+}
+
+
+/**
+ * Latency statistics for one event type.
+ */
+struct EVENT_STATS
+{
+    int    count = 0;
+    double total = 0.0;
+    double max = 0.0;
+};
+
+
+/**
+ * Router interface of the replay.  Commits leave the board untouched, but the items they add
+ * and remove are tracked so that later events can still refer to them by UUID.
+ */
+class PNS_REPLAY_IFACE : public PNS_KICAD_IFACE_BASE
+{
+public:
+    void AddItem( PNS::ITEM* aItem ) override
+    {
+        m_added.push_back( aItem );
+    }
+
+    void RemoveItem( PNS::ITEM* aItem ) override
+    {
+        auto it = m_uuids.find( aItem );
+
+        if( it != m_uuids.end() )
+        {
+            m_items.erase( it->second );
+            m_uuids.erase( it );
+        }
+    }
+
+    ///< Make \a aItem the item referred to by \a aUuid
+    void MapItem( const KIID& aUuid, PNS::ITEM* aItem )
+    {
+        if( aUuid == niluuid || !aItem )
+            return;
+
+        // Drop the item previously mapped to the UUID, and the UUID previously mapped to the item
+        PNS::ITEM* previous = FindItem( aUuid );
+
+        if( previous )
+            m_uuids.erase( previous );
+
+        RemoveItem( aItem );
+
+        m_items[aUuid] = aItem;
+        m_uuids[aItem] = aUuid;
+    }
+
+    /**
+     * Map the items added since the last call to the UUIDs logged for them, which were
+     * committed in the same order.
+     */
+    void MapAddedItems( const std::vector<KIID>& aUuids )
+    {
+        for( size_t i = 0; i < std::min( aUuids.size(), m_added.size() ); i++ )
+            MapItem( aUuids[i], m_added[i] );
+
+        m_added.clear();
+    }
+
+    PNS::ITEM* FindItem( const KIID& aUuid ) const
+    {
+        auto it = m_items.find( aUuid );
+
+        return it != m_items.end() ? it->second : nullptr;
+    }
+
+private:
+    std::vector<PNS::ITEM*>          m_added;   ///< items committed since MapAddedItems()
+    std::map<KIID, PNS::ITEM*>       m_items;
+    std::map<const PNS::ITEM*, KIID> m_uuids;
+};
+
+
+/**
+ * Drives a headless router through a logged event sequence.
+ */
+class PNS_REPLAY
+{
+public:
+    PNS_REPLAY( BOARD* aBoard, int aIterLimit ) :
+            m_board( aBoard ),
+            m_settings( nullptr, "" ),
+            m_unresolved( 0 ),
+            m_item( nullptr )
+    {
+        m_iface.SetBoard( m_board );
+        m_iface.SetDebugDecorator( &m_decorator );
+
+        m_router.SetInterface( &m_iface );
+        m_router.ClearWorld();
+        m_router.SyncWorld();
+        m_router.LoadSettings( &m_settings );
+
+        if( aIterLimit > 0 )
+            m_router.SetIterLimit( aIterLimit );
+
+        // Events refer to the routable items by the UUIDs of their parents
+        for( TRACK* track : m_board->Tracks() )
+            m_iface.MapItem( track->m_Uuid, World()->FindItemByParent( track ) );
+
+        for( FOOTPRINT* footprint : m_board->Footprints() )
+        {
+            for( PAD* pad : footprint->Pads() )
+                m_iface.MapItem( pad->m_Uuid, World()->FindItemByParent( pad ) );
+        }
+    }
+
+    /**
+     * Look up the items \a aEvent refers to.  Kept apart from Run() so that the lookups are
+     * not timed with the event.
+     */
+    void Resolve( const PNS::LOGGER::EVENT_ENTRY& aEvent )
+    {
+        m_item = findItem( aEvent.uuid );
+        m_startItems.Clear();
+
+        for( const KIID& uuid : aEvent.startItems )
+        {
+            if( PNS::ITEM* startItem = findItem( uuid ) )
+                m_startItems.Add( startItem );
+        }
+    }
+
+    /**
+     * Replay a single event, with the items found by the last Resolve().
+     *
+     * @return false if the router rejected the event (failed to start routing or dragging).
+     */
+    bool Run( const PNS::LOGGER::EVENT_ENTRY& aEvent )
+    {
+        PNS::ITEM* item = m_item;
+
+        switch( aEvent.type )
+        {
+        case PNS::LOGGER::EVT_START_ROUTE:
+        {
+            if( m_router.RoutingInProgress() )
+                m_router.StopRouting();
+
+            restoreState( aEvent );
+
+            // Logs without the router state only know the start item
+            int layer = aEvent.layer;
+
+            if( layer < 0 )
+                layer = item ? item->Layers().Start() : F_Cu;
+
+            PNS::SIZES_SETTINGS sizes;
+            m_iface.ImportSizes( sizes, item, -1 );
+            m_router.UpdateSizes( sizes );
+
+            return m_router.StartRouting( aEvent.p, item, layer );
+        }
+
+        case PNS::LOGGER::EVT_START_DRAG:
+        {
+            if( m_router.RoutingInProgress() )
+                m_router.StopRouting();
+
+            restoreState( aEvent );
+
+            PNS::ITEM_SET startItems = m_startItems;
+
+            if( aEvent.startItems.empty() && item )
+                startItems.Add( item );
+
+            if( startItems.Empty() )
+                return false;
+
+            int dragMode = aEvent.dragMode >= 0 ? aEvent.dragMode : PNS::DM_ANY;
+
+            return m_router.StartDragging( aEvent.p, startItems, dragMode );
+        }
+
+        case PNS::LOGGER::EVT_MOVE:
+            if( m_router.RoutingInProgress() )
+                m_router.Move( aEvent.p, item );
+
+            break;
+
+        case PNS::LOGGER::EVT_FIX:
+            // Mirrors ROUTER_TOOL: a completed fix ends the routing/dragging session
+            if( m_router.RoutingInProgress() && m_router.FixRoute( aEvent.p, item ) )
+                m_router.StopRouting();
+
+            break;
+
+        case PNS::LOGGER::EVT_ABORT:
+            m_router.StopRouting();
+            break;
+        }
+
+        return true;
+    }
+
+    ///< Let later events refer to the items committed by the last Run()
+    void MapCommitted( const PNS::LOGGER::EVENT_ENTRY& aEvent )
+    {
+        m_iface.MapAddedItems( aEvent.addedItems );
+    }
+
+    void Finish()
+    {
+        if( m_router.RoutingInProgress() )
+            m_router.StopRouting();
+    }
+
+    PNS::NODE* World() const { return m_router.GetWorld(); }
+
+    int Unresolved() const { return m_unresolved; }
+
+private:
+    /**
+     * Restore the router mode and routing settings logged with a route or drag start.
+     */
+    void restoreState( const PNS::LOGGER::EVENT_ENTRY& aEvent )
+    {
+        PNS::LOGGER::ApplySettings( aEvent.settings, m_settings );
+
+        if( aEvent.routerMode >= 0 )
+            m_router.SetMode( static_cast<PNS::ROUTER_MODE>( aEvent.routerMode ) );
+        else
+            m_router.SetMode( PNS::PNS_MODE_ROUTE_SINGLE );
+    }
+
+    PNS::ITEM* findItem( const KIID& aUuid )
+    {
+        if( aUuid == niluuid )
+            return nullptr;
+
+        PNS::ITEM* item = m_iface.FindItem( aUuid );
+
+        if( !item )
+            m_unresolved++;
+
+        return item;
+    }
+
+    BOARD*                m_board;
+    PNS_REPLAY_IFACE      m_iface;
+    PNS::DEBUG_DECORATOR  m_decorator;
+    PNS::ROUTING_SETTINGS m_settings;
+    int                   m_unresolved;
+    PNS::ITEM*            m_item;       ///< item of the event being replayed
+    PNS::ITEM_SET         m_startItems; ///< start items of the event being replayed
+    PNS::ROUTER           m_router;     ///< declared last: uses the members above until destroyed
+};
+
+
+/**
+ * Print the routed topology held by the router's world node: item counts and routed length,
+ * in total and (optionally) per net.
+ */
+static void reportTopology( BOARD* aBoard, PNS::NODE* aWorld, bool aPerNet )
+{
+    int    segments = 0, arcs = 0, vias = 0;
+    double length = 0.0;
+
+    for( unsigned net = 1; net < aBoard->GetNetCount(); net++ )
+    {
+        std::set<PNS::ITEM*> items;
+        int                  netSegments = 0, netArcs = 0, netVias = 0;
+        double               netLength = 0.0;
+
+        aWorld->AllItemsInNet( net, items );
+
+        for( PNS::ITEM* item : items )
+        {
+            switch( item->Kind() )
+            {
+            case PNS::ITEM::SEGMENT_T:
+                netSegments++;
+                netLength += static_cast<PNS::SEGMENT*>( item )->Seg().Length();
+                break;
+
+            case PNS::ITEM::ARC_T:
+                netArcs++;
+                netLength += static_cast<PNS::ARC*>( item )->CLine().Length();
+                break;
+
+            case PNS::ITEM::VIA_T:
+                netVias++;
+                break;
+
+            default:
+                break;
+            }
+        }
+
+        if( aPerNet && ( netSegments || netArcs || netVias ) )
+        {
+            std::cout << "  net " << net << ": " << netSegments << " segments, " << netArcs
+                      << " arcs, " << netVias << " vias, length " << netLength << std::endl;
+        }
+
+        segments += netSegments;
+        arcs += netArcs;
+        vias += netVias;
+        length += netLength;
+    }
+
+    std::cout << "Topology: " << segments << " segments, " << arcs << " arcs, " << vias
+              << " vias, " << aWorld->JointCount() << " joints, routed length " << length
+              << std::endl;
+}
+
+
+int pns_replay_main_func( int argc, char** argv )
+{
+    wxMessageOutput::Set( new wxMessageOutputStderr );
+    wxCmdLineParser cl_parser( argc, argv );
+    cl_parser.SetDesc( g_cmdLineDesc );
+    cl_parser.AddUsageText(
+            _( "This program replays a PNS router event log against a board without a GUI, "
+               "reporting the latency of each event and the resulting topology. It can be used "
+               "to catch router performance regressions." ) );
+
+    int cmd_parsed_ok = cl_parser.Parse();
+
+    if( cmd_parsed_ok != 0 )
+    {
+        // Help and invalid input both stop here
+        return ( cmd_parsed_ok == -1 ) ? KI_TEST::RET_CODES::OK : KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    const bool verbose = cl_parser.Found( "verbose" );
+    const bool perNet = cl_parser.Found( "nets" );
+    long       iterLimit = 0;
+
+    cl_parser.Found( "iterations", &iterLimit );
+
+    const std::string boardFile = cl_parser.GetParam( 0 ).ToStdString();
+    const std::string logFile = cl_parser.GetParam( 1 ).ToStdString();
+
+    std::unique_ptr<BOARD> board = KI_TEST::ReadBoardFromFileOrStream( boardFile );
+
+    if( !board )
+        return PNS_REPLAY_RET_CODES::LOAD_FAILED;
+
+    PNS::LOGGER log;
+
+    if( !log.Load( logFile ) )
+    {
+        std::cerr << "Failed to load event log " << logFile << std::endl;
+        return PNS_REPLAY_RET_CODES::LOG_LOAD_FAILED;
+    }
+
+    PROF_COUNTER syncTimer;
+    PNS_REPLAY   replay( board.get(), (int) iterLimit );
+
+    std::cout << "World sync: " << syncTimer.SinceStart<REPLAY_DURATION>().count() << " us"
+              << std::endl;
+
+    EVENT_STATS stats[PNS::LOGGER::EVT_ABORT + 1];
+    int         rejected = 0;
+    int         index = 0;
+
+    for( const PNS::LOGGER::EVENT_ENTRY& evt : log.GetEvents() )
+    {
+        replay.Resolve( evt );
+
+        PROF_COUNTER timer;
+        bool         ok = replay.Run( evt );
+        double       us = timer.SinceStart<REPLAY_DURATION>().count();
+
+        replay.MapCommitted( evt );
+
+        EVENT_STATS& s = stats[evt.type];
+        s.count++;
+        s.total += us;
+        s.max = std::max( s.max, us );
+
+        if( !ok )
+            rejected++;
+
+        if( verbose )
+        {
+            std::cout << index << " " << eventName( evt.type ) << " (" << evt.p.x << ", "
+                      << evt.p.y << "): " << us << " us" << ( ok ? "" : " [rejected]" )
+                      << std::endl;
+        }
+
+        index++;
+    }
+
+    replay.Finish();
+
+    std::cout << "Replayed " << index << " events (" << rejected << " rejected, "
+              << replay.Unresolved() << " unresolved item references)" << std::endl;
+
+    for( int type = PNS::LOGGER::EVT_START_ROUTE; type <= PNS::LOGGER::EVT_ABORT; type++ )
+    {
+        const EVENT_STATS& s = stats[type];
+
+        if( !s.count )
+            continue;
+
+        std::cout << "  " << eventName( static_cast<PNS::LOGGER::EVENT_TYPE>( type ) ) << ": "
+                  << s.count << " events, total " << s.total << " us, mean "
+                  << s.total / s.count << " us, max " << s.max << " us" << std::endl;
+    }
+
+    reportTopology( board.get(), replay.World(), perNet );
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "pns_replay",
+        "Replay a PNS router event log against a board",
+        pns_replay_main_func,
+} );
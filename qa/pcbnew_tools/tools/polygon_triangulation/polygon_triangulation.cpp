@@ -33,11 +33,15 @@
 
 #include <board.h>
 #include <profile.h>
+#include <zone.h>
 
+#include <algorithm>
 #include <atomic>
+#include <iostream>
 #include <thread>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 
 void unfracture( SHAPE_POLY_SET::POLYGON* aPoly, SHAPE_POLY_SET::POLYGON* aResult )
@@ -203,6 +207,64 @@ enum POLY_TRI_RET_CODES
 };
 
 
+/**
+ * Triangulate the zone fills one after the other, with the parallelism inside
+ * SHAPE_POLY_SET::CacheTriangulation() limited to 1, 2, 4, ... threads, and report the time
+ * taken by each thread count.
+ */
+static void reportScaling( BOARD* aBoard )
+{
+    std::vector<SHAPE_POLY_SET> fills;
+    int                         vertices = 0;
+
+    for( ZONE* zone : aBoard->Zones() )
+    {
+        for( PCB_LAYER_ID layer : zone->GetLayerSet().Seq() )
+        {
+            // Append() copies the outlines only, so the copies have no triangulation yet
+            fills.emplace_back();
+            fills.back().Append( zone->GetFilledPolysList( layer ) );
+            vertices += fills.back().TotalVertices();
+        }
+    }
+
+    std::cout << "Scaling: " << fills.size() << " fills, " << vertices << " vertices"
+              << std::endl;
+
+    const size_t maxThreads = std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+    double       singleThreadTime = 0.0;
+
+    for( size_t threads = 1; ; threads = std::min( threads * 2, maxThreads ) )
+    {
+        std::vector<SHAPE_POLY_SET> work;
+
+        for( const SHAPE_POLY_SET& fill : fills )
+        {
+            work.emplace_back();
+            work.back().Append( fill );
+        }
+
+        PROF_COUNTER timer( "triangulate" );
+
+        for( SHAPE_POLY_SET& fill : work )
+            fill.CacheTriangulation( true, threads );
+
+        timer.Stop();
+
+        double ms = timer.msecs();
+
+        if( threads == 1 )
+            singleThreadTime = ms;
+
+        std::cout << "  " << threads << " thread(s): " << ms << " ms, speedup "
+                  << ( ms > 0.0 ? singleThreadTime / ms : 0.0 ) << std::endl;
+
+        if( threads == maxThreads )
+            break;
+    }
+}
+
+
 int polygon_triangulation_main( int argc, char *argv[] )
 {
     std::string filename;
@@ -269,6 +331,8 @@ int polygon_triangulation_main( int argc, char *argv[] )
 
     cnt.Show();
 
+    reportScaling( brd.get() );
+
     return KI_TEST::RET_CODES::OK;
 }
 
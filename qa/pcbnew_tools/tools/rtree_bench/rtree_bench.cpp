@@ -0,0 +1,245 @@
+/*
+ * This program source code file is part of KiCad, a free EDA CAD application.
+ *
+ * Copyright (C) 2021 KiCad Developers, see AUTHORS.txt for contributors.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, you may find one here:
+ * http://www.gnu.org/licenses/old-licenses/gpl-2.0.html
+ * or you may search the http://www.gnu.org website for the version 2 license,
+ * or you may write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301, USA
+ */
+
+/**
+ * Compares the query throughput of the dynamic RTree with PACKED_RTREE, which DRC_RTREE is
+ * built on, using the per-layer subshape boxes DRC indexes for a real board and one clearance
+ * query per indexed box.
+ */
+
+#include <pcbnew_utils/board_file_utils.h>
+
+#include <qa_utils/utility_registry.h>
+
+#include <board.h>
+#include <footprint.h>
+#include <pad.h>
+#include <track.h>
+#include <zone.h>
+#include <profile.h>
+
+#include <geometry/packed_rtree.h>
+#include <geometry/rtree.h>
+#include <geometry/shape.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+
+using BENCH_DURATION = std::chrono::microseconds;
+
+
+enum RTREE_BENCH_RET_CODES
+{
+    LOAD_FAILED = KI_TEST::RET_CODES::TOOL_SPECIFIC,
+    RESULTS_DIFFER,
+};
+
+
+struct INDEXED_BOX
+{
+    int         min[2];
+    int         max[2];
+    BOARD_ITEM* item;
+};
+
+
+/**
+ * Collect the boxes DRC_RTREE would insert for aItem on every layer of aItem.
+ */
+static void collectBoxes( BOARD_ITEM* aItem, std::vector<INDEXED_BOX>* aLayers )
+{
+    std::vector<SHAPE*> subshapes;
+
+    for( PCB_LAYER_ID layer : aItem->GetLayerSet().Seq() )
+    {
+        std::shared_ptr<SHAPE> shape = aItem->GetEffectiveShape( layer );
+        subshapes.clear();
+
+        if( shape->HasIndexableSubshapes() )
+            shape->GetIndexableSubshapes( subshapes );
+        else
+            subshapes.push_back( shape.get() );
+
+        for( SHAPE* subshape : subshapes )
+        {
+            BOX2I bbox = subshape->BBox();
+
+            aLayers[layer].push_back( { { bbox.GetX(), bbox.GetY() },
+                                        { bbox.GetRight(), bbox.GetBottom() },
+                                        aItem } );
+        }
+    }
+}
+
+
+int rtree_bench_main( int argc, char* argv[] )
+{
+    if( argc < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " <board file> [clearance (nm)] [repeats]"
+                  << std::endl;
+        return KI_TEST::RET_CODES::BAD_CMDLINE;
+    }
+
+    std::unique_ptr<BOARD> brd = KI_TEST::ReadBoardFromFileOrStream( argv[1] );
+
+    if( !brd )
+        return RTREE_BENCH_RET_CODES::LOAD_FAILED;
+
+    int clearance = argc > 2 ? std::max( 0, atoi( argv[2] ) ) : 200000;
+    int repeats = argc > 3 ? std::max( 1, atoi( argv[3] ) ) : 10;
+
+    std::vector<INDEXED_BOX> layers[PCB_LAYER_ID_COUNT];
+
+    for( TRACK* track : brd->Tracks() )
+        collectBoxes( track, layers );
+
+    for( FOOTPRINT* footprint : brd->Footprints() )
+    {
+        for( PAD* pad : footprint->Pads() )
+            collectBoxes( pad, layers );
+
+        for( BOARD_ITEM* item : footprint->GraphicalItems() )
+            collectBoxes( item, layers );
+    }
+
+    for( BOARD_ITEM* item : brd->Drawings() )
+        collectBoxes( item, layers );
+
+    for( ZONE* zone : brd->Zones() )
+        collectBoxes( zone, layers );
+
+    using DYNAMIC_TREE = RTree<BOARD_ITEM*, int, 2, double>;
+    using PACKED_TREE = PACKED_RTREE<BOARD_ITEM*>;
+
+    double buildDynamic = 0, buildPacked = 0, queryDynamic = 0, queryPacked = 0;
+    long   hitsDynamic = 0, hitsPacked = 0, queries = 0, boxes = 0;
+
+    for( int layer = 0; layer < PCB_LAYER_ID_COUNT; layer++ )
+    {
+        const std::vector<INDEXED_BOX>& entries = layers[layer];
+
+        if( entries.empty() )
+            continue;
+
+        DYNAMIC_TREE dynamicTree;
+        PACKED_TREE  packedTree;
+
+        {
+            PROF_COUNTER timer;
+
+            for( const INDEXED_BOX& entry : entries )
+                dynamicTree.Insert( entry.min, entry.max, entry.item );
+
+            buildDynamic += timer.SinceStart<BENCH_DURATION>().count();
+        }
+
+        {
+            PROF_COUNTER timer;
+
+            for( const INDEXED_BOX& entry : entries )
+                packedTree.Insert( entry.min, entry.max, entry.item );
+
+            packedTree.Build();
+            buildPacked += timer.SinceStart<BENCH_DURATION>().count();
+        }
+
+        auto countDynamic =
+                [&]( BOARD_ITEM* )
+                {
+                    hitsDynamic++;
+                    return true;
+                };
+
+        auto countPacked =
+                [&]( BOARD_ITEM* )
+                {
+                    hitsPacked++;
+                    return true;
+                };
+
+        for( int r = 0; r < repeats; r++ )
+        {
+            PROF_COUNTER timer;
+
+            for( const INDEXED_BOX& entry : entries )
+            {
+                const int qmin[2] = { entry.min[0] - clearance, entry.min[1] - clearance };
+                const int qmax[2] = { entry.max[0] + clearance, entry.max[1] + clearance };
+
+                dynamicTree.Search( qmin, qmax, countDynamic );
+            }
+
+            queryDynamic += timer.SinceStart<BENCH_DURATION>().count();
+        }
+
+        for( int r = 0; r < repeats; r++ )
+        {
+            PROF_COUNTER timer;
+
+            for( const INDEXED_BOX& entry : entries )
+            {
+                const int qmin[2] = { entry.min[0] - clearance, entry.min[1] - clearance };
+                const int qmax[2] = { entry.max[0] + clearance, entry.max[1] + clearance };
+
+                packedTree.Search( qmin, qmax, countPacked );
+            }
+
+            queryPacked += timer.SinceStart<BENCH_DURATION>().count();
+        }
+
+        boxes += entries.size();
+        queries += repeats * entries.size();
+    }
+
+    std::cout << "Board: " << argv[1] << ", " << boxes << " indexed boxes, " << queries
+              << " queries, clearance " << clearance << " nm" << std::endl;
+
+    auto report =
+            [&]( const char* aName, double aBuild, double aQuery, long aHits )
+            {
+                std::cout << aName << ": build " << aBuild / 1000.0 << " ms, query "
+                          << aQuery / 1000.0 << " ms (" << queries / aQuery
+                          << " queries/us), " << aHits << " hits" << std::endl;
+            };
+
+    report( "RTree", buildDynamic, queryDynamic, hitsDynamic );
+    report( "PACKED_RTREE", buildPacked, queryPacked, hitsPacked );
+
+    if( hitsDynamic != hitsPacked )
+    {
+        std::cerr << "Query results differ between the trees." << std::endl;
+        return RTREE_BENCH_RET_CODES::RESULTS_DIFFER;
+    }
+
+    return KI_TEST::RET_CODES::OK;
+}
+
+
+static bool registered = UTILITY_REGISTRY::Register( {
+        "rtree_bench",
+        "Compare dynamic and packed R-tree query throughput on a PCB",
+        rtree_bench_main,
+} );
@@ -73,6 +73,7 @@ using namespace KIGFX;
 
 void PCB_TEST_FRAME_BASE::SetBoard( std::shared_ptr<BOARD> b )
 {
+    m_galPanel->CancelZoneTriangulation();
     m_board = b;
 
     m_board->GetConnectivity()->Build( m_board.get() );
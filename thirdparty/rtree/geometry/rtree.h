@@ -211,6 +211,12 @@ public:
     /// Remove all entries from tree
     void    RemoveAll();
 
+    /// Load many entries at once using Sort-Tile-Recursive packing.  This is much faster than
+    /// inserting the entries one by one and gives a tree with less node overlap.  If the tree
+    /// already holds entries, the new ones are inserted one at a time instead.
+    /// \param a_entries Bounding rects and data of the entries; the vector is reordered.
+    void    BulkLoad( std::vector<std::pair<Rect, DATATYPE>>& a_entries );
+
     /// Count the data elements in this container.  This is slow as no internal counter is maintained.
     int     Count() const;
 
@@ -549,6 +555,8 @@ protected:
     void            InitParVars( PartitionVars* a_parVars, int a_maxRects, int a_minFill ) const;
     void            PickSeeds( PartitionVars* a_parVars ) const;
     void            Classify( int a_index, int a_group, PartitionVars* a_parVars ) const;
+    void            PackBranches( std::vector<Branch>& a_branches, int a_level,
+                                  std::vector<Node*>& a_nodes ) const;
     bool            RemoveRect( const Rect* a_rect, const DATATYPE& a_id, Node** a_root ) const;
     bool            RemoveRectRec( const Rect*      a_rect,
                                    const DATATYPE&  a_id,
@@ -1114,6 +1122,117 @@ bool RTREE_QUAL::SaveRec( const Node* a_node, RTFileStream& a_stream ) const
 }
 
 
+RTREE_TEMPLATE
+void RTREE_QUAL::BulkLoad( std::vector<std::pair<Rect, DATATYPE>>& a_entries )
+{
+    if( a_entries.empty() )
+        return;
+
+    if( m_root->m_count > 0 )
+    {
+        for( const std::pair<Rect, DATATYPE>& entry : a_entries )
+            InsertRect( &entry.first, entry.second, &m_root, 0 );
+
+        return;
+    }
+
+    std::vector<Branch> branches( a_entries.size() );
+
+    for( size_t i = 0; i < a_entries.size(); ++i )
+    {
+        branches[i].m_rect = a_entries[i].first;
+        branches[i].m_data = a_entries[i].second;
+    }
+
+    std::vector<Node*> nodes;
+    int                level = 0;
+
+    // Pack each level into nodes, then pack the covers of those nodes into the next level up
+    // until a single node (the root) remains
+    while( true )
+    {
+        nodes.clear();
+        PackBranches( branches, level, nodes );
+
+        if( nodes.size() == 1 )
+            break;
+
+        branches.resize( nodes.size() );
+
+        for( size_t i = 0; i < nodes.size(); ++i )
+        {
+            branches[i].m_rect = NodeCover( nodes[i] );
+            branches[i].m_child = nodes[i];
+        }
+
+        ++level;
+    }
+
+    FreeNode( m_root );
+    m_root = nodes[0];
+}
+
+
+// Sort-Tile-Recursive packing of one tree level.  Branches are sorted along the first axis,
+// cut into vertical slices of about sqrt(node count) nodes each, and sorted along the second
+// axis within each slice.  The resulting sequence is then cut into nodes of equal size (at
+// least MINNODES branches each, unless there is a single node).
+RTREE_TEMPLATE
+void RTREE_QUAL::PackBranches( std::vector<Branch>& a_branches, int a_level,
+                               std::vector<Node*>& a_nodes ) const
+{
+    auto center =
+            []( const Branch& aBranch, int aAxis ) -> ELEMTYPEREAL
+            {
+                return ( (ELEMTYPEREAL) aBranch.m_rect.m_min[aAxis]
+                         + (ELEMTYPEREAL) aBranch.m_rect.m_max[aAxis] ) / 2;
+            };
+
+    const size_t count = a_branches.size();
+    const size_t nodeCount = ( count + MAXNODES - 1 ) / MAXNODES;
+
+    std::sort( a_branches.begin(), a_branches.end(),
+               [&]( const Branch& aA, const Branch& aB )
+               {
+                   return center( aA, 0 ) < center( aB, 0 );
+               } );
+
+    if( NUMDIMS > 1 )
+    {
+        const size_t sliceCount = (size_t) std::ceil( std::sqrt( (double) nodeCount ) );
+        const size_t sliceSize = ( ( nodeCount + sliceCount - 1 ) / sliceCount ) * MAXNODES;
+
+        for( size_t start = 0; start < count; start += sliceSize )
+        {
+            auto first = a_branches.begin() + start;
+            auto last = a_branches.begin() + std::min( count, start + sliceSize );
+
+            std::sort( first, last,
+                       [&]( const Branch& aA, const Branch& aB )
+                       {
+                           return center( aA, 1 ) < center( aB, 1 );
+                       } );
+        }
+    }
+
+    size_t next = 0;
+
+    for( size_t i = 0; i < nodeCount; ++i )
+    {
+        // Spread the branches evenly so that no node is left underfilled
+        size_t end = ( count * ( i + 1 ) ) / nodeCount;
+        Node*  node = AllocNode();
+
+        node->m_level = a_level;
+
+        for( ; next < end; ++next )
+            node->m_branch[node->m_count++] = a_branches[next];
+
+        a_nodes.push_back( node );
+    }
+}
+
+
 RTREE_TEMPLATE
 void RTREE_QUAL::RemoveAll()
 {